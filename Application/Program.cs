@@ -1,11 +1,14 @@
 ﻿// See https://aka.ms/new-console-template for more information
 using System.Diagnostics;
+using PE32Proxy;
 
-using var pe32 = new PE32Proxy.PE32Proxy();
+// A standby bridge takes over if the first one dies during the robustness run
+using var pe32 = new PE32Proxy.PE32Proxy(new PE32ProxyOptions { Standby = true });
 
 Console.WriteLine("=== UltraFastIPC Performance Test ===");
 Console.WriteLine("1. Run Performance Testing");
 Console.WriteLine("2. Run Robustness Testing");
+Console.WriteLine("3. Run Protocol Checks");
 Console.WriteLine("Other key to exit");
 
 var input = Console.ReadKey();
@@ -20,12 +23,16 @@ if (input.Key == ConsoleKey.D1)
     var stopwatch = Stopwatch.StartNew();
     var stopwatch2 = new Stopwatch();
     var times = new List<double>();
+    var dllTime = TimeSpan.Zero;
+    var overheadTime = TimeSpan.Zero;
     for (int i = 0; i < testCount; i++)
     {
         stopwatch2.Restart();
         var result = pe32.it_api();
         stopwatch2.Stop();
         times.Add((stopwatch2.ElapsedTicks * 1000000.0) / Stopwatch.Frequency);
+        dllTime += pe32.LastCallTimings.Dll;
+        overheadTime += pe32.LastCallTimings.IpcOverhead;
         //Console.WriteLine(result.ToString("X"));
     }
 
@@ -33,13 +40,14 @@ if (input.Key == ConsoleKey.D1)
 
     double averageTime = (stopwatch.ElapsedTicks * 1000000.0) / (Stopwatch.Frequency * testCount);
 
-    Console.WriteLine(string.Join(" us\n ", times));
     Console.WriteLine($"Average time: {times.Average():F1} us");
 
     Console.WriteLine($"Performance test completed:");
     Console.WriteLine($"Total number of requests: {testCount}");
     Console.WriteLine($"Total time: {stopwatch.ElapsedMilliseconds} ms");
     Console.WriteLine($"Average latency: {averageTime:F1} us");
+    Console.WriteLine($"Average DLL time: {dllTime.TotalMicroseconds / testCount:F1} us");
+    Console.WriteLine($"Average IPC overhead: {overheadTime.TotalMicroseconds / testCount:F1} us");
     Console.WriteLine($"QPS: {testCount * 1000.0 / stopwatch.ElapsedMilliseconds:F0}");
 }
 else if (input.Key == ConsoleKey.D2)
@@ -58,7 +66,16 @@ else if (input.Key == ConsoleKey.D2)
     while (GetRunTime(startTime) < TimeSpan.FromHours(time))
     {
         cycleStopwatch.Restart();
-        var result = pe32.it_api();
+        int result;
+        try
+        {
+            result = pe32.it_api();
+        }
+        catch (PE32BridgeLostException ex) when (ex.FailedOver)
+        {
+            Console.WriteLine($"Cycle {testCount} || {ex.Message}");
+            continue;
+        }
         cycleStopwatch.Stop();
         testCount++;
         Console.WriteLine(
@@ -67,10 +84,67 @@ else if (input.Key == ConsoleKey.D2)
     }
 }
 
+else if (input.Key == ConsoleKey.D3)
+{
+    Console.WriteLine();
+    Console.WriteLine("Running protocol checks...");
+
+    // Text results longer than the 4 KB response must be refused, never copied past the slot
+    int failures = 0;
+    failures += Check("bulk read over text", pe32.SendRecordedText(0, "ipc_echo_bulk 1 65536") == "error");
+    failures += Check("large byte read over text", pe32.SendRecordedText(0, "ipc_echo_bytes 1 4000") == "error");
+    failures += Check("small byte read over text", pe32.SendRecordedText(0, "ipc_echo_bytes 1 4") == "4 00010203");
+
+    // An overflow would have hit the slots after the one it answered in
+    bool ringIntact = true;
+    for (int i = 0; i < 64; i++)
+    {
+        ringIntact &= pe32.ipc_echo(1, i) == i;
+    }
+    failures += Check("ring intact after the text reads", ringIntact);
+
+    // A write dropped for a later one of the same target did not run when the batch stops before that one
+    if (args.Length > 0)
+    {
+        using var mock = new PE32Proxy.PE32Proxy(
+            new PE32ProxyOptions
+            {
+                ReduceBatches = true,
+                BridgePath = args[0],
+                BridgeArguments = "--mock-fail=pe32_set_vil",
+            }
+        );
+        string message = "";
+        try
+        {
+            mock.BeginBatch().pe32_set_vih(1, 1, 1.0).pe32_set_vil(1, 1, 0.5).pe32_set_vih(1, 1, 2.0).Execute();
+        }
+        catch (InvalidOperationException ex)
+        {
+            message = ex.Message;
+        }
+        failures += Check(
+            "dropped write before a failing write reports NotRun",
+            message.EndsWith("failed: Exception, command 0 (pe32_set_vih) did not run")
+        );
+    }
+    else
+    {
+        Console.WriteLine("SKIP failing write in a reduced batch, pass the Mock UltraFastIPC.exe as argument");
+    }
+    Console.WriteLine(failures == 0 ? "All protocol checks passed" : $"{failures} protocol checks failed");
+}
+
 Console.WriteLine("=== End of test ===");
 Console.WriteLine("Press any key to exit...");
 Console.ReadKey();
 
+static int Check(string name, bool passed)
+{
+    Console.WriteLine($"{(passed ? "PASS" : "FAIL")} {name}");
+    return passed ? 0 : 1;
+}
+
 static TimeSpan GetRunTime(DateTime startTime)
 {
     return DateTime.Now - startTime;
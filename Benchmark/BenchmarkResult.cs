@@ -0,0 +1,99 @@
+﻿using System.Diagnostics;
+using System.Globalization;
+using System.Text;
+using System.Text.Json;
+
+namespace Benchmark;
+
+// Latency percentiles of one benchmark step, in microseconds per sample.
+// OpsPerSecond counts the operations of every sample over the wall time of the run.
+internal sealed record BenchmarkResult(
+    string Scenario,
+    string Parameter,
+    int Samples,
+    int OpsPerSample,
+    double MeanUs,
+    double P50Us,
+    double P99Us,
+    double P999Us,
+    double MaxUs,
+    double OpsPerSecond
+)
+{
+    public static BenchmarkResult From(
+        string scenario,
+        string parameter,
+        int opsPerSample,
+        long[] samples,
+        TimeSpan elapsed
+    )
+    {
+        double[] us = samples.Select(ticks => ticks * 1e6 / Stopwatch.Frequency).ToArray();
+        Array.Sort(us);
+
+        return new BenchmarkResult(
+            scenario,
+            parameter,
+            us.Length,
+            opsPerSample,
+            us.Average(),
+            Percentile(us, 0.5),
+            Percentile(us, 0.99),
+            Percentile(us, 0.999),
+            us[^1],
+            (double)us.Length * opsPerSample / elapsed.TotalSeconds
+        );
+    }
+
+    // Nearest rank on sorted samples
+    private static double Percentile(double[] sorted, double fraction)
+    {
+        int rank = (int)Math.Ceiling(fraction * sorted.Length);
+        return sorted[Math.Clamp(rank - 1, 0, sorted.Length - 1)];
+    }
+
+    public static void Write(IReadOnlyList<BenchmarkResult> results, string format, string? output)
+    {
+        string text = format == "json" ? ToJson(results) : ToCsv(results);
+        if (output == null)
+            Console.Write(text);
+        else
+            File.WriteAllText(output, text);
+    }
+
+    private static string ToCsv(IReadOnlyList<BenchmarkResult> results)
+    {
+        var csv = new StringBuilder(
+            "scenario,parameter,samples,ops_per_sample,mean_us,p50_us,p99_us,p999_us,max_us,ops_per_second\n"
+        );
+        foreach (var r in results)
+        {
+            csv.AppendLine(
+                string.Join(
+                    ',',
+                    r.Scenario,
+                    r.Parameter,
+                    r.Samples.ToString(CultureInfo.InvariantCulture),
+                    r.OpsPerSample.ToString(CultureInfo.InvariantCulture),
+                    r.MeanUs.ToString("F3", CultureInfo.InvariantCulture),
+                    r.P50Us.ToString("F3", CultureInfo.InvariantCulture),
+                    r.P99Us.ToString("F3", CultureInfo.InvariantCulture),
+                    r.P999Us.ToString("F3", CultureInfo.InvariantCulture),
+                    r.MaxUs.ToString("F3", CultureInfo.InvariantCulture),
+                    r.OpsPerSecond.ToString("F0", CultureInfo.InvariantCulture)
+                )
+            );
+        }
+        return csv.ToString();
+    }
+
+    private static string ToJson(IReadOnlyList<BenchmarkResult> results) =>
+        JsonSerializer.Serialize(
+            results,
+            new JsonSerializerOptions
+            {
+                PropertyNamingPolicy = JsonNamingPolicy.SnakeCaseLower,
+                WriteIndented = true,
+            }
+        );
+}
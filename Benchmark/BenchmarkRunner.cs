@@ -0,0 +1,146 @@
+﻿using System.Diagnostics;
+using PE32Proxy;
+
+namespace Benchmark;
+
+// Command line of the benchmark:
+// --iterations=N --warmup=N --channels=K --wait=spin|hybrid --format=csv|json --output=file --scenarios=a,b
+// --bridge=path --bridge-args="--mock-latency=5" --affinity=auto
+internal sealed class BenchmarkSettings
+{
+    public int Iterations { get; private set; } = 100000;
+
+    public int Warmup { get; private set; } = 10000;
+
+    public int Channels { get; private set; } = 4;
+
+    public WaitMode WaitMode { get; private set; } = WaitMode.Hybrid;
+
+    public string Format { get; private set; } = "csv";
+
+    public string? Output { get; private set; }
+
+    public string? BridgePath { get; private set; }
+
+    public string? BridgeArguments { get; private set; }
+
+    // Pins the bridge channels and every measuring thread to cache sharing CPU pairs
+    public bool AutoAffinity { get; private set; }
+
+    private HashSet<string>? scenarios;
+
+    public bool Runs(string scenario) => scenarios == null || scenarios.Contains(scenario);
+
+    public static BenchmarkSettings Parse(string[] args)
+    {
+        var settings = new BenchmarkSettings();
+        foreach (string arg in args)
+        {
+            string[] option = arg.Split('=', 2);
+            string value = option.Length > 1 ? option[1] : "";
+            switch (option[0])
+            {
+                case "--iterations":
+                    settings.Iterations = int.Parse(value);
+                    break;
+                case "--warmup":
+                    settings.Warmup = int.Parse(value);
+                    break;
+                case "--channels":
+                    settings.Channels = Math.Max(1, int.Parse(value));
+                    break;
+                case "--wait":
+                    settings.WaitMode = value == "spin" ? WaitMode.BusySpin : WaitMode.Hybrid;
+                    break;
+                case "--format":
+                    settings.Format = value;
+                    break;
+                case "--output":
+                    settings.Output = value;
+                    break;
+                case "--bridge":
+                    settings.BridgePath = value;
+                    break;
+                case "--bridge-args":
+                    settings.BridgeArguments = value;
+                    break;
+                case "--affinity":
+                    settings.AutoAffinity = value == "auto";
+                    break;
+                case "--scenarios":
+                    settings.scenarios = [.. value.Split(',')];
+                    break;
+                default:
+                    throw new ArgumentException($"Unknown option {arg}");
+            }
+        }
+        return settings;
+    }
+}
+
+// Runs a benchmark step Warmup times untimed, then Iterations times timed one by one
+internal sealed class BenchmarkRunner(BenchmarkSettings settings)
+{
+    public BenchmarkResult Measure(string scenario, string parameter, int opsPerSample, Action<int> step)
+    {
+        for (int i = 0; i < settings.Warmup; i++)
+        {
+            step(i);
+        }
+
+        long[] samples = new long[settings.Iterations];
+        long start = Stopwatch.GetTimestamp();
+        for (int i = 0; i < samples.Length; i++)
+        {
+            long before = Stopwatch.GetTimestamp();
+            step(i);
+            samples[i] = Stopwatch.GetTimestamp() - before;
+        }
+        var elapsed = Stopwatch.GetElapsedTime(start);
+
+        return BenchmarkResult.From(scenario, parameter, opsPerSample, samples, elapsed);
+    }
+
+    // The same with several threads at once, each runs the full iteration count.
+    // prepare runs first on every thread, e.g. to pin it.
+    public BenchmarkResult MeasureConcurrent(
+        string scenario,
+        string parameter,
+        int threads,
+        Action<int, int> step,
+        Action<int>? prepare = null
+    )
+    {
+        var samples = new long[threads][];
+        using var ready = new Barrier(threads + 1);
+        var workers = Enumerable
+            .Range(0, threads)
+            .Select(thread => new Thread(() =>
+            {
+                prepare?.Invoke(thread);
+                for (int i = 0; i < settings.Warmup; i++)
+                {
+                    step(thread, i);
+                }
+
+                long[] own = new long[settings.Iterations];
+                ready.SignalAndWait();
+                for (int i = 0; i < own.Length; i++)
+                {
+                    long before = Stopwatch.GetTimestamp();
+                    step(thread, i);
+                    own[i] = Stopwatch.GetTimestamp() - before;
+                }
+                samples[thread] = own;
+            }))
+            .ToList();
+
+        workers.ForEach(worker => worker.Start());
+        ready.SignalAndWait();
+        long start = Stopwatch.GetTimestamp();
+        workers.ForEach(worker => worker.Join());
+        var elapsed = Stopwatch.GetElapsedTime(start);
+
+        return BenchmarkResult.From(scenario, parameter, 1, [.. samples.SelectMany(s => s)], elapsed);
+    }
+}
@@ -0,0 +1,165 @@
+﻿using Benchmark;
+using PE32Proxy;
+
+// Benchmarks the IPC path with the loopback opcodes, which never enter the vendor DLL.
+// Run against a bridge built with the mock PE32 backend when there is no tester board.
+var settings = BenchmarkSettings.Parse(args);
+var results = new List<BenchmarkResult>();
+
+using (
+    var pe32 = new PE32Proxy.PE32Proxy(
+        new PE32ProxyOptions
+        {
+            WaitMode = settings.WaitMode,
+            ChannelCount = settings.Channels,
+            BridgePath = settings.BridgePath,
+            BridgeArguments = settings.BridgeArguments,
+            AutoAffinity = settings.AutoAffinity,
+        }
+    )
+)
+{
+    var runner = new BenchmarkRunner(settings);
+    if (settings.AutoAffinity)
+        pe32.PinCurrentThread();
+
+    if (settings.Runs("roundtrip"))
+    {
+        results.Add(runner.Measure("roundtrip", "ipc_echo", 1, i => pe32.ipc_echo(1, i)));
+    }
+
+    if (settings.Runs("payload"))
+    {
+        byte[] destination = new byte[4096];
+        foreach (int size in new[] { 0, 64, 256, 1024, 4000 })
+        {
+            results.Add(
+                runner.Measure("payload", $"bytes_{size}", 1, _ => pe32.ipc_echo_bytes(1, size, destination))
+            );
+        }
+        foreach (int size in new[] { 4096, 16384, 65536, 262144, 1048576 })
+        {
+            results.Add(runner.Measure("payload", $"bulk_{size}", 1, _ => pe32.ipc_echo_bulk(1, size)));
+        }
+    }
+
+    if (settings.Runs("batch"))
+    {
+        foreach (int count in new[] { 8, 32, 128 })
+        {
+            results.Add(
+                runner.Measure(
+                    "batch",
+                    $"ipc_echo_x{count}",
+                    count,
+                    i =>
+                    {
+                        var batch = pe32.BeginBatch();
+                        for (int j = 0; j < count; j++)
+                        {
+                            batch.ipc_echo(1, j);
+                        }
+                        batch.Execute();
+                    }
+                )
+            );
+        }
+    }
+
+    if (settings.Runs("pipelined"))
+    {
+        // Up to 16 requests in flight, the window is drained by Flush()
+        pe32.FireAndForget = true;
+        foreach (int window in new[] { 4, 16, 64 })
+        {
+            results.Add(
+                runner.Measure(
+                    "pipelined",
+                    $"ipc_nop_window_{window}",
+                    window,
+                    _ =>
+                    {
+                        for (int j = 0; j < window; j++)
+                        {
+                            pe32.ipc_nop(1);
+                        }
+                        pe32.Flush();
+                    }
+                )
+            );
+        }
+        pe32.FireAndForget = false;
+    }
+
+    if (settings.Runs("async"))
+    {
+        // Awaitable calls in flight at once, one per board, all completed by the proxy's poller thread
+        foreach (int flows in new[] { 1, 4, 16 })
+        {
+            var calls = new Task<int>[flows];
+            results.Add(
+                runner.Measure(
+                    "async",
+                    $"ipc_echo_flows_{flows}",
+                    flows,
+                    i =>
+                    {
+                        for (int j = 0; j < flows; j++)
+                        {
+                            calls[j] = pe32.ipc_echo_async(j + 1, i).AsTask();
+                        }
+                        Task.WaitAll(calls);
+                    }
+                )
+            );
+        }
+    }
+
+    if (settings.Runs("fire_and_forget"))
+    {
+        // Time to post one request, the ring back-pressures once it is full
+        pe32.FireAndForget = true;
+        results.Add(runner.Measure("fire_and_forget", "ipc_nop", 1, _ => pe32.ipc_nop(1)));
+        pe32.Flush();
+        pe32.FireAndForget = false;
+    }
+
+    if (settings.Runs("channels"))
+    {
+        // One thread per channel, board t + 1 is routed to channel t
+        for (int threads = 1; threads <= settings.Channels; threads++)
+        {
+            results.Add(
+                runner.MeasureConcurrent(
+                    "channels",
+                    $"threads_{threads}",
+                    threads,
+                    (thread, i) => pe32.ipc_echo(thread + 1, i),
+                    thread =>
+                    {
+                        if (settings.AutoAffinity)
+                            pe32.PinCurrentThread(thread);
+                    }
+                )
+            );
+        }
+    }
+
+    if (settings.Runs("shared_channel"))
+    {
+        // Synchronous calls from several threads into channel 0, each claims its own ring slot
+        foreach (int threads in new[] { 1, 2, 4, 8 })
+        {
+            results.Add(
+                runner.MeasureConcurrent(
+                    "shared_channel",
+                    $"threads_{threads}",
+                    threads,
+                    (_, i) => pe32.ipc_echo(1, i)
+                )
+            );
+        }
+    }
+}
+
+BenchmarkResult.Write(results, settings.Format, settings.Output);
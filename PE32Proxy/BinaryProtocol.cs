@@ -0,0 +1,273 @@
+﻿using System.Buffers.Binary;
+using System.Text;
+
+namespace PE32Proxy;
+
+// Request format in use - must match ProtocolVersion in UltraFastIPC/BinaryProtocol.h
+internal enum ProtocolVersion : uint
+{
+    Text = 0,
+    Binary = 1,
+}
+
+// Bits of the request header flags byte - must match BinaryRequestFlags in UltraFastIPC/BinaryProtocol.h
+[Flags]
+internal enum BinaryRequestFlags : byte
+{
+    None = 0,
+    NoReply = 0x01,
+}
+
+// Status word at the start of every binary response
+public enum BinaryStatus : int
+{
+    Ok = 0,
+    UnknownOpcode = -1,
+    BadArguments = -2,
+    Exception = -3,
+    ResponseTooLarge = -4,
+
+    // A PE32Batch.Until() condition that did not hold in time
+    Timeout = -5,
+
+    // A batched command the bridge's --reduce-batches had moved behind the one that failed
+    NotRun = -6,
+}
+
+// Condition of a poll - must match PollCompare in UltraFastIPC/BinaryProtocol.h
+internal enum PollCompare
+{
+    Equal = 0,
+    NotEqual = 1,
+}
+
+// Builds a binary request: 4 byte header (opcode, arg count, flags) + packed little-endian args
+internal sealed class BinaryRequestWriter
+{
+    private const int HeaderSize = 4;
+
+    // Must match BATCH_OPCODE in UltraFastIPC/BinaryProtocol.h
+    internal const ushort BatchOpcode = 0xFFFF;
+
+    // Must match POLL_OPCODE in UltraFastIPC/BinaryProtocol.h
+    internal const ushort PollOpcode = 0xFFFE;
+
+    // Reused for every request, pinned so the GC never moves it
+    private readonly byte[] buffer = GC.AllocateUninitializedArray<byte>(
+        UltraFastIPCClient.BufferSize,
+        pinned: true
+    );
+
+    internal PE32Opcode Opcode { get; private set; }
+
+    // Index of the channel the request goes to, fixed for the writer a channel's client owns
+    internal int Channel { get; set; }
+
+    internal int Length { get; private set; }
+
+    // Where the sub-request appended last starts, see RemoveLast()
+    private int lastAppended;
+
+    // The request built so far, copied into the ring slot by the client
+    internal ReadOnlySpan<byte> Written => buffer.AsSpan(0, Length);
+
+    // Number of sub-requests appended since BeginBatch()
+    internal int BatchCount => BinaryPrimitives.ReadUInt16LittleEndian(buffer.AsSpan(HeaderSize));
+
+    internal BinaryRequestWriter Begin(PE32Opcode opcode)
+    {
+        Opcode = opcode;
+        BinaryPrimitives.WriteUInt16LittleEndian(buffer, (ushort)opcode);
+        buffer[2] = 0; // arg_count
+        buffer[3] = 0; // flags
+        Length = HeaderSize;
+        return this;
+    }
+
+    // Starts a batch request - uint16 count followed by the appended sub-requests
+    internal BinaryRequestWriter BeginBatch()
+    {
+        Begin((PE32Opcode)BatchOpcode);
+        BinaryPrimitives.WriteUInt16LittleEndian(buffer.AsSpan(HeaderSize), 0);
+        Length += sizeof(ushort);
+        return this;
+    }
+
+    // Appends a complete request to a batch as uint16 size + request, false if it does not fit
+    internal bool TryAppend(BinaryRequestWriter request)
+    {
+        if (Length + sizeof(ushort) + request.Length > buffer.Length)
+            return false;
+
+        lastAppended = Length;
+        Span<byte> target = buffer.AsSpan(Length);
+        BinaryPrimitives.WriteUInt16LittleEndian(target, (ushort)request.Length);
+        request.buffer.AsSpan(0, request.Length).CopyTo(target.Slice(sizeof(ushort)));
+        Length += sizeof(ushort) + request.Length;
+        BinaryPrimitives.WriteUInt16LittleEndian(buffer.AsSpan(HeaderSize), (ushort)(BatchCount + 1));
+        return true;
+    }
+
+    // Drops the sub-request appended last, valid once after TryAppend()
+    internal void RemoveLast()
+    {
+        Length = lastAppended;
+        BinaryPrimitives.WriteUInt16LittleEndian(buffer.AsSpan(HeaderSize), (ushort)(BatchCount - 1));
+    }
+
+    // Starts a poll sub-request - the condition as five int32 arguments, then the request to repeat
+    internal BinaryRequestWriter BeginPoll(
+        PollCompare compare,
+        int mask,
+        int value,
+        int intervalMicroseconds,
+        int timeoutMicroseconds,
+        BinaryRequestWriter polled
+    )
+    {
+        Begin((PE32Opcode)PollOpcode)
+            .WriteInt32((int)compare)
+            .WriteInt32(mask)
+            .WriteInt32(value)
+            .WriteInt32(intervalMicroseconds)
+            .WriteInt32(timeoutMicroseconds);
+        if (Length + polled.Length > buffer.Length)
+            throw new ArgumentException("Request data is too large");
+
+        polled.Written.CopyTo(buffer.AsSpan(Length));
+        Length += polled.Length;
+        return this;
+    }
+
+    // Marks the request fire-and-forget, the server runs it without writing a response
+    internal BinaryRequestWriter NoReply()
+    {
+        buffer[3] |= (byte)BinaryRequestFlags.NoReply;
+        return this;
+    }
+
+    internal BinaryRequestWriter WriteInt32(int value)
+    {
+        BinaryPrimitives.WriteInt32LittleEndian(Reserve(sizeof(int)), value);
+        return this;
+    }
+
+    internal BinaryRequestWriter WriteDouble(double value)
+    {
+        BinaryPrimitives.WriteDoubleLittleEndian(Reserve(sizeof(double)), value);
+        return this;
+    }
+
+    // uint32 length + bytes + NUL, so the server can hand the string to the DLL in place
+    internal BinaryRequestWriter WriteString(string value)
+    {
+        int byteCount = Encoding.UTF8.GetByteCount(value);
+        Span<byte> target = Reserve(sizeof(uint) + byteCount + 1);
+        BinaryPrimitives.WriteUInt32LittleEndian(target, (uint)byteCount);
+        Encoding.UTF8.GetBytes(value, target.Slice(sizeof(uint)));
+        target[^1] = 0;
+        return this;
+    }
+
+    // uint32 offset + size of a payload in the slot's bulk region. The client copies
+    // it to the start of the region when posting, see UltraFastIPCClient.SendRequestBinary().
+    internal BinaryRequestWriter WriteBulk(int size)
+    {
+        Span<byte> target = Reserve(2 * sizeof(uint));
+        BinaryPrimitives.WriteUInt32LittleEndian(target, 0);
+        BinaryPrimitives.WriteUInt32LittleEndian(target.Slice(sizeof(uint)), (uint)size);
+        return this;
+    }
+
+    private Span<byte> Reserve(int size)
+    {
+        if (Length + size > buffer.Length)
+            throw new ArgumentException("Request data is too large");
+
+        Span<byte> target = buffer.AsSpan(Length, size);
+        Length += size;
+        buffer[2]++; // arg_count
+        return target;
+    }
+}
+
+// Reads a binary response: int32 status followed by the packed return value.
+// It reads straight from the response buffer of the ring slot, nothing is copied.
+internal sealed unsafe class BinaryResponseReader
+{
+    private byte* data;
+    private int length;
+    private int position;
+
+    // Bulk region of the slot the response came from
+    private byte* bulk;
+    private int bulkLength;
+
+    internal BinaryStatus Status { get; private set; }
+
+    // Bytes not read yet
+    internal int Remaining => length - position;
+
+    internal BinaryResponseReader Reset(
+        byte* responseData,
+        int responseLength,
+        byte* bulkData = null,
+        int bulkDataLength = 0
+    )
+    {
+        data = responseData;
+        length = responseLength;
+        bulk = bulkData;
+        bulkLength = bulkDataLength;
+        position = 0;
+        Status = length >= sizeof(int) ? (BinaryStatus)ReadInt32() : BinaryStatus.BadArguments;
+        return this;
+    }
+
+    internal ushort ReadUInt16() => BinaryPrimitives.ReadUInt16LittleEndian(Take(sizeof(ushort)));
+
+    internal int ReadInt32() => BinaryPrimitives.ReadInt32LittleEndian(Take(sizeof(int)));
+
+    internal uint ReadUInt32() => BinaryPrimitives.ReadUInt32LittleEndian(Take(sizeof(uint)));
+
+    internal double ReadDouble() => BinaryPrimitives.ReadDoubleLittleEndian(Take(sizeof(double)));
+
+    internal string ReadString()
+    {
+        int byteCount = (int)ReadUInt32();
+        return Encoding.UTF8.GetString(Take(byteCount));
+    }
+
+    internal ReadOnlySpan<byte> ReadBytes(int size) => Take(size);
+
+    // Copies a uint32 length + bytes payload into destination, returns the number of bytes copied
+    internal int ReadBytes(Span<byte> destination)
+    {
+        ReadOnlySpan<byte> source = Take((int)ReadUInt32());
+        int count = Math.Min(source.Length, destination.Length);
+        source.Slice(0, count).CopyTo(destination);
+        return count;
+    }
+
+    // A uint32 offset + size payload in the bulk region, returned in place. It stays
+    // valid as long as the response, until SlotCount newer requests have been posted.
+    internal ReadOnlySpan<byte> ReadBulk()
+    {
+        uint offset = ReadUInt32();
+        uint size = ReadUInt32();
+        if ((ulong)offset + size > (ulong)bulkLength)
+            throw new InvalidOperationException("Bulk payload is outside the bulk region");
+
+        return new ReadOnlySpan<byte>(bulk + offset, (int)size);
+    }
+
+    private ReadOnlySpan<byte> Take(int size)
+    {
+        if (position + size > length)
+            throw new InvalidOperationException("Response data is too short");
+
+        var source = new ReadOnlySpan<byte>(data + position, size);
+        position += size;
+        return source;
+    }
+}
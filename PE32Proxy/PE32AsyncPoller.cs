@@ -0,0 +1,251 @@
+﻿using System.Collections.Concurrent;
+using System.Diagnostics;
+using System.Threading.Tasks.Sources;
+
+namespace PE32Proxy;
+
+// A request posted by one of the *_async stubs, completed by the poller once its response is in the ring
+internal abstract class PE32PendingCall
+{
+    public UltraFastIPCClient Channel { get; protected set; } = null!;
+
+    public uint Sequence { get; protected set; }
+
+    public PE32Opcode Opcode { get; protected set; }
+
+    // Stopwatch timestamp after which the call fails with a TimeoutException
+    public long Deadline { get; protected set; }
+
+    // Runs on the poller thread while the response is still in its slot
+    public abstract void Complete(BinaryResponseReader response);
+
+    public abstract void Fail(Exception error);
+}
+
+// Pooled per result type, so an awaited call allocates nothing once the pool is warm.
+// Continuations run on the thread pool, never on the poller thread.
+internal sealed class PE32AsyncCall<T> : PE32PendingCall, IValueTaskSource<T>, IValueTaskSource
+{
+    private static readonly ConcurrentQueue<PE32AsyncCall<T>> pool = new();
+
+    private ManualResetValueTaskSourceCore<T> core = new() { RunContinuationsAsynchronously = true };
+    private Func<BinaryResponseReader, T> decode = null!;
+
+    public static PE32AsyncCall<T> Rent(
+        PE32Opcode opcode,
+        Func<BinaryResponseReader, T> decode,
+        long deadline
+    )
+    {
+        if (!pool.TryDequeue(out var call))
+            call = new PE32AsyncCall<T>();
+        call.Opcode = opcode;
+        call.decode = decode;
+        call.Deadline = deadline;
+        return call;
+    }
+
+    public void Posted(UltraFastIPCClient channel, uint sequence)
+    {
+        Channel = channel;
+        Sequence = sequence;
+    }
+
+    public short Version => core.Version;
+
+    public override void Complete(BinaryResponseReader response)
+    {
+        if (response.Status != BinaryStatus.Ok)
+        {
+            core.SetException(new InvalidOperationException($"{Opcode} failed: {response.Status}"));
+            return;
+        }
+        try
+        {
+            core.SetResult(decode(response));
+        }
+        catch (Exception ex)
+        {
+            core.SetException(ex);
+        }
+    }
+
+    public override void Fail(Exception error) => core.SetException(error);
+
+    public T GetResult(short token)
+    {
+        try
+        {
+            return core.GetResult(token);
+        }
+        finally
+        {
+            core.Reset();
+            decode = null!;
+            Channel = null!;
+            pool.Enqueue(this);
+        }
+    }
+
+    void IValueTaskSource.GetResult(short token) => GetResult(token);
+
+    public ValueTaskSourceStatus GetStatus(short token) => core.GetStatus(token);
+
+    public void OnCompleted(
+        Action<object?> continuation,
+        object? state,
+        short token,
+        ValueTaskSourceOnCompletedFlags flags
+    ) => core.OnCompleted(continuation, state, token, flags);
+}
+
+// The one thread that waits for the responses of every async call of a PE32Proxy, on all channels.
+// It spins while calls are outstanding and sleeps on an event when there are none.
+internal sealed class PE32AsyncPoller : IDisposable
+{
+    // Same budget as a synchronous call
+    internal static readonly long Timeout = Stopwatch.Frequency;
+
+    // Rounds between bridge process checks, like BridgeCheckInterval of the client
+    private const int BridgeCheckInterval = 4095;
+
+    private readonly ConcurrentQueue<PE32PendingCall> submitted = new();
+    private readonly ConcurrentQueue<IReadOnlyList<UltraFastIPCClient>> retired = new();
+    private readonly List<PE32PendingCall> pending = [];
+    private readonly BinaryResponseReader response = new();
+    private readonly AutoResetEvent wake = new(false);
+    private readonly Thread thread;
+    private readonly int spinCount;
+
+    // Set while the poller sleeps on wake, the submitter then signals it
+    private int idle;
+    private volatile bool stopping;
+
+    public PE32AsyncPoller(int spinCount)
+    {
+        this.spinCount = spinCount;
+        thread = new Thread(Run) { IsBackground = true, Name = "PE32 completion poller" };
+        thread.Start();
+    }
+
+    // Called by any thread once the call has been posted, in any order
+    public void Add(PE32PendingCall call)
+    {
+        submitted.Enqueue(call);
+
+        // Pairs with the barrier between setting idle and the last look at submitted
+        Interlocked.MemoryBarrier();
+        if (Volatile.Read(ref idle) != 0)
+            wake.Set();
+    }
+
+    // Channels of a bridge that died, their calls fail on the poller thread
+    public void Retire(IReadOnlyList<UltraFastIPCClient> channels)
+    {
+        retired.Enqueue(channels);
+        wake.Set();
+    }
+
+    private void Run()
+    {
+        int rounds = 0;
+        while (!stopping)
+        {
+            while (submitted.TryDequeue(out var call))
+            {
+                pending.Add(call);
+            }
+            while (retired.TryDequeue(out var bridge))
+            {
+                FailAll(
+                    call => bridge.Contains(call.Channel),
+                    call =>
+                        call.Channel.BridgeLost(call.Sequence)
+                        ?? new PE32BridgeLostException(
+                            $"Bridge was replaced before answering request {call.Sequence}"
+                        )
+                );
+            }
+
+            if (pending.Count == 0)
+            {
+                // Announce first and look again, a call may have been added in between
+                Volatile.Write(ref idle, 1);
+                Interlocked.MemoryBarrier();
+                if (submitted.IsEmpty && retired.IsEmpty && !stopping)
+                    wake.WaitOne();
+                Volatile.Write(ref idle, 0);
+                rounds = 0;
+                continue;
+            }
+
+            bool completed = false;
+            bool checkBridge = (++rounds & BridgeCheckInterval) == 0;
+            long now = Stopwatch.GetTimestamp();
+            for (int i = pending.Count - 1; i >= 0; i--)
+            {
+                // Read first, the call goes back to its pool as soon as it is awaited
+                var call = pending[i];
+                var channel = call.Channel;
+                uint sequence = call.Sequence;
+                if (channel.TryReadResponse(sequence, response))
+                {
+                    call.Complete(response);
+                }
+                else if (checkBridge && channel.BridgeLost(sequence) is { } lost)
+                {
+                    call.Fail(lost);
+                }
+                else if (now > call.Deadline)
+                {
+                    call.Fail(new TimeoutException($"{call.Opcode} (request {sequence}) timed out"));
+                }
+                else
+                {
+                    continue;
+                }
+
+                // The slot may take a new request only after its response has been decoded
+                channel.ReleaseSlot(sequence);
+                pending.RemoveAt(i);
+                completed = true;
+            }
+
+            if (completed)
+                rounds = 0;
+            else if (rounds < spinCount)
+                Thread.SpinWait(1);
+            else
+                Thread.Yield();
+        }
+
+        while (submitted.TryDequeue(out var call))
+        {
+            pending.Add(call);
+        }
+        var disposed = new ObjectDisposedException(nameof(PE32Proxy));
+        FailAll(_ => true, _ => disposed);
+    }
+
+    private void FailAll(Predicate<PE32PendingCall> match, Func<PE32PendingCall, Exception> error)
+    {
+        for (int i = pending.Count - 1; i >= 0; i--)
+        {
+            var call = pending[i];
+            if (!match(call))
+                continue;
+
+            call.Channel.ReleaseSlot(call.Sequence);
+            call.Fail(error(call));
+            pending.RemoveAt(i);
+        }
+    }
+
+    public void Dispose()
+    {
+        stopping = true;
+        wake.Set();
+        thread.Join();
+        wake.Dispose();
+    }
+}
@@ -0,0 +1,280 @@
+﻿using System.Buffers.Binary;
+using System.Text;
+
+namespace PE32Proxy;
+
+// Collects PE32 calls and sends them as batch requests, one handshake per 4 KB of commands.
+// The server runs them in order and stops at the first failure. With PE32ProxyOptions.ReduceBatches
+// it drops overwritten writes and groups the commands by board first. Until() turns a status
+// check into a loop the bridge runs next to the DLL, so a flow such as
+//   batch.pe32_fstart(bdn, 1).pe32_check_ftend(bdn).Until(1, timeout).pe32_rd_fccnt(bdn)
+// takes one round trip instead of one per poll.
+public sealed partial class PE32Batch
+{
+    private readonly UltraFastIPCClient client;
+    private readonly BinaryRequestWriter request = new();
+    private readonly BinaryRequestWriter batch = new();
+    private readonly BinaryRequestWriter poll = new();
+    private readonly List<PE32Opcode> opcodes = [];
+    private readonly PE32BatchResults results = new();
+    private readonly PE32QueryCache queryCache;
+    private readonly PE32Prologue prologue;
+
+    // Prologue requests among the commands not sent yet, by command index. Recorded once they ran.
+    private readonly List<(int Index, byte[] Request)> prologueRequests = [];
+
+    // Set by pe32_init and pe32_reset, the next Send() invalidates the proxy's query cache
+    private bool invalidatesQueryCache;
+
+    // Set while the command added last is still in the pending batch request and may become a poll
+    private bool canPoll;
+
+    // Time the pending polls may take at most, added to the wait for the response
+    private long pollMicroseconds;
+
+    // Channel 0 of the bridge the batch was built for, a failover replaces it
+    internal UltraFastIPCClient Client => client;
+
+    internal PE32Batch(UltraFastIPCClient client, PE32QueryCache queryCache, PE32Prologue prologue)
+    {
+        this.client = client;
+        this.queryCache = queryCache;
+        this.prologue = prologue;
+    }
+
+    // Number of commands added since BeginBatch()
+    public int Count => opcodes.Count;
+
+    internal PE32Batch Reset()
+    {
+        batch.BeginBatch();
+        opcodes.Clear();
+        prologueRequests.Clear();
+        results.Clear();
+        canPoll = false;
+        pollMicroseconds = 0;
+        return this;
+    }
+
+    // Repeats the command added last until (result & mask) == value, waiting interval between runs.
+    // The command must return an int or uint, its result is that of the last run. Execute() throws
+    // with BinaryStatus.Timeout if the condition does not hold within timeout.
+    public PE32Batch Until(int value, TimeSpan timeout, TimeSpan interval = default, int mask = ~0)
+    {
+        return Poll(PollCompare.Equal, value, timeout, interval, mask);
+    }
+
+    // The same, until (result & mask) != value
+    public PE32Batch UntilNot(int value, TimeSpan timeout, TimeSpan interval = default, int mask = ~0)
+    {
+        return Poll(PollCompare.NotEqual, value, timeout, interval, mask);
+    }
+
+    private PE32Batch Poll(PollCompare compare, int value, TimeSpan timeout, TimeSpan interval, int mask)
+    {
+        if (!canPoll)
+            throw new InvalidOperationException("Until() must follow the command it repeats");
+
+        int timeoutMicroseconds = (int)Math.Clamp(timeout.TotalMicroseconds, 0, int.MaxValue);
+        int intervalMicroseconds = (int)Math.Clamp(interval.TotalMicroseconds, 0, int.MaxValue);
+        batch.RemoveLast();
+        poll.BeginPoll(compare, mask, value, intervalMicroseconds, timeoutMicroseconds, request);
+        opcodes.RemoveAt(opcodes.Count - 1);
+        Add(poll, request.Opcode);
+
+        // The last run may start right before the timeout
+        pollMicroseconds += (long)timeoutMicroseconds + intervalMicroseconds;
+        canPoll = false;
+        return this;
+    }
+
+    // Sends the commands still pending. The results stay valid until the next BeginBatch().
+    public PE32BatchResults Execute()
+    {
+        Send();
+        return results;
+    }
+
+    private BinaryRequestWriter Begin(PE32Opcode opcode)
+    {
+        return request.Begin(opcode);
+    }
+
+    private PE32Batch Add(BinaryRequestWriter request)
+    {
+        Add(request, request.Opcode);
+
+        // Until() wraps the command later, the standby still replays it plain
+        if (PE32Prologue.Records(request.Opcode))
+            prologueRequests.Add((opcodes.Count - 1, request.Written.ToArray()));
+        return this;
+    }
+
+    private PE32Batch Add(BinaryRequestWriter request, PE32Opcode opcode)
+    {
+        if (!batch.TryAppend(request))
+        {
+            // Full, send what we have and start the next batch request
+            Send();
+            if (!batch.TryAppend(request))
+                throw new ArgumentException("Request data is too large");
+        }
+        opcodes.Add(opcode);
+        canPoll = true;
+        return this;
+    }
+
+    private void Send()
+    {
+        if (batch.BatchCount == 0)
+            return;
+
+        using var invalidation = queryCache.BeginInvalidation(invalidatesQueryCache);
+        invalidatesQueryCache = false;
+        int timeoutMicroseconds = (int)Math.Min(1000000 + pollMicroseconds, int.MaxValue);
+        var response = client.SendRequestBinary(batch, timeoutMicroseconds);
+        batch.BeginBatch();
+        canPoll = false;
+        pollMicroseconds = 0;
+
+        // A malformed batch is rejected before anything runs. With --reduce-batches, commands
+        // of other boards may be answered after the failure, either run or NotRun.
+        int executed = response.Remaining >= sizeof(ushort) ? response.ReadUInt16() : 0;
+        int first = results.Count;
+        int failed = -1;
+        int notRun = -1;
+        var failure = BinaryStatus.Ok;
+        for (int i = 0; i < executed; i++)
+        {
+            ReadOnlySpan<byte> result = response.ReadBytes(response.ReadUInt16());
+            var status = (BinaryStatus)BinaryPrimitives.ReadInt32LittleEndian(result);
+            if (status == BinaryStatus.Ok)
+            {
+                if (failed < 0)
+                    results.Add(result.Slice(sizeof(int)));
+                RecordPrologue(first + i);
+            }
+            else
+            {
+                if (status == BinaryStatus.NotRun && notRun < 0)
+                    notRun = first + i;
+                if (failed < 0 || (failure == BinaryStatus.NotRun && status != BinaryStatus.NotRun))
+                {
+                    failed = first + i;
+                    failure = status;
+                }
+            }
+        }
+        prologueRequests.Clear();
+        if (failed >= 0)
+        {
+            // Commands of other boards and dropped writes may not have run although sent earlier
+            string earlier =
+                notRun >= 0 && notRun < failed ? $", command {notRun} ({opcodes[notRun]}) did not run" : "";
+            throw new InvalidOperationException(
+                $"Batch command {failed} ({opcodes[failed]}) failed: {failure}{earlier}"
+            );
+        }
+
+        if (response.Status != BinaryStatus.Ok)
+            throw new InvalidOperationException($"Batch failed: {response.Status}");
+    }
+
+    // Batches run on channel 0, a standby replays the command there on its own
+    private void RecordPrologue(int index)
+    {
+        foreach (var (recordedIndex, request) in prologueRequests)
+        {
+            if (recordedIndex == index)
+                prologue.Record(opcodes[index], 0, request);
+        }
+    }
+}
+
+// Return values of an executed batch, indexed by the order the commands were added
+public sealed class PE32BatchResults
+{
+    private byte[] data = new byte[UltraFastIPCClient.BufferSize];
+    private int length;
+    private readonly List<(int Offset, int Length)> entries = [];
+
+    public int Count => entries.Count;
+
+    public int GetInt32(int index) => BinaryPrimitives.ReadInt32LittleEndian(Get(index, sizeof(int)));
+
+    public uint GetUInt32(int index) =>
+        BinaryPrimitives.ReadUInt32LittleEndian(Get(index, sizeof(uint)));
+
+    public double GetDouble(int index) =>
+        BinaryPrimitives.ReadDoubleLittleEndian(Get(index, sizeof(double)));
+
+    public string GetString(int index)
+    {
+        ReadOnlySpan<byte> value = Get(index, sizeof(uint));
+        return Encoding.UTF8.GetString(value.Slice(sizeof(uint)));
+    }
+
+    // Return value and out-values of command index, in wire order
+    public PE32BatchValues GetValues(int index)
+    {
+        var (offset, size) = entries[index];
+        return new PE32BatchValues(data.AsSpan(offset, size));
+    }
+
+    internal void Clear()
+    {
+        length = 0;
+        entries.Clear();
+    }
+
+    internal void Add(ReadOnlySpan<byte> result)
+    {
+        if (length + result.Length > data.Length)
+            Array.Resize(ref data, Math.Max(data.Length * 2, length + result.Length));
+
+        result.CopyTo(data.AsSpan(length));
+        entries.Add((length, result.Length));
+        length += result.Length;
+    }
+
+    private ReadOnlySpan<byte> Get(int index, int minimumLength)
+    {
+        var (offset, size) = entries[index];
+        if (size < minimumLength)
+            throw new InvalidOperationException($"Batch command {index} returned no such value");
+
+        return data.AsSpan(offset, size);
+    }
+}
+
+// Sequential reader over the values of one batched command: return value first, then the out-values
+public ref struct PE32BatchValues
+{
+    private ReadOnlySpan<byte> data;
+
+    internal PE32BatchValues(ReadOnlySpan<byte> data)
+    {
+        this.data = data;
+    }
+
+    public int ReadInt32() => BinaryPrimitives.ReadInt32LittleEndian(Take(sizeof(int)));
+
+    public uint ReadUInt32() => BinaryPrimitives.ReadUInt32LittleEndian(Take(sizeof(uint)));
+
+    public double ReadDouble() => BinaryPrimitives.ReadDoubleLittleEndian(Take(sizeof(double)));
+
+    public string ReadString() => Encoding.UTF8.GetString(Take((int)ReadUInt32()));
+
+    // Byte payload, valid until the next BeginBatch()
+    public ReadOnlySpan<byte> ReadBytes() => Take((int)ReadUInt32());
+
+    private ReadOnlySpan<byte> Take(int size)
+    {
+        if (size > data.Length)
+            throw new InvalidOperationException("Batch command returned no such value");
+
+        ReadOnlySpan<byte> value = data.Slice(0, size);
+        data = data.Slice(size);
+        return value;
+    }
+}
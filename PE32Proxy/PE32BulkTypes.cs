@@ -0,0 +1,18 @@
+﻿namespace PE32Proxy;
+
+// Element types of the packed range reads, laid out as the bridge writes them
+
+// pe32_bulk_dump_getalogclog, one per address
+public readonly struct AlogClog
+{
+    public readonly int Alog;
+    public readonly int Clog;
+}
+
+// pe32_bulk_rd_lm, one per board
+public readonly struct LmCounters
+{
+    public readonly int Lmf;
+    public readonly int Lmd;
+    public readonly int Lmm;
+}
@@ -0,0 +1,53 @@
+﻿using System.Diagnostics;
+
+namespace PE32Proxy;
+
+// Where the time of one call went, from the timestamps the client and the bridge
+// write into its ring slot. Both sides read QueryPerformanceCounter, so they compare directly.
+public readonly struct PE32CallTimings
+{
+    private readonly long submit;
+    private readonly long pickup;
+    private readonly long dllEnter;
+    private readonly long dllExit;
+    private readonly long publish;
+    private readonly long completed;
+
+    internal unsafe PE32CallTimings(RingSlot* slot, long completedTime)
+    {
+        submit = slot->submit_time;
+        pickup = slot->pickup_time;
+        publish = slot->publish_time;
+
+        // A request without a DLL call spends all its server time outside the DLL
+        dllEnter = slot->dll_enter_time != 0 ? slot->dll_enter_time : publish;
+        dllExit = slot->dll_enter_time != 0 ? slot->dll_exit_time : publish;
+        completed = completedTime;
+    }
+
+    // Client post to server pickup: handshake, wake-up and requests queued ahead
+    public TimeSpan Queue => Elapsed(submit, pickup);
+
+    // Pickup to the first DLL call: decoding and waiting for the dispatch lock
+    public TimeSpan Dispatch => Elapsed(pickup, dllEnter);
+
+    // First DLL call entered to last one returned
+    public TimeSpan Dll => Elapsed(dllEnter, dllExit);
+
+    // Last DLL call returned to response published: encoding the result
+    public TimeSpan Encode => Elapsed(dllExit, publish);
+
+    // Response published to the client seeing it
+    public TimeSpan Wake => Elapsed(publish, completed);
+
+    public TimeSpan Total => Elapsed(submit, completed);
+
+    // Everything that is not vendor DLL time
+    public TimeSpan IpcOverhead => Total - Dll;
+
+    public override string ToString() =>
+        $"total {Total.TotalMicroseconds:F1} us = queue {Queue.TotalMicroseconds:F1} + dispatch {Dispatch.TotalMicroseconds:F1} "
+        + $"+ dll {Dll.TotalMicroseconds:F1} + encode {Encode.TotalMicroseconds:F1} + wake {Wake.TotalMicroseconds:F1}";
+
+    private static TimeSpan Elapsed(long from, long to) => Stopwatch.GetElapsedTime(from, to);
+}
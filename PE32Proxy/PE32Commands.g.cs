@@ -0,0 +1,2952 @@
+// <auto-generated>
+//     Generated by "UltraFastIPC.exe --emit-csharp" from UltraFastIPC/PE32Commands.h.
+//     Do not edit, regenerate after changing the command list.
+// </auto-generated>
+namespace PE32Proxy;
+
+// Opcode ids of the binary protocol, in the order of PE32Commands.h
+internal enum PE32Opcode : ushort
+{
+    pe32_init,
+    pe32_usb,
+    pe32_readl,
+    pe32_writel,
+    pe32_set_sctl,
+    pe32_set_sdata,
+    pe32_rd_sio,
+    pe32_wr_pe,
+    pe32_rd_pe,
+    pe32_rst_pe,
+    pe32_usleep,
+    pe32_api,
+    pe32_reset,
+    pe32_fdiag,
+    pe32_fstart,
+    pe32_diag_fstart,
+    pe32_cycle,
+    pe32_check_reset,
+    pe32_check_fstart,
+    pe32_check_cycle,
+    pe32_check_tprun,
+    pe32_check_sync,
+    pe32_check_testbeg,
+    pe32_check_tpass,
+    pe32_check_ftend,
+    pe32_check_lend,
+    pe32_set_pxi,
+    pe32_pxi_fstart,
+    pe32_pxi_cfail,
+    pe32_pxi_lmsyn,
+    pe32_set_addbeg,
+    pe32_set_addend,
+    pe32_set_ftcnt,
+    pe32_set_addsyn,
+    pe32_set_addif,
+    pe32_set_logadd,
+    pe32_set_seq,
+    pe32_set_lmf,
+    pe32_set_mmsk,
+    pe32_set_tp,
+    pe32_set_tstrob,
+    pe32_set_tstart,
+    pe32_set_tstop,
+    pe32_set_rz,
+    pe32_set_ro,
+    pe32_set_io,
+    pe32_set_mk,
+    pe32_set_dstrob,
+    pe32_rd_actseq,
+    pe32_rd_actlmf,
+    pe32_rd_actlmd,
+    pe32_rd_actlmm,
+    pe32_rd_actlmadd,
+    pe32_rd_pxibus,
+    pe32_rd_id,
+    pe32_rd_vc,
+    pe32_rd_seq,
+    pe32_rd_lmf,
+    pe32_rd_lmd,
+    pe32_rd_lmm,
+    pe32_rd_lmadd,
+    pe32_lmload,
+    pe32_lmsave,
+    pe32_rd_cmph,
+    pe32_rd_cmpl,
+    pe32_rd_creg,
+    pe32_rd_ftcnt,
+    pe32_rd_fccnt,
+    pe32_rd_flcnt,
+    pe32_rd_clog,
+    pe32_rd_alog,
+    pe32_rd_logadd,
+    pe32_rd_alogclog,
+    pe32_dump_alogclog,
+    pe32_set_dumpmode,
+    pe32_dump_getclog,
+    pe32_dump_getalog,
+    pe32_dump_getalogclog,
+    pe32_check_dataready,
+    pe32_check_checkmode,
+    pe32_check_logmode,
+    pe32_check_trigmode,
+    pe32_check_dualmode,
+    pe32_set_trigmode,
+    pe32_set_logmode,
+    pe32_check_ucnt,
+    pe32_set_checkmode,
+    pe32_set_vih,
+    pe32_set_vil,
+    pe32_set_voh,
+    pe32_set_vol,
+    pe32_set_driver,
+    pe32_cpu_df,
+    pe32_pmufv,
+    pe32_pmufi,
+    pe32_pmufir,
+    pe32_vmeas,
+    pe32_imeas,
+    pe32_pmucv,
+    pe32_pmuci,
+    pe32_con_pmu,
+    pe32_con_pmus,
+    pe32_con_receiver,
+    pe32_check_pmu,
+    pe32_pmuch,
+    pe32_pmucl,
+    pe32_cal_load,
+    pe32_cal_save,
+    pe32_cal_load_auto,
+    pe32_cal_save_auto,
+    pe32_cal_reset,
+    pe32_con_esense,
+    pe32_con_eforce,
+    pe32_con_ext,
+    pe32_set_deskew,
+    pe32_set_fallingskew,
+    pe32_set_rcvskew,
+    pe32_set_rcvfallingskew,
+    pe32_getch,
+    pe32_getcl,
+    pemu32_rst_pe,
+    pemu32_set_driver,
+    pe32_counter_ctp,
+    pe32_counter_start,
+    pe32_counter_select_ch,
+    pe32_counter_rd,
+    pe32_counter_rdfrq,
+    pe32_counter_tmmode,
+    pe32_tmu_cstart_inv,
+    pe32_tmu_cstop_inv,
+    pe32_tmu_select_cstart,
+    pe32_tmu_select_cstop,
+    pe32_rd_pesno,
+    pe32_get_temp,
+    pe32_set_srdmode,
+    pe32_srd_select_ch,
+    pe32_srd_getword,
+    pe32_srd_getword2,
+    pe32_srd_getsrword,
+    pe32_srd_rdblock32,
+    pe32_setReg,
+    pe32_dc_range,
+    pe32_set_lmsyn_active_high,
+    pe32_set_lmsyn_ch,
+    pe32_rd_logcnt,
+    pe32_reset_lmiomk,
+    pe32_con_2k2vtt,
+    pe32_get_msg,
+    pe32_set_rffemode,
+    pe32_rffe_ftp,
+    pe32_rffe_pclk,
+    pe32_rffe_wr,
+    pe32_rffe_rd,
+    pe32_rffe_ewr,
+    pe32_rffe_erd,
+    pe32_rffe_getword,
+    pe32_rffe_wr0,
+    pe32_rffe_elwr,
+    pe32_rffe_elrd,
+    pe32_rffe_cmdwr,
+    pe32_rffe_cmdrd,
+    pe32_set_qmode,
+    pe32_check_qfail,
+    pe32_set_rodvhdvl,
+    pe32_rd_PciRevId,
+    pe32_rd_PciDevId,
+    pe32_rd_PciSubId,
+    pe32_trig_mv,
+    pe32_trig_mi,
+    pe32_trig_imeas,
+    pe32_trig_vmeas,
+    pe32_user_fram_save,
+    pe32_user_fram_load,
+    pe32_bulk_dump_getalog,
+    pe32_bulk_dump_getclog,
+    pe32_bulk_srd_getword,
+    pe32_bulk_dump_getalogclog,
+    pe32_bulk_srd_rdblock32,
+    pe32_bulk_rd_lm,
+    ipc_nop,
+    ipc_echo,
+    ipc_echo_bytes,
+    ipc_echo_bulk,
+    pe32_pattern_store,
+    pe32_pattern_lmload,
+}
+
+// Typed stubs for every PE32 entry point exported by the bridge
+public partial class PE32Proxy
+{
+    public int pe32_init()
+    {
+        using var invalidation = queryCache.BeginInvalidation();
+        return Call(Begin(PE32Opcode.pe32_init)).ReadInt32();
+    }
+
+    public int pe32_usb()
+    {
+        return Call(Begin(PE32Opcode.pe32_usb)).ReadInt32();
+    }
+
+    public (int Result, int Buffer) pe32_readl(int bdn, int offset)
+    {
+        var response = Call(Begin(PE32Opcode.pe32_readl, bdn).WriteInt32(bdn).WriteInt32(offset));
+        var result = response.ReadInt32();
+        var buffer = response.ReadInt32();
+        return (result, buffer);
+    }
+
+    public void pe32_writel(int bdn, int offset, int buf)
+    {
+        Send(Begin(PE32Opcode.pe32_writel, bdn).WriteInt32(bdn).WriteInt32(offset).WriteInt32(buf));
+    }
+
+    public void pe32_set_sctl(int bdn, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_sctl, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public void pe32_set_sdata(int bdn, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_sdata, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public int pe32_rd_sio(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_sio, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public void pe32_wr_pe(int bdn, int chip, int port, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_wr_pe, bdn).WriteInt32(bdn).WriteInt32(chip).WriteInt32(port).WriteInt32(data));
+    }
+
+    public int pe32_rd_pe(int bdn, int chip, int port)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_pe, bdn).WriteInt32(bdn).WriteInt32(chip).WriteInt32(port)).ReadInt32();
+    }
+
+    public void pe32_rst_pe(int bdn)
+    {
+        Send(Begin(PE32Opcode.pe32_rst_pe, bdn).WriteInt32(bdn));
+    }
+
+    public void pe32_usleep(int usec)
+    {
+        Send(Begin(PE32Opcode.pe32_usleep).WriteInt32(usec));
+    }
+
+    public int pe32_api()
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_api, 0, out int cached, out long version))
+            return cached;
+        var result = Call(Begin(PE32Opcode.pe32_api)).ReadInt32();
+        queryCache.Store(PE32Opcode.pe32_api, 0, result, version);
+        return result;
+    }
+
+    public void pe32_reset(int bdn)
+    {
+        using var invalidation = queryCache.BeginInvalidation();
+        Send(Begin(PE32Opcode.pe32_reset, bdn).WriteInt32(bdn));
+    }
+
+    public int pe32_fdiag(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_fdiag, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public void pe32_fstart(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_fstart, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public void pe32_diag_fstart(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_diag_fstart, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public void pe32_cycle(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_cycle, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public int pe32_check_reset(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_reset, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_check_fstart(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_fstart, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_check_cycle(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_cycle, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_check_tprun(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_tprun, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_check_sync(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_sync, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_check_testbeg(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_testbeg, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_check_tpass(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_tpass, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_check_ftend(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_ftend, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_check_lend(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_lend, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public void pe32_set_pxi(int bdn, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_pxi, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public void pe32_pxi_fstart(int bdn, int ch, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_pxi_fstart, bdn).WriteInt32(bdn).WriteInt32(ch).WriteInt32(onoff));
+    }
+
+    public void pe32_pxi_cfail(int bdn, int ch, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_pxi_cfail, bdn).WriteInt32(bdn).WriteInt32(ch).WriteInt32(onoff));
+    }
+
+    public void pe32_pxi_lmsyn(int bdn, int ch, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_pxi_lmsyn, bdn).WriteInt32(bdn).WriteInt32(ch).WriteInt32(onoff));
+    }
+
+    public void pe32_set_addbeg(int bdn, int add)
+    {
+        Send(Begin(PE32Opcode.pe32_set_addbeg, bdn).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public void pe32_set_addend(int bdn, int cnt)
+    {
+        Send(Begin(PE32Opcode.pe32_set_addend, bdn).WriteInt32(bdn).WriteInt32(cnt));
+    }
+
+    public void pe32_set_ftcnt(int bdn, int cnt)
+    {
+        Send(Begin(PE32Opcode.pe32_set_ftcnt, bdn).WriteInt32(bdn).WriteInt32(cnt));
+    }
+
+    public void pe32_set_addsyn(int bdn, int add)
+    {
+        Send(Begin(PE32Opcode.pe32_set_addsyn, bdn).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public void pe32_set_addif(int bdn, int add)
+    {
+        Send(Begin(PE32Opcode.pe32_set_addif, bdn).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public void pe32_set_logadd(int bdn, int add)
+    {
+        Send(Begin(PE32Opcode.pe32_set_logadd, bdn).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public void pe32_set_seq(int bdn, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_seq, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public void pe32_set_lmf(int bdn, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_lmf, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public void pe32_set_mmsk(int bdn, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_mmsk, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public void pe32_set_tp(int bdn, int ts, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_tp, bdn).WriteInt32(bdn).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public void pe32_set_tstrob(int bdn, int pno, int ts, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_tstrob, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public void pe32_set_tstart(int bdn, int pno, int ts, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_tstart, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public void pe32_set_tstop(int bdn, int pno, int ts, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_tstop, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public void pe32_set_rz(int bdn, int fs, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_rz, bdn).WriteInt32(bdn).WriteInt32(fs).WriteInt32(data));
+    }
+
+    public void pe32_set_ro(int bdn, int ts, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_ro, bdn).WriteInt32(bdn).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public void pe32_set_io(int bdn, int ts, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_io, bdn).WriteInt32(bdn).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public void pe32_set_mk(int bdn, int ts, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_set_mk, bdn).WriteInt32(bdn).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public void pe32_set_dstrob(int bdn, int pno, int ts, int data1, int data2)
+    {
+        Send(Begin(PE32Opcode.pe32_set_dstrob, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(ts).WriteInt32(data1).WriteInt32(data2));
+    }
+
+    public void pe32_rd_actseq(int bdn)
+    {
+        Send(Begin(PE32Opcode.pe32_rd_actseq, bdn).WriteInt32(bdn));
+    }
+
+    public int pe32_rd_actlmf(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_actlmf, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_rd_actlmd(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_actlmd, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_rd_actlmm(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_actlmm, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_rd_actlmadd(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_actlmadd, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_rd_pxibus(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_pxibus, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_rd_id(int bdn)
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_rd_id, bdn, out int cached, out long version))
+            return cached;
+        var result = Call(Begin(PE32Opcode.pe32_rd_id, bdn).WriteInt32(bdn)).ReadInt32();
+        queryCache.Store(PE32Opcode.pe32_rd_id, bdn, result, version);
+        return result;
+    }
+
+    public int pe32_rd_vc(int bdn)
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_rd_vc, bdn, out int cached, out long version))
+            return cached;
+        var result = Call(Begin(PE32Opcode.pe32_rd_vc, bdn).WriteInt32(bdn)).ReadInt32();
+        queryCache.Store(PE32Opcode.pe32_rd_vc, bdn, result, version);
+        return result;
+    }
+
+    public int pe32_rd_seq(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_seq, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_rd_lmf(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_lmf, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_rd_lmd(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_lmd, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_rd_lmm(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_lmm, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_rd_lmadd(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_lmadd, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_lmload(int begbdno, int boardwidth, int begadd, string patternfile)
+    {
+        return Call(Begin(PE32Opcode.pe32_lmload).WriteInt32(begbdno).WriteInt32(boardwidth).WriteInt32(begadd).WriteString(patternfile)).ReadInt32();
+    }
+
+    public int pe32_lmsave(int begbdno, int boardwidth, int begadd, int endadd, string patternfile)
+    {
+        return Call(Begin(PE32Opcode.pe32_lmsave).WriteInt32(begbdno).WriteInt32(boardwidth).WriteInt32(begadd).WriteInt32(endadd).WriteString(patternfile)).ReadInt32();
+    }
+
+    public int pe32_rd_cmph(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_cmph, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_rd_cmpl(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_cmpl, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_rd_creg(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_creg, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public uint pe32_rd_ftcnt(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_ftcnt, bdn).WriteInt32(bdn)).ReadUInt32();
+    }
+
+    public uint pe32_rd_fccnt(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_fccnt, bdn).WriteInt32(bdn)).ReadUInt32();
+    }
+
+    public uint pe32_rd_flcnt(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_flcnt, bdn).WriteInt32(bdn)).ReadUInt32();
+    }
+
+    public int pe32_rd_clog(int bdn, int addr)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_clog, bdn).WriteInt32(bdn).WriteInt32(addr)).ReadInt32();
+    }
+
+    public int pe32_rd_alog(int bdn, int addr)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_alog, bdn).WriteInt32(bdn).WriteInt32(addr)).ReadInt32();
+    }
+
+    public int pe32_rd_logadd(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_logadd, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public (int Result, int Alog, int Clog) pe32_rd_alogclog(int bdn, int addr)
+    {
+        var response = Call(Begin(PE32Opcode.pe32_rd_alogclog, bdn).WriteInt32(bdn).WriteInt32(addr));
+        var result = response.ReadInt32();
+        var alog = response.ReadInt32();
+        var clog = response.ReadInt32();
+        return (result, alog, clog);
+    }
+
+    public (int Result, int Alog, int Clog) pe32_dump_alogclog(int bdn, int ksize)
+    {
+        var response = Call(Begin(PE32Opcode.pe32_dump_alogclog, bdn).WriteInt32(bdn).WriteInt32(ksize));
+        var result = response.ReadInt32();
+        var alog = response.ReadInt32();
+        var clog = response.ReadInt32();
+        return (result, alog, clog);
+    }
+
+    public void pe32_set_dumpmode(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_set_dumpmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public int pe32_dump_getclog(int bdn, int addr)
+    {
+        return Call(Begin(PE32Opcode.pe32_dump_getclog, bdn).WriteInt32(bdn).WriteInt32(addr)).ReadInt32();
+    }
+
+    public int pe32_dump_getalog(int bdn, int addr)
+    {
+        return Call(Begin(PE32Opcode.pe32_dump_getalog, bdn).WriteInt32(bdn).WriteInt32(addr)).ReadInt32();
+    }
+
+    public (int Result, int Alog, int Clog) pe32_dump_getalogclog(int bdn, int add)
+    {
+        var response = Call(Begin(PE32Opcode.pe32_dump_getalogclog, bdn).WriteInt32(bdn).WriteInt32(add));
+        var result = response.ReadInt32();
+        var alog = response.ReadInt32();
+        var clog = response.ReadInt32();
+        return (result, alog, clog);
+    }
+
+    public int pe32_check_dataready(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_dataready, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_check_checkmode(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_checkmode, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_check_logmode(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_logmode, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_check_trigmode(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_trigmode, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_check_dualmode(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_dualmode, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public void pe32_set_trigmode(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_set_trigmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public void pe32_set_logmode(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_set_logmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public int pe32_check_ucnt(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_ucnt, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public void pe32_set_checkmode(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_set_checkmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public void pe32_set_vih(int bdn, int pno, double rv)
+    {
+        Send(Begin(PE32Opcode.pe32_set_vih, bdn).WriteInt32(bdn).WriteInt32(pno).WriteDouble(rv));
+    }
+
+    public void pe32_set_vil(int bdn, int pno, double rv)
+    {
+        Send(Begin(PE32Opcode.pe32_set_vil, bdn).WriteInt32(bdn).WriteInt32(pno).WriteDouble(rv));
+    }
+
+    public void pe32_set_voh(int bdn, int pno, double rv)
+    {
+        Send(Begin(PE32Opcode.pe32_set_voh, bdn).WriteInt32(bdn).WriteInt32(pno).WriteDouble(rv));
+    }
+
+    public void pe32_set_vol(int bdn, int pno, double rv)
+    {
+        Send(Begin(PE32Opcode.pe32_set_vol, bdn).WriteInt32(bdn).WriteInt32(pno).WriteDouble(rv));
+    }
+
+    public void pe32_set_driver(int bdn, int pno, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_set_driver, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public void pe32_cpu_df(int bdn, int pno, int donoff, int fonoff)
+    {
+        Send(Begin(PE32Opcode.pe32_cpu_df, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(donoff).WriteInt32(fonoff));
+    }
+
+    public void pe32_pmufv(int bdn, int chip, double rv, double clamp)
+    {
+        Send(Begin(PE32Opcode.pe32_pmufv, bdn).WriteInt32(bdn).WriteInt32(chip).WriteDouble(rv).WriteDouble(clamp));
+    }
+
+    public void pe32_pmufi(int bdn, int chip, double ri, double cvh, double cvl)
+    {
+        Send(Begin(PE32Opcode.pe32_pmufi, bdn).WriteInt32(bdn).WriteInt32(chip).WriteDouble(ri).WriteDouble(cvh).WriteDouble(cvl));
+    }
+
+    public void pe32_pmufir(int bdn, int chip, double ri, double cvh, double cvl, int rang)
+    {
+        Send(Begin(PE32Opcode.pe32_pmufir, bdn).WriteInt32(bdn).WriteInt32(chip).WriteDouble(ri).WriteDouble(cvh).WriteDouble(cvl).WriteInt32(rang));
+    }
+
+    public double pe32_vmeas(int bdn, int pno)
+    {
+        return Call(Begin(PE32Opcode.pe32_vmeas, bdn).WriteInt32(bdn).WriteInt32(pno)).ReadDouble();
+    }
+
+    public double pe32_imeas(int bdn, int pno)
+    {
+        return Call(Begin(PE32Opcode.pe32_imeas, bdn).WriteInt32(bdn).WriteInt32(pno)).ReadDouble();
+    }
+
+    public void pe32_pmucv(int bdn, int chip, double cvh, double cvl)
+    {
+        Send(Begin(PE32Opcode.pe32_pmucv, bdn).WriteInt32(bdn).WriteInt32(chip).WriteDouble(cvh).WriteDouble(cvl));
+    }
+
+    public void pe32_pmuci(int bdn, int chip, double cih, double cil)
+    {
+        Send(Begin(PE32Opcode.pe32_pmuci, bdn).WriteInt32(bdn).WriteInt32(chip).WriteDouble(cih).WriteDouble(cil));
+    }
+
+    public void pe32_con_pmu(int bdn, int pno, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_con_pmu, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public void pe32_con_pmus(int bdn, int pno, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_con_pmus, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public void pe32_con_receiver(int bdn, int pno, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_con_receiver, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public int pe32_check_pmu(int bdn, int chip)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_pmu, bdn).WriteInt32(bdn).WriteInt32(chip)).ReadInt32();
+    }
+
+    public int pe32_pmuch(int bdn, int chip)
+    {
+        return Call(Begin(PE32Opcode.pe32_pmuch, bdn).WriteInt32(bdn).WriteInt32(chip)).ReadInt32();
+    }
+
+    public int pe32_pmucl(int bdn, int chip)
+    {
+        return Call(Begin(PE32Opcode.pe32_pmucl, bdn).WriteInt32(bdn).WriteInt32(chip)).ReadInt32();
+    }
+
+    public int pe32_cal_load(int bdn, string calfile)
+    {
+        return Call(Begin(PE32Opcode.pe32_cal_load, bdn).WriteInt32(bdn).WriteString(calfile)).ReadInt32();
+    }
+
+    public int pe32_cal_save(int bdn, string calfile)
+    {
+        return Call(Begin(PE32Opcode.pe32_cal_save, bdn).WriteInt32(bdn).WriteString(calfile)).ReadInt32();
+    }
+
+    public int pe32_cal_load_auto(int bdn, string calfile)
+    {
+        return Call(Begin(PE32Opcode.pe32_cal_load_auto, bdn).WriteInt32(bdn).WriteString(calfile)).ReadInt32();
+    }
+
+    public int pe32_cal_save_auto(int bdn, string calfile)
+    {
+        return Call(Begin(PE32Opcode.pe32_cal_save_auto, bdn).WriteInt32(bdn).WriteString(calfile)).ReadInt32();
+    }
+
+    public void pe32_cal_reset(int bdn)
+    {
+        Send(Begin(PE32Opcode.pe32_cal_reset, bdn).WriteInt32(bdn));
+    }
+
+    public void pe32_con_esense(int bdn, int pno, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_con_esense, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public void pe32_con_eforce(int bdn, int pno, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_con_eforce, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public void pe32_con_ext(int bdn, int pno, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_con_ext, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public void pe32_set_deskew(int bdn, int pno, int rt)
+    {
+        Send(Begin(PE32Opcode.pe32_set_deskew, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rt));
+    }
+
+    public void pe32_set_fallingskew(int bdn, int pno, int rt)
+    {
+        Send(Begin(PE32Opcode.pe32_set_fallingskew, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rt));
+    }
+
+    public void pe32_set_rcvskew(int bdn, int pno, int rt)
+    {
+        Send(Begin(PE32Opcode.pe32_set_rcvskew, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rt));
+    }
+
+    public void pe32_set_rcvfallingskew(int bdn, int pno, int rt)
+    {
+        Send(Begin(PE32Opcode.pe32_set_rcvfallingskew, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rt));
+    }
+
+    public int pe32_getch(int bdn, int pno)
+    {
+        return Call(Begin(PE32Opcode.pe32_getch, bdn).WriteInt32(bdn).WriteInt32(pno)).ReadInt32();
+    }
+
+    public int pe32_getcl(int bdn, int pno)
+    {
+        return Call(Begin(PE32Opcode.pe32_getcl, bdn).WriteInt32(bdn).WriteInt32(pno)).ReadInt32();
+    }
+
+    public void pemu32_rst_pe(int bdn)
+    {
+        Send(Begin(PE32Opcode.pemu32_rst_pe, bdn).WriteInt32(bdn));
+    }
+
+    public void pemu32_set_driver(int bdn, int pno, int onoff)
+    {
+        Send(Begin(PE32Opcode.pemu32_set_driver, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public void pe32_counter_ctp(int bdn, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_counter_ctp, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public void pe32_counter_start(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_counter_start, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public void pe32_counter_select_ch(int bdn, int ch)
+    {
+        Send(Begin(PE32Opcode.pe32_counter_select_ch, bdn).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public int pe32_counter_rd(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_counter_rd, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public double pe32_counter_rdfrq(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_counter_rdfrq, bdn).WriteInt32(bdn)).ReadDouble();
+    }
+
+    public void pe32_counter_tmmode(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_counter_tmmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public void pe32_tmu_cstart_inv(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_tmu_cstart_inv, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public void pe32_tmu_cstop_inv(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_tmu_cstop_inv, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public void pe32_tmu_select_cstart(int bdn, int ch)
+    {
+        Send(Begin(PE32Opcode.pe32_tmu_select_cstart, bdn).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public void pe32_tmu_select_cstop(int bdn, int ch)
+    {
+        Send(Begin(PE32Opcode.pe32_tmu_select_cstop, bdn).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public int pe32_rd_pesno(int bdn)
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_rd_pesno, bdn, out int cached, out long version))
+            return cached;
+        var result = Call(Begin(PE32Opcode.pe32_rd_pesno, bdn).WriteInt32(bdn)).ReadInt32();
+        queryCache.Store(PE32Opcode.pe32_rd_pesno, bdn, result, version);
+        return result;
+    }
+
+    public double pe32_get_temp(int bdn, int cno)
+    {
+        return Call(Begin(PE32Opcode.pe32_get_temp, bdn).WriteInt32(bdn).WriteInt32(cno)).ReadDouble();
+    }
+
+    public void pe32_set_srdmode(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_set_srdmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public void pe32_srd_select_ch(int bdn, int ch)
+    {
+        Send(Begin(PE32Opcode.pe32_srd_select_ch, bdn).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public int pe32_srd_getword(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_srd_getword, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_srd_getword2(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_srd_getword2, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public int pe32_srd_getsrword(int bdn, int ch)
+    {
+        return Call(Begin(PE32Opcode.pe32_srd_getsrword, bdn).WriteInt32(bdn).WriteInt32(ch)).ReadInt32();
+    }
+
+    public int pe32_srd_rdblock32(int bdn, int add)
+    {
+        return Call(Begin(PE32Opcode.pe32_srd_rdblock32, bdn).WriteInt32(bdn).WriteInt32(add)).ReadInt32();
+    }
+
+    public void pe32_setReg(int bdn, int pno, int dacno, int rv)
+    {
+        Send(Begin(PE32Opcode.pe32_setReg, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(dacno).WriteInt32(rv));
+    }
+
+    public void pe32_dc_range(int bdn, int range)
+    {
+        Send(Begin(PE32Opcode.pe32_dc_range, bdn).WriteInt32(bdn).WriteInt32(range));
+    }
+
+    public void pe32_set_lmsyn_active_high(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_set_lmsyn_active_high, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public void pe32_set_lmsyn_ch(int bdn, int ch)
+    {
+        Send(Begin(PE32Opcode.pe32_set_lmsyn_ch, bdn).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public int pe32_rd_logcnt(int bdn)
+    {
+        return Call(Begin(PE32Opcode.pe32_rd_logcnt, bdn).WriteInt32(bdn)).ReadInt32();
+    }
+
+    public void pe32_reset_lmiomk(int bdn)
+    {
+        Send(Begin(PE32Opcode.pe32_reset_lmiomk, bdn).WriteInt32(bdn));
+    }
+
+    public void pe32_con_2k2vtt(int bdn, int pno, int onoff, double vtt)
+    {
+        Send(Begin(PE32Opcode.pe32_con_2k2vtt, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff).WriteDouble(vtt));
+    }
+
+    public string pe32_get_msg()
+    {
+        return Call(Begin(PE32Opcode.pe32_get_msg)).ReadString();
+    }
+
+    public void pe32_set_rffemode(int bdn, int port, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_set_rffemode, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(onoff));
+    }
+
+    public void pe32_rffe_ftp(int bdn, int wtp, int rtp)
+    {
+        Send(Begin(PE32Opcode.pe32_rffe_ftp, bdn).WriteInt32(bdn).WriteInt32(wtp).WriteInt32(rtp));
+    }
+
+    public void pe32_rffe_pclk(int bdn, int pclk)
+    {
+        Send(Begin(PE32Opcode.pe32_rffe_pclk, bdn).WriteInt32(bdn).WriteInt32(pclk));
+    }
+
+    public void pe32_rffe_wr(int bdn, int port, int sadd, int add, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_rffe_wr, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(data));
+    }
+
+    public int pe32_rffe_rd(int bdn, int port, int sadd, int add)
+    {
+        return Call(Begin(PE32Opcode.pe32_rffe_rd, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add)).ReadInt32();
+    }
+
+    public void pe32_rffe_ewr(int bdn, int port, int sadd, int add, int data, int bcnt)
+    {
+        Send(Begin(PE32Opcode.pe32_rffe_ewr, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(data).WriteInt32(bcnt));
+    }
+
+    public int pe32_rffe_erd(int bdn, int port, int sadd, int add, int bcnt)
+    {
+        return Call(Begin(PE32Opcode.pe32_rffe_erd, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(bcnt)).ReadInt32();
+    }
+
+    public int pe32_rffe_getword(int bdn, int port)
+    {
+        return Call(Begin(PE32Opcode.pe32_rffe_getword, bdn).WriteInt32(bdn).WriteInt32(port)).ReadInt32();
+    }
+
+    public void pe32_rffe_wr0(int bdn, int port, int sadd, int data)
+    {
+        Send(Begin(PE32Opcode.pe32_rffe_wr0, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(data));
+    }
+
+    public void pe32_rffe_elwr(int bdn, int port, int sadd, int add, int data, int bcnt)
+    {
+        Send(Begin(PE32Opcode.pe32_rffe_elwr, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(data).WriteInt32(bcnt));
+    }
+
+    public int pe32_rffe_elrd(int bdn, int port, int sadd, int add, int bcnt)
+    {
+        return Call(Begin(PE32Opcode.pe32_rffe_elrd, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(bcnt)).ReadInt32();
+    }
+
+    public void pe32_rffe_cmdwr(int bdn, int port, int sadd, int cmd, int add, int data, int bcnt)
+    {
+        Send(Begin(PE32Opcode.pe32_rffe_cmdwr, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(cmd).WriteInt32(add).WriteInt32(data).WriteInt32(bcnt));
+    }
+
+    public void pe32_rffe_cmdrd(int bdn, int port, int sadd, int cmd, int add, int data, int bcnt)
+    {
+        Send(Begin(PE32Opcode.pe32_rffe_cmdrd, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(cmd).WriteInt32(add).WriteInt32(data).WriteInt32(bcnt));
+    }
+
+    public void pe32_set_qmode(int bdn, int onoff)
+    {
+        Send(Begin(PE32Opcode.pe32_set_qmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public int pe32_check_qfail(int bdn, int cno)
+    {
+        return Call(Begin(PE32Opcode.pe32_check_qfail, bdn).WriteInt32(bdn).WriteInt32(cno)).ReadInt32();
+    }
+
+    public void pe32_set_rodvhdvl(int bdn, int pno, int rodvh, int rodvl)
+    {
+        Send(Begin(PE32Opcode.pe32_set_rodvhdvl, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rodvh).WriteInt32(rodvl));
+    }
+
+    public int pe32_rd_PciRevId(int bdn)
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_rd_PciRevId, bdn, out int cached, out long version))
+            return cached;
+        var result = Call(Begin(PE32Opcode.pe32_rd_PciRevId, bdn).WriteInt32(bdn)).ReadInt32();
+        queryCache.Store(PE32Opcode.pe32_rd_PciRevId, bdn, result, version);
+        return result;
+    }
+
+    public int pe32_rd_PciDevId(int bdn)
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_rd_PciDevId, bdn, out int cached, out long version))
+            return cached;
+        var result = Call(Begin(PE32Opcode.pe32_rd_PciDevId, bdn).WriteInt32(bdn)).ReadInt32();
+        queryCache.Store(PE32Opcode.pe32_rd_PciDevId, bdn, result, version);
+        return result;
+    }
+
+    public int pe32_rd_PciSubId(int bdn)
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_rd_PciSubId, bdn, out int cached, out long version))
+            return cached;
+        var result = Call(Begin(PE32Opcode.pe32_rd_PciSubId, bdn).WriteInt32(bdn)).ReadInt32();
+        queryCache.Store(PE32Opcode.pe32_rd_PciSubId, bdn, result, version);
+        return result;
+    }
+
+    public void pe32_trig_mv(int bdn, int pno, int pxitrg)
+    {
+        Send(Begin(PE32Opcode.pe32_trig_mv, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(pxitrg));
+    }
+
+    public void pe32_trig_mi(int bdn, int pno, int pxitrg)
+    {
+        Send(Begin(PE32Opcode.pe32_trig_mi, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(pxitrg));
+    }
+
+    public double pe32_trig_imeas(int bdn, int pno)
+    {
+        return Call(Begin(PE32Opcode.pe32_trig_imeas, bdn).WriteInt32(bdn).WriteInt32(pno)).ReadDouble();
+    }
+
+    public double pe32_trig_vmeas(int bdn, int pno)
+    {
+        return Call(Begin(PE32Opcode.pe32_trig_vmeas, bdn).WriteInt32(bdn).WriteInt32(pno)).ReadDouble();
+    }
+
+    public void pe32_user_fram_save(int bdn, int add, string data, int size)
+    {
+        Send(Begin(PE32Opcode.pe32_user_fram_save, bdn).WriteInt32(bdn).WriteInt32(add).WriteString(data).WriteInt32(size));
+    }
+
+    public int pe32_user_fram_load(int bdn, int add, int size, Span<byte> data)
+    {
+        var response = Call(Begin(PE32Opcode.pe32_user_fram_load, bdn).WriteInt32(bdn).WriteInt32(add).WriteInt32(size));
+        var result = response.ReadInt32();
+        response.ReadBytes(data);
+        return result;
+    }
+
+    public ReadOnlySpan<byte> pe32_bulk_dump_getalog(int bdn, int addr, int count)
+    {
+        return Call(Begin(PE32Opcode.pe32_bulk_dump_getalog, bdn).WriteInt32(bdn).WriteInt32(addr).WriteInt32(count)).ReadBulk();
+    }
+
+    public ReadOnlySpan<byte> pe32_bulk_dump_getclog(int bdn, int addr, int count)
+    {
+        return Call(Begin(PE32Opcode.pe32_bulk_dump_getclog, bdn).WriteInt32(bdn).WriteInt32(addr).WriteInt32(count)).ReadBulk();
+    }
+
+    public ReadOnlySpan<byte> pe32_bulk_srd_getword(int bdn, int count)
+    {
+        return Call(Begin(PE32Opcode.pe32_bulk_srd_getword, bdn).WriteInt32(bdn).WriteInt32(count)).ReadBulk();
+    }
+
+    public ReadOnlySpan<byte> pe32_bulk_dump_getalogclog(int bdn, int begin, int end)
+    {
+        return Call(Begin(PE32Opcode.pe32_bulk_dump_getalogclog, bdn).WriteInt32(bdn).WriteInt32(begin).WriteInt32(end)).ReadBulk();
+    }
+
+    public ReadOnlySpan<byte> pe32_bulk_srd_rdblock32(int bdn, int begin, int end)
+    {
+        return Call(Begin(PE32Opcode.pe32_bulk_srd_rdblock32, bdn).WriteInt32(bdn).WriteInt32(begin).WriteInt32(end)).ReadBulk();
+    }
+
+    public ReadOnlySpan<byte> pe32_bulk_rd_lm(int begin, int end)
+    {
+        return Call(Begin(PE32Opcode.pe32_bulk_rd_lm).WriteInt32(begin).WriteInt32(end)).ReadBulk();
+    }
+
+    public void ipc_nop(int bdn)
+    {
+        Send(Begin(PE32Opcode.ipc_nop, bdn).WriteInt32(bdn));
+    }
+
+    public int ipc_echo(int bdn, int value)
+    {
+        return Call(Begin(PE32Opcode.ipc_echo, bdn).WriteInt32(bdn).WriteInt32(value)).ReadInt32();
+    }
+
+    public int ipc_echo_bytes(int bdn, int size, Span<byte> data)
+    {
+        var response = Call(Begin(PE32Opcode.ipc_echo_bytes, bdn).WriteInt32(bdn).WriteInt32(size));
+        var result = response.ReadInt32();
+        response.ReadBytes(data);
+        return result;
+    }
+
+    public ReadOnlySpan<byte> ipc_echo_bulk(int bdn, int size)
+    {
+        return Call(Begin(PE32Opcode.ipc_echo_bulk, bdn).WriteInt32(bdn).WriteInt32(size)).ReadBulk();
+    }
+
+    public int pe32_pattern_store(int hashlo, int hashhi, int offset, int total, ReadOnlySpan<byte> chunk)
+    {
+        return Call(Begin(PE32Opcode.pe32_pattern_store).WriteInt32(hashlo).WriteInt32(hashhi).WriteInt32(offset).WriteInt32(total).WriteBulk(chunk.Length), chunk).ReadInt32();
+    }
+
+    public int pe32_pattern_lmload(int begbdno, int boardwidth, int begadd, int hashlo, int hashhi)
+    {
+        return Call(Begin(PE32Opcode.pe32_pattern_lmload).WriteInt32(begbdno).WriteInt32(boardwidth).WriteInt32(begadd).WriteInt32(hashlo).WriteInt32(hashhi)).ReadInt32();
+    }
+}
+
+// Awaitable variants, any number of threads may have them outstanding.
+// One poller thread per proxy completes them, see PE32Proxy.CallAsync().
+public partial class PE32Proxy
+{
+    public ValueTask<int> pe32_usb_async()
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_usb), static response => response.ReadInt32());
+    }
+
+    public ValueTask<(int Result, int Buffer)> pe32_readl_async(int bdn, int offset)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_readl, bdn).WriteInt32(bdn).WriteInt32(offset), static response => (response.ReadInt32(), response.ReadInt32()));
+    }
+
+    public ValueTask pe32_writel_async(int bdn, int offset, int buf)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_writel, bdn).WriteInt32(bdn).WriteInt32(offset).WriteInt32(buf));
+    }
+
+    public ValueTask pe32_set_sctl_async(int bdn, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_sctl, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public ValueTask pe32_set_sdata_async(int bdn, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_sdata, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public ValueTask<int> pe32_rd_sio_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_sio, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_wr_pe_async(int bdn, int chip, int port, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_wr_pe, bdn).WriteInt32(bdn).WriteInt32(chip).WriteInt32(port).WriteInt32(data));
+    }
+
+    public ValueTask<int> pe32_rd_pe_async(int bdn, int chip, int port)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_pe, bdn).WriteInt32(bdn).WriteInt32(chip).WriteInt32(port), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_rst_pe_async(int bdn)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_rst_pe, bdn).WriteInt32(bdn));
+    }
+
+    public ValueTask pe32_usleep_async(int usec)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_usleep).WriteInt32(usec));
+    }
+
+    public ValueTask<int> pe32_api_async()
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_api, 0, out int cached, out _))
+            return new ValueTask<int>(cached);
+        return CallAsync(Begin(PE32Opcode.pe32_api), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_fdiag_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_fdiag, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_fstart_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_fstart, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_diag_fstart_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_diag_fstart, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_cycle_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_cycle, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask<int> pe32_check_reset_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_reset, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_check_fstart_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_fstart, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_check_cycle_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_cycle, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_check_tprun_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_tprun, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_check_sync_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_sync, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_check_testbeg_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_testbeg, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_check_tpass_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_tpass, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_check_ftend_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_ftend, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_check_lend_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_lend, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_set_pxi_async(int bdn, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_pxi, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public ValueTask pe32_pxi_fstart_async(int bdn, int ch, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_pxi_fstart, bdn).WriteInt32(bdn).WriteInt32(ch).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_pxi_cfail_async(int bdn, int ch, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_pxi_cfail, bdn).WriteInt32(bdn).WriteInt32(ch).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_pxi_lmsyn_async(int bdn, int ch, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_pxi_lmsyn, bdn).WriteInt32(bdn).WriteInt32(ch).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_set_addbeg_async(int bdn, int add)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_addbeg, bdn).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public ValueTask pe32_set_addend_async(int bdn, int cnt)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_addend, bdn).WriteInt32(bdn).WriteInt32(cnt));
+    }
+
+    public ValueTask pe32_set_ftcnt_async(int bdn, int cnt)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_ftcnt, bdn).WriteInt32(bdn).WriteInt32(cnt));
+    }
+
+    public ValueTask pe32_set_addsyn_async(int bdn, int add)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_addsyn, bdn).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public ValueTask pe32_set_addif_async(int bdn, int add)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_addif, bdn).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public ValueTask pe32_set_logadd_async(int bdn, int add)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_logadd, bdn).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public ValueTask pe32_set_seq_async(int bdn, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_seq, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public ValueTask pe32_set_lmf_async(int bdn, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_lmf, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public ValueTask pe32_set_mmsk_async(int bdn, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_mmsk, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public ValueTask pe32_set_tp_async(int bdn, int ts, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_tp, bdn).WriteInt32(bdn).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public ValueTask pe32_set_tstrob_async(int bdn, int pno, int ts, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_tstrob, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public ValueTask pe32_set_tstart_async(int bdn, int pno, int ts, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_tstart, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public ValueTask pe32_set_tstop_async(int bdn, int pno, int ts, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_tstop, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public ValueTask pe32_set_rz_async(int bdn, int fs, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_rz, bdn).WriteInt32(bdn).WriteInt32(fs).WriteInt32(data));
+    }
+
+    public ValueTask pe32_set_ro_async(int bdn, int ts, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_ro, bdn).WriteInt32(bdn).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public ValueTask pe32_set_io_async(int bdn, int ts, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_io, bdn).WriteInt32(bdn).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public ValueTask pe32_set_mk_async(int bdn, int ts, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_mk, bdn).WriteInt32(bdn).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public ValueTask pe32_set_dstrob_async(int bdn, int pno, int ts, int data1, int data2)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_dstrob, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(ts).WriteInt32(data1).WriteInt32(data2));
+    }
+
+    public ValueTask pe32_rd_actseq_async(int bdn)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_rd_actseq, bdn).WriteInt32(bdn));
+    }
+
+    public ValueTask<int> pe32_rd_actlmf_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_actlmf, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_actlmd_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_actlmd, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_actlmm_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_actlmm, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_actlmadd_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_actlmadd, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_pxibus_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_pxibus, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_id_async(int bdn)
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_rd_id, bdn, out int cached, out _))
+            return new ValueTask<int>(cached);
+        return CallAsync(Begin(PE32Opcode.pe32_rd_id, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_vc_async(int bdn)
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_rd_vc, bdn, out int cached, out _))
+            return new ValueTask<int>(cached);
+        return CallAsync(Begin(PE32Opcode.pe32_rd_vc, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_seq_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_seq, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_lmf_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_lmf, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_lmd_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_lmd, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_lmm_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_lmm, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_lmadd_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_lmadd, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_lmload_async(int begbdno, int boardwidth, int begadd, string patternfile)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_lmload).WriteInt32(begbdno).WriteInt32(boardwidth).WriteInt32(begadd).WriteString(patternfile), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_lmsave_async(int begbdno, int boardwidth, int begadd, int endadd, string patternfile)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_lmsave).WriteInt32(begbdno).WriteInt32(boardwidth).WriteInt32(begadd).WriteInt32(endadd).WriteString(patternfile), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_cmph_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_cmph, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_cmpl_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_cmpl, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_creg_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_creg, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<uint> pe32_rd_ftcnt_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_ftcnt, bdn).WriteInt32(bdn), static response => response.ReadUInt32());
+    }
+
+    public ValueTask<uint> pe32_rd_fccnt_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_fccnt, bdn).WriteInt32(bdn), static response => response.ReadUInt32());
+    }
+
+    public ValueTask<uint> pe32_rd_flcnt_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_flcnt, bdn).WriteInt32(bdn), static response => response.ReadUInt32());
+    }
+
+    public ValueTask<int> pe32_rd_clog_async(int bdn, int addr)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_clog, bdn).WriteInt32(bdn).WriteInt32(addr), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_alog_async(int bdn, int addr)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_alog, bdn).WriteInt32(bdn).WriteInt32(addr), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_logadd_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_logadd, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<(int Result, int Alog, int Clog)> pe32_rd_alogclog_async(int bdn, int addr)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_alogclog, bdn).WriteInt32(bdn).WriteInt32(addr), static response => (response.ReadInt32(), response.ReadInt32(), response.ReadInt32()));
+    }
+
+    public ValueTask<(int Result, int Alog, int Clog)> pe32_dump_alogclog_async(int bdn, int ksize)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_dump_alogclog, bdn).WriteInt32(bdn).WriteInt32(ksize), static response => (response.ReadInt32(), response.ReadInt32(), response.ReadInt32()));
+    }
+
+    public ValueTask pe32_set_dumpmode_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_dumpmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask<int> pe32_dump_getclog_async(int bdn, int addr)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_dump_getclog, bdn).WriteInt32(bdn).WriteInt32(addr), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_dump_getalog_async(int bdn, int addr)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_dump_getalog, bdn).WriteInt32(bdn).WriteInt32(addr), static response => response.ReadInt32());
+    }
+
+    public ValueTask<(int Result, int Alog, int Clog)> pe32_dump_getalogclog_async(int bdn, int add)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_dump_getalogclog, bdn).WriteInt32(bdn).WriteInt32(add), static response => (response.ReadInt32(), response.ReadInt32(), response.ReadInt32()));
+    }
+
+    public ValueTask<int> pe32_check_dataready_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_dataready, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_check_checkmode_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_checkmode, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_check_logmode_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_logmode, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_check_trigmode_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_trigmode, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_check_dualmode_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_dualmode, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_set_trigmode_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_trigmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_set_logmode_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_logmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask<int> pe32_check_ucnt_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_ucnt, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_set_checkmode_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_checkmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_set_vih_async(int bdn, int pno, double rv)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_vih, bdn).WriteInt32(bdn).WriteInt32(pno).WriteDouble(rv));
+    }
+
+    public ValueTask pe32_set_vil_async(int bdn, int pno, double rv)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_vil, bdn).WriteInt32(bdn).WriteInt32(pno).WriteDouble(rv));
+    }
+
+    public ValueTask pe32_set_voh_async(int bdn, int pno, double rv)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_voh, bdn).WriteInt32(bdn).WriteInt32(pno).WriteDouble(rv));
+    }
+
+    public ValueTask pe32_set_vol_async(int bdn, int pno, double rv)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_vol, bdn).WriteInt32(bdn).WriteInt32(pno).WriteDouble(rv));
+    }
+
+    public ValueTask pe32_set_driver_async(int bdn, int pno, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_driver, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_cpu_df_async(int bdn, int pno, int donoff, int fonoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_cpu_df, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(donoff).WriteInt32(fonoff));
+    }
+
+    public ValueTask pe32_pmufv_async(int bdn, int chip, double rv, double clamp)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_pmufv, bdn).WriteInt32(bdn).WriteInt32(chip).WriteDouble(rv).WriteDouble(clamp));
+    }
+
+    public ValueTask pe32_pmufi_async(int bdn, int chip, double ri, double cvh, double cvl)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_pmufi, bdn).WriteInt32(bdn).WriteInt32(chip).WriteDouble(ri).WriteDouble(cvh).WriteDouble(cvl));
+    }
+
+    public ValueTask pe32_pmufir_async(int bdn, int chip, double ri, double cvh, double cvl, int rang)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_pmufir, bdn).WriteInt32(bdn).WriteInt32(chip).WriteDouble(ri).WriteDouble(cvh).WriteDouble(cvl).WriteInt32(rang));
+    }
+
+    public ValueTask<double> pe32_vmeas_async(int bdn, int pno)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_vmeas, bdn).WriteInt32(bdn).WriteInt32(pno), static response => response.ReadDouble());
+    }
+
+    public ValueTask<double> pe32_imeas_async(int bdn, int pno)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_imeas, bdn).WriteInt32(bdn).WriteInt32(pno), static response => response.ReadDouble());
+    }
+
+    public ValueTask pe32_pmucv_async(int bdn, int chip, double cvh, double cvl)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_pmucv, bdn).WriteInt32(bdn).WriteInt32(chip).WriteDouble(cvh).WriteDouble(cvl));
+    }
+
+    public ValueTask pe32_pmuci_async(int bdn, int chip, double cih, double cil)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_pmuci, bdn).WriteInt32(bdn).WriteInt32(chip).WriteDouble(cih).WriteDouble(cil));
+    }
+
+    public ValueTask pe32_con_pmu_async(int bdn, int pno, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_con_pmu, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_con_pmus_async(int bdn, int pno, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_con_pmus, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_con_receiver_async(int bdn, int pno, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_con_receiver, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public ValueTask<int> pe32_check_pmu_async(int bdn, int chip)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_pmu, bdn).WriteInt32(bdn).WriteInt32(chip), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_pmuch_async(int bdn, int chip)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_pmuch, bdn).WriteInt32(bdn).WriteInt32(chip), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_pmucl_async(int bdn, int chip)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_pmucl, bdn).WriteInt32(bdn).WriteInt32(chip), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_cal_load_async(int bdn, string calfile)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_cal_load, bdn).WriteInt32(bdn).WriteString(calfile), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_cal_save_async(int bdn, string calfile)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_cal_save, bdn).WriteInt32(bdn).WriteString(calfile), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_cal_load_auto_async(int bdn, string calfile)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_cal_load_auto, bdn).WriteInt32(bdn).WriteString(calfile), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_cal_save_auto_async(int bdn, string calfile)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_cal_save_auto, bdn).WriteInt32(bdn).WriteString(calfile), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_cal_reset_async(int bdn)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_cal_reset, bdn).WriteInt32(bdn));
+    }
+
+    public ValueTask pe32_con_esense_async(int bdn, int pno, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_con_esense, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_con_eforce_async(int bdn, int pno, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_con_eforce, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_con_ext_async(int bdn, int pno, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_con_ext, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_set_deskew_async(int bdn, int pno, int rt)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_deskew, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rt));
+    }
+
+    public ValueTask pe32_set_fallingskew_async(int bdn, int pno, int rt)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_fallingskew, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rt));
+    }
+
+    public ValueTask pe32_set_rcvskew_async(int bdn, int pno, int rt)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_rcvskew, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rt));
+    }
+
+    public ValueTask pe32_set_rcvfallingskew_async(int bdn, int pno, int rt)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_rcvfallingskew, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rt));
+    }
+
+    public ValueTask<int> pe32_getch_async(int bdn, int pno)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_getch, bdn).WriteInt32(bdn).WriteInt32(pno), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_getcl_async(int bdn, int pno)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_getcl, bdn).WriteInt32(bdn).WriteInt32(pno), static response => response.ReadInt32());
+    }
+
+    public ValueTask pemu32_rst_pe_async(int bdn)
+    {
+        return SendAsync(Begin(PE32Opcode.pemu32_rst_pe, bdn).WriteInt32(bdn));
+    }
+
+    public ValueTask pemu32_set_driver_async(int bdn, int pno, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pemu32_set_driver, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_counter_ctp_async(int bdn, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_counter_ctp, bdn).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public ValueTask pe32_counter_start_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_counter_start, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_counter_select_ch_async(int bdn, int ch)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_counter_select_ch, bdn).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public ValueTask<int> pe32_counter_rd_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_counter_rd, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<double> pe32_counter_rdfrq_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_counter_rdfrq, bdn).WriteInt32(bdn), static response => response.ReadDouble());
+    }
+
+    public ValueTask pe32_counter_tmmode_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_counter_tmmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_tmu_cstart_inv_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_tmu_cstart_inv, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_tmu_cstop_inv_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_tmu_cstop_inv, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_tmu_select_cstart_async(int bdn, int ch)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_tmu_select_cstart, bdn).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public ValueTask pe32_tmu_select_cstop_async(int bdn, int ch)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_tmu_select_cstop, bdn).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public ValueTask<int> pe32_rd_pesno_async(int bdn)
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_rd_pesno, bdn, out int cached, out _))
+            return new ValueTask<int>(cached);
+        return CallAsync(Begin(PE32Opcode.pe32_rd_pesno, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<double> pe32_get_temp_async(int bdn, int cno)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_get_temp, bdn).WriteInt32(bdn).WriteInt32(cno), static response => response.ReadDouble());
+    }
+
+    public ValueTask pe32_set_srdmode_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_srdmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_srd_select_ch_async(int bdn, int ch)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_srd_select_ch, bdn).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public ValueTask<int> pe32_srd_getword_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_srd_getword, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_srd_getword2_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_srd_getword2, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_srd_getsrword_async(int bdn, int ch)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_srd_getsrword, bdn).WriteInt32(bdn).WriteInt32(ch), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_srd_rdblock32_async(int bdn, int add)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_srd_rdblock32, bdn).WriteInt32(bdn).WriteInt32(add), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_setReg_async(int bdn, int pno, int dacno, int rv)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_setReg, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(dacno).WriteInt32(rv));
+    }
+
+    public ValueTask pe32_dc_range_async(int bdn, int range)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_dc_range, bdn).WriteInt32(bdn).WriteInt32(range));
+    }
+
+    public ValueTask pe32_set_lmsyn_active_high_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_lmsyn_active_high, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_set_lmsyn_ch_async(int bdn, int ch)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_lmsyn_ch, bdn).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public ValueTask<int> pe32_rd_logcnt_async(int bdn)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rd_logcnt, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_reset_lmiomk_async(int bdn)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_reset_lmiomk, bdn).WriteInt32(bdn));
+    }
+
+    public ValueTask pe32_con_2k2vtt_async(int bdn, int pno, int onoff, double vtt)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_con_2k2vtt, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff).WriteDouble(vtt));
+    }
+
+    public ValueTask<string> pe32_get_msg_async()
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_get_msg), static response => response.ReadString());
+    }
+
+    public ValueTask pe32_set_rffemode_async(int bdn, int port, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_rffemode, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(onoff));
+    }
+
+    public ValueTask pe32_rffe_ftp_async(int bdn, int wtp, int rtp)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_rffe_ftp, bdn).WriteInt32(bdn).WriteInt32(wtp).WriteInt32(rtp));
+    }
+
+    public ValueTask pe32_rffe_pclk_async(int bdn, int pclk)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_rffe_pclk, bdn).WriteInt32(bdn).WriteInt32(pclk));
+    }
+
+    public ValueTask pe32_rffe_wr_async(int bdn, int port, int sadd, int add, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_rffe_wr, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(data));
+    }
+
+    public ValueTask<int> pe32_rffe_rd_async(int bdn, int port, int sadd, int add)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rffe_rd, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_rffe_ewr_async(int bdn, int port, int sadd, int add, int data, int bcnt)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_rffe_ewr, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(data).WriteInt32(bcnt));
+    }
+
+    public ValueTask<int> pe32_rffe_erd_async(int bdn, int port, int sadd, int add, int bcnt)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rffe_erd, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(bcnt), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rffe_getword_async(int bdn, int port)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rffe_getword, bdn).WriteInt32(bdn).WriteInt32(port), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_rffe_wr0_async(int bdn, int port, int sadd, int data)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_rffe_wr0, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(data));
+    }
+
+    public ValueTask pe32_rffe_elwr_async(int bdn, int port, int sadd, int add, int data, int bcnt)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_rffe_elwr, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(data).WriteInt32(bcnt));
+    }
+
+    public ValueTask<int> pe32_rffe_elrd_async(int bdn, int port, int sadd, int add, int bcnt)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_rffe_elrd, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(bcnt), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_rffe_cmdwr_async(int bdn, int port, int sadd, int cmd, int add, int data, int bcnt)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_rffe_cmdwr, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(cmd).WriteInt32(add).WriteInt32(data).WriteInt32(bcnt));
+    }
+
+    public ValueTask pe32_rffe_cmdrd_async(int bdn, int port, int sadd, int cmd, int add, int data, int bcnt)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_rffe_cmdrd, bdn).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(cmd).WriteInt32(add).WriteInt32(data).WriteInt32(bcnt));
+    }
+
+    public ValueTask pe32_set_qmode_async(int bdn, int onoff)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_qmode, bdn).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public ValueTask<int> pe32_check_qfail_async(int bdn, int cno)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_check_qfail, bdn).WriteInt32(bdn).WriteInt32(cno), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_set_rodvhdvl_async(int bdn, int pno, int rodvh, int rodvl)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_set_rodvhdvl, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rodvh).WriteInt32(rodvl));
+    }
+
+    public ValueTask<int> pe32_rd_PciRevId_async(int bdn)
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_rd_PciRevId, bdn, out int cached, out _))
+            return new ValueTask<int>(cached);
+        return CallAsync(Begin(PE32Opcode.pe32_rd_PciRevId, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_PciDevId_async(int bdn)
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_rd_PciDevId, bdn, out int cached, out _))
+            return new ValueTask<int>(cached);
+        return CallAsync(Begin(PE32Opcode.pe32_rd_PciDevId, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_rd_PciSubId_async(int bdn)
+    {
+        if (queryCache.TryGet(PE32Opcode.pe32_rd_PciSubId, bdn, out int cached, out _))
+            return new ValueTask<int>(cached);
+        return CallAsync(Begin(PE32Opcode.pe32_rd_PciSubId, bdn).WriteInt32(bdn), static response => response.ReadInt32());
+    }
+
+    public ValueTask pe32_trig_mv_async(int bdn, int pno, int pxitrg)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_trig_mv, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(pxitrg));
+    }
+
+    public ValueTask pe32_trig_mi_async(int bdn, int pno, int pxitrg)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_trig_mi, bdn).WriteInt32(bdn).WriteInt32(pno).WriteInt32(pxitrg));
+    }
+
+    public ValueTask<double> pe32_trig_imeas_async(int bdn, int pno)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_trig_imeas, bdn).WriteInt32(bdn).WriteInt32(pno), static response => response.ReadDouble());
+    }
+
+    public ValueTask<double> pe32_trig_vmeas_async(int bdn, int pno)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_trig_vmeas, bdn).WriteInt32(bdn).WriteInt32(pno), static response => response.ReadDouble());
+    }
+
+    public ValueTask pe32_user_fram_save_async(int bdn, int add, string data, int size)
+    {
+        return SendAsync(Begin(PE32Opcode.pe32_user_fram_save, bdn).WriteInt32(bdn).WriteInt32(add).WriteString(data).WriteInt32(size));
+    }
+
+    public ValueTask ipc_nop_async(int bdn)
+    {
+        return SendAsync(Begin(PE32Opcode.ipc_nop, bdn).WriteInt32(bdn));
+    }
+
+    public ValueTask<int> ipc_echo_async(int bdn, int value)
+    {
+        return CallAsync(Begin(PE32Opcode.ipc_echo, bdn).WriteInt32(bdn).WriteInt32(value), static response => response.ReadInt32());
+    }
+
+    public ValueTask<int> pe32_pattern_lmload_async(int begbdno, int boardwidth, int begadd, int hashlo, int hashhi)
+    {
+        return CallAsync(Begin(PE32Opcode.pe32_pattern_lmload).WriteInt32(begbdno).WriteInt32(boardwidth).WriteInt32(begadd).WriteInt32(hashlo).WriteInt32(hashhi), static response => response.ReadInt32());
+    }
+}
+
+// The same calls queued into a batch, see PE32Proxy.BeginBatch().
+// Return and out-values are read back through PE32BatchResults.GetValues().
+// Bulk commands and bulk inputs are not batchable.
+public sealed partial class PE32Batch
+{
+    public PE32Batch pe32_init()
+    {
+        invalidatesQueryCache = true;
+        return Add(Begin(PE32Opcode.pe32_init));
+    }
+
+    public PE32Batch pe32_usb()
+    {
+        return Add(Begin(PE32Opcode.pe32_usb));
+    }
+
+    public PE32Batch pe32_readl(int bdn, int offset)
+    {
+        return Add(Begin(PE32Opcode.pe32_readl).WriteInt32(bdn).WriteInt32(offset));
+    }
+
+    public PE32Batch pe32_writel(int bdn, int offset, int buf)
+    {
+        return Add(Begin(PE32Opcode.pe32_writel).WriteInt32(bdn).WriteInt32(offset).WriteInt32(buf));
+    }
+
+    public PE32Batch pe32_set_sctl(int bdn, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_sctl).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_set_sdata(int bdn, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_sdata).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_rd_sio(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_sio).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_wr_pe(int bdn, int chip, int port, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_wr_pe).WriteInt32(bdn).WriteInt32(chip).WriteInt32(port).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_rd_pe(int bdn, int chip, int port)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_pe).WriteInt32(bdn).WriteInt32(chip).WriteInt32(port));
+    }
+
+    public PE32Batch pe32_rst_pe(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rst_pe).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_usleep(int usec)
+    {
+        return Add(Begin(PE32Opcode.pe32_usleep).WriteInt32(usec));
+    }
+
+    public PE32Batch pe32_api()
+    {
+        return Add(Begin(PE32Opcode.pe32_api));
+    }
+
+    public PE32Batch pe32_reset(int bdn)
+    {
+        invalidatesQueryCache = true;
+        return Add(Begin(PE32Opcode.pe32_reset).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_fdiag(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_fdiag).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_fstart(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_fstart).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_diag_fstart(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_diag_fstart).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_cycle(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_cycle).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_check_reset(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_reset).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_check_fstart(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_fstart).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_check_cycle(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_cycle).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_check_tprun(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_tprun).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_check_sync(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_sync).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_check_testbeg(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_testbeg).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_check_tpass(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_tpass).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_check_ftend(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_ftend).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_check_lend(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_lend).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_set_pxi(int bdn, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_pxi).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_pxi_fstart(int bdn, int ch, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_pxi_fstart).WriteInt32(bdn).WriteInt32(ch).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_pxi_cfail(int bdn, int ch, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_pxi_cfail).WriteInt32(bdn).WriteInt32(ch).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_pxi_lmsyn(int bdn, int ch, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_pxi_lmsyn).WriteInt32(bdn).WriteInt32(ch).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_set_addbeg(int bdn, int add)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_addbeg).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public PE32Batch pe32_set_addend(int bdn, int cnt)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_addend).WriteInt32(bdn).WriteInt32(cnt));
+    }
+
+    public PE32Batch pe32_set_ftcnt(int bdn, int cnt)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_ftcnt).WriteInt32(bdn).WriteInt32(cnt));
+    }
+
+    public PE32Batch pe32_set_addsyn(int bdn, int add)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_addsyn).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public PE32Batch pe32_set_addif(int bdn, int add)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_addif).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public PE32Batch pe32_set_logadd(int bdn, int add)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_logadd).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public PE32Batch pe32_set_seq(int bdn, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_seq).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_set_lmf(int bdn, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_lmf).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_set_mmsk(int bdn, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_mmsk).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_set_tp(int bdn, int ts, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_tp).WriteInt32(bdn).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_set_tstrob(int bdn, int pno, int ts, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_tstrob).WriteInt32(bdn).WriteInt32(pno).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_set_tstart(int bdn, int pno, int ts, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_tstart).WriteInt32(bdn).WriteInt32(pno).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_set_tstop(int bdn, int pno, int ts, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_tstop).WriteInt32(bdn).WriteInt32(pno).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_set_rz(int bdn, int fs, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_rz).WriteInt32(bdn).WriteInt32(fs).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_set_ro(int bdn, int ts, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_ro).WriteInt32(bdn).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_set_io(int bdn, int ts, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_io).WriteInt32(bdn).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_set_mk(int bdn, int ts, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_mk).WriteInt32(bdn).WriteInt32(ts).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_set_dstrob(int bdn, int pno, int ts, int data1, int data2)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_dstrob).WriteInt32(bdn).WriteInt32(pno).WriteInt32(ts).WriteInt32(data1).WriteInt32(data2));
+    }
+
+    public PE32Batch pe32_rd_actseq(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_actseq).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_actlmf(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_actlmf).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_actlmd(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_actlmd).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_actlmm(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_actlmm).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_actlmadd(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_actlmadd).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_pxibus(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_pxibus).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_id(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_id).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_vc(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_vc).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_seq(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_seq).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_lmf(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_lmf).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_lmd(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_lmd).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_lmm(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_lmm).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_lmadd(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_lmadd).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_lmload(int begbdno, int boardwidth, int begadd, string patternfile)
+    {
+        return Add(Begin(PE32Opcode.pe32_lmload).WriteInt32(begbdno).WriteInt32(boardwidth).WriteInt32(begadd).WriteString(patternfile));
+    }
+
+    public PE32Batch pe32_lmsave(int begbdno, int boardwidth, int begadd, int endadd, string patternfile)
+    {
+        return Add(Begin(PE32Opcode.pe32_lmsave).WriteInt32(begbdno).WriteInt32(boardwidth).WriteInt32(begadd).WriteInt32(endadd).WriteString(patternfile));
+    }
+
+    public PE32Batch pe32_rd_cmph(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_cmph).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_cmpl(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_cmpl).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_creg(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_creg).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_ftcnt(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_ftcnt).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_fccnt(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_fccnt).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_flcnt(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_flcnt).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_clog(int bdn, int addr)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_clog).WriteInt32(bdn).WriteInt32(addr));
+    }
+
+    public PE32Batch pe32_rd_alog(int bdn, int addr)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_alog).WriteInt32(bdn).WriteInt32(addr));
+    }
+
+    public PE32Batch pe32_rd_logadd(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_logadd).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_alogclog(int bdn, int addr)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_alogclog).WriteInt32(bdn).WriteInt32(addr));
+    }
+
+    public PE32Batch pe32_dump_alogclog(int bdn, int ksize)
+    {
+        return Add(Begin(PE32Opcode.pe32_dump_alogclog).WriteInt32(bdn).WriteInt32(ksize));
+    }
+
+    public PE32Batch pe32_set_dumpmode(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_dumpmode).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_dump_getclog(int bdn, int addr)
+    {
+        return Add(Begin(PE32Opcode.pe32_dump_getclog).WriteInt32(bdn).WriteInt32(addr));
+    }
+
+    public PE32Batch pe32_dump_getalog(int bdn, int addr)
+    {
+        return Add(Begin(PE32Opcode.pe32_dump_getalog).WriteInt32(bdn).WriteInt32(addr));
+    }
+
+    public PE32Batch pe32_dump_getalogclog(int bdn, int add)
+    {
+        return Add(Begin(PE32Opcode.pe32_dump_getalogclog).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public PE32Batch pe32_check_dataready(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_dataready).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_check_checkmode(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_checkmode).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_check_logmode(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_logmode).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_check_trigmode(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_trigmode).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_check_dualmode(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_dualmode).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_set_trigmode(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_trigmode).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_set_logmode(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_logmode).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_check_ucnt(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_ucnt).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_set_checkmode(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_checkmode).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_set_vih(int bdn, int pno, double rv)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_vih).WriteInt32(bdn).WriteInt32(pno).WriteDouble(rv));
+    }
+
+    public PE32Batch pe32_set_vil(int bdn, int pno, double rv)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_vil).WriteInt32(bdn).WriteInt32(pno).WriteDouble(rv));
+    }
+
+    public PE32Batch pe32_set_voh(int bdn, int pno, double rv)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_voh).WriteInt32(bdn).WriteInt32(pno).WriteDouble(rv));
+    }
+
+    public PE32Batch pe32_set_vol(int bdn, int pno, double rv)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_vol).WriteInt32(bdn).WriteInt32(pno).WriteDouble(rv));
+    }
+
+    public PE32Batch pe32_set_driver(int bdn, int pno, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_driver).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_cpu_df(int bdn, int pno, int donoff, int fonoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_cpu_df).WriteInt32(bdn).WriteInt32(pno).WriteInt32(donoff).WriteInt32(fonoff));
+    }
+
+    public PE32Batch pe32_pmufv(int bdn, int chip, double rv, double clamp)
+    {
+        return Add(Begin(PE32Opcode.pe32_pmufv).WriteInt32(bdn).WriteInt32(chip).WriteDouble(rv).WriteDouble(clamp));
+    }
+
+    public PE32Batch pe32_pmufi(int bdn, int chip, double ri, double cvh, double cvl)
+    {
+        return Add(Begin(PE32Opcode.pe32_pmufi).WriteInt32(bdn).WriteInt32(chip).WriteDouble(ri).WriteDouble(cvh).WriteDouble(cvl));
+    }
+
+    public PE32Batch pe32_pmufir(int bdn, int chip, double ri, double cvh, double cvl, int rang)
+    {
+        return Add(Begin(PE32Opcode.pe32_pmufir).WriteInt32(bdn).WriteInt32(chip).WriteDouble(ri).WriteDouble(cvh).WriteDouble(cvl).WriteInt32(rang));
+    }
+
+    public PE32Batch pe32_vmeas(int bdn, int pno)
+    {
+        return Add(Begin(PE32Opcode.pe32_vmeas).WriteInt32(bdn).WriteInt32(pno));
+    }
+
+    public PE32Batch pe32_imeas(int bdn, int pno)
+    {
+        return Add(Begin(PE32Opcode.pe32_imeas).WriteInt32(bdn).WriteInt32(pno));
+    }
+
+    public PE32Batch pe32_pmucv(int bdn, int chip, double cvh, double cvl)
+    {
+        return Add(Begin(PE32Opcode.pe32_pmucv).WriteInt32(bdn).WriteInt32(chip).WriteDouble(cvh).WriteDouble(cvl));
+    }
+
+    public PE32Batch pe32_pmuci(int bdn, int chip, double cih, double cil)
+    {
+        return Add(Begin(PE32Opcode.pe32_pmuci).WriteInt32(bdn).WriteInt32(chip).WriteDouble(cih).WriteDouble(cil));
+    }
+
+    public PE32Batch pe32_con_pmu(int bdn, int pno, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_con_pmu).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_con_pmus(int bdn, int pno, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_con_pmus).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_con_receiver(int bdn, int pno, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_con_receiver).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_check_pmu(int bdn, int chip)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_pmu).WriteInt32(bdn).WriteInt32(chip));
+    }
+
+    public PE32Batch pe32_pmuch(int bdn, int chip)
+    {
+        return Add(Begin(PE32Opcode.pe32_pmuch).WriteInt32(bdn).WriteInt32(chip));
+    }
+
+    public PE32Batch pe32_pmucl(int bdn, int chip)
+    {
+        return Add(Begin(PE32Opcode.pe32_pmucl).WriteInt32(bdn).WriteInt32(chip));
+    }
+
+    public PE32Batch pe32_cal_load(int bdn, string calfile)
+    {
+        return Add(Begin(PE32Opcode.pe32_cal_load).WriteInt32(bdn).WriteString(calfile));
+    }
+
+    public PE32Batch pe32_cal_save(int bdn, string calfile)
+    {
+        return Add(Begin(PE32Opcode.pe32_cal_save).WriteInt32(bdn).WriteString(calfile));
+    }
+
+    public PE32Batch pe32_cal_load_auto(int bdn, string calfile)
+    {
+        return Add(Begin(PE32Opcode.pe32_cal_load_auto).WriteInt32(bdn).WriteString(calfile));
+    }
+
+    public PE32Batch pe32_cal_save_auto(int bdn, string calfile)
+    {
+        return Add(Begin(PE32Opcode.pe32_cal_save_auto).WriteInt32(bdn).WriteString(calfile));
+    }
+
+    public PE32Batch pe32_cal_reset(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_cal_reset).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_con_esense(int bdn, int pno, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_con_esense).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_con_eforce(int bdn, int pno, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_con_eforce).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_con_ext(int bdn, int pno, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_con_ext).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_set_deskew(int bdn, int pno, int rt)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_deskew).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rt));
+    }
+
+    public PE32Batch pe32_set_fallingskew(int bdn, int pno, int rt)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_fallingskew).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rt));
+    }
+
+    public PE32Batch pe32_set_rcvskew(int bdn, int pno, int rt)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_rcvskew).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rt));
+    }
+
+    public PE32Batch pe32_set_rcvfallingskew(int bdn, int pno, int rt)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_rcvfallingskew).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rt));
+    }
+
+    public PE32Batch pe32_getch(int bdn, int pno)
+    {
+        return Add(Begin(PE32Opcode.pe32_getch).WriteInt32(bdn).WriteInt32(pno));
+    }
+
+    public PE32Batch pe32_getcl(int bdn, int pno)
+    {
+        return Add(Begin(PE32Opcode.pe32_getcl).WriteInt32(bdn).WriteInt32(pno));
+    }
+
+    public PE32Batch pemu32_rst_pe(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pemu32_rst_pe).WriteInt32(bdn));
+    }
+
+    public PE32Batch pemu32_set_driver(int bdn, int pno, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pemu32_set_driver).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_counter_ctp(int bdn, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_counter_ctp).WriteInt32(bdn).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_counter_start(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_counter_start).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_counter_select_ch(int bdn, int ch)
+    {
+        return Add(Begin(PE32Opcode.pe32_counter_select_ch).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public PE32Batch pe32_counter_rd(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_counter_rd).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_counter_rdfrq(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_counter_rdfrq).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_counter_tmmode(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_counter_tmmode).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_tmu_cstart_inv(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_tmu_cstart_inv).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_tmu_cstop_inv(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_tmu_cstop_inv).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_tmu_select_cstart(int bdn, int ch)
+    {
+        return Add(Begin(PE32Opcode.pe32_tmu_select_cstart).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public PE32Batch pe32_tmu_select_cstop(int bdn, int ch)
+    {
+        return Add(Begin(PE32Opcode.pe32_tmu_select_cstop).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public PE32Batch pe32_rd_pesno(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_pesno).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_get_temp(int bdn, int cno)
+    {
+        return Add(Begin(PE32Opcode.pe32_get_temp).WriteInt32(bdn).WriteInt32(cno));
+    }
+
+    public PE32Batch pe32_set_srdmode(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_srdmode).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_srd_select_ch(int bdn, int ch)
+    {
+        return Add(Begin(PE32Opcode.pe32_srd_select_ch).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public PE32Batch pe32_srd_getword(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_srd_getword).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_srd_getword2(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_srd_getword2).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_srd_getsrword(int bdn, int ch)
+    {
+        return Add(Begin(PE32Opcode.pe32_srd_getsrword).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public PE32Batch pe32_srd_rdblock32(int bdn, int add)
+    {
+        return Add(Begin(PE32Opcode.pe32_srd_rdblock32).WriteInt32(bdn).WriteInt32(add));
+    }
+
+    public PE32Batch pe32_setReg(int bdn, int pno, int dacno, int rv)
+    {
+        return Add(Begin(PE32Opcode.pe32_setReg).WriteInt32(bdn).WriteInt32(pno).WriteInt32(dacno).WriteInt32(rv));
+    }
+
+    public PE32Batch pe32_dc_range(int bdn, int range)
+    {
+        return Add(Begin(PE32Opcode.pe32_dc_range).WriteInt32(bdn).WriteInt32(range));
+    }
+
+    public PE32Batch pe32_set_lmsyn_active_high(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_lmsyn_active_high).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_set_lmsyn_ch(int bdn, int ch)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_lmsyn_ch).WriteInt32(bdn).WriteInt32(ch));
+    }
+
+    public PE32Batch pe32_rd_logcnt(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_logcnt).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_reset_lmiomk(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_reset_lmiomk).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_con_2k2vtt(int bdn, int pno, int onoff, double vtt)
+    {
+        return Add(Begin(PE32Opcode.pe32_con_2k2vtt).WriteInt32(bdn).WriteInt32(pno).WriteInt32(onoff).WriteDouble(vtt));
+    }
+
+    public PE32Batch pe32_get_msg()
+    {
+        return Add(Begin(PE32Opcode.pe32_get_msg));
+    }
+
+    public PE32Batch pe32_set_rffemode(int bdn, int port, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_rffemode).WriteInt32(bdn).WriteInt32(port).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_rffe_ftp(int bdn, int wtp, int rtp)
+    {
+        return Add(Begin(PE32Opcode.pe32_rffe_ftp).WriteInt32(bdn).WriteInt32(wtp).WriteInt32(rtp));
+    }
+
+    public PE32Batch pe32_rffe_pclk(int bdn, int pclk)
+    {
+        return Add(Begin(PE32Opcode.pe32_rffe_pclk).WriteInt32(bdn).WriteInt32(pclk));
+    }
+
+    public PE32Batch pe32_rffe_wr(int bdn, int port, int sadd, int add, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_rffe_wr).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_rffe_rd(int bdn, int port, int sadd, int add)
+    {
+        return Add(Begin(PE32Opcode.pe32_rffe_rd).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add));
+    }
+
+    public PE32Batch pe32_rffe_ewr(int bdn, int port, int sadd, int add, int data, int bcnt)
+    {
+        return Add(Begin(PE32Opcode.pe32_rffe_ewr).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(data).WriteInt32(bcnt));
+    }
+
+    public PE32Batch pe32_rffe_erd(int bdn, int port, int sadd, int add, int bcnt)
+    {
+        return Add(Begin(PE32Opcode.pe32_rffe_erd).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(bcnt));
+    }
+
+    public PE32Batch pe32_rffe_getword(int bdn, int port)
+    {
+        return Add(Begin(PE32Opcode.pe32_rffe_getword).WriteInt32(bdn).WriteInt32(port));
+    }
+
+    public PE32Batch pe32_rffe_wr0(int bdn, int port, int sadd, int data)
+    {
+        return Add(Begin(PE32Opcode.pe32_rffe_wr0).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(data));
+    }
+
+    public PE32Batch pe32_rffe_elwr(int bdn, int port, int sadd, int add, int data, int bcnt)
+    {
+        return Add(Begin(PE32Opcode.pe32_rffe_elwr).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(data).WriteInt32(bcnt));
+    }
+
+    public PE32Batch pe32_rffe_elrd(int bdn, int port, int sadd, int add, int bcnt)
+    {
+        return Add(Begin(PE32Opcode.pe32_rffe_elrd).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(add).WriteInt32(bcnt));
+    }
+
+    public PE32Batch pe32_rffe_cmdwr(int bdn, int port, int sadd, int cmd, int add, int data, int bcnt)
+    {
+        return Add(Begin(PE32Opcode.pe32_rffe_cmdwr).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(cmd).WriteInt32(add).WriteInt32(data).WriteInt32(bcnt));
+    }
+
+    public PE32Batch pe32_rffe_cmdrd(int bdn, int port, int sadd, int cmd, int add, int data, int bcnt)
+    {
+        return Add(Begin(PE32Opcode.pe32_rffe_cmdrd).WriteInt32(bdn).WriteInt32(port).WriteInt32(sadd).WriteInt32(cmd).WriteInt32(add).WriteInt32(data).WriteInt32(bcnt));
+    }
+
+    public PE32Batch pe32_set_qmode(int bdn, int onoff)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_qmode).WriteInt32(bdn).WriteInt32(onoff));
+    }
+
+    public PE32Batch pe32_check_qfail(int bdn, int cno)
+    {
+        return Add(Begin(PE32Opcode.pe32_check_qfail).WriteInt32(bdn).WriteInt32(cno));
+    }
+
+    public PE32Batch pe32_set_rodvhdvl(int bdn, int pno, int rodvh, int rodvl)
+    {
+        return Add(Begin(PE32Opcode.pe32_set_rodvhdvl).WriteInt32(bdn).WriteInt32(pno).WriteInt32(rodvh).WriteInt32(rodvl));
+    }
+
+    public PE32Batch pe32_rd_PciRevId(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_PciRevId).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_PciDevId(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_PciDevId).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_rd_PciSubId(int bdn)
+    {
+        return Add(Begin(PE32Opcode.pe32_rd_PciSubId).WriteInt32(bdn));
+    }
+
+    public PE32Batch pe32_trig_mv(int bdn, int pno, int pxitrg)
+    {
+        return Add(Begin(PE32Opcode.pe32_trig_mv).WriteInt32(bdn).WriteInt32(pno).WriteInt32(pxitrg));
+    }
+
+    public PE32Batch pe32_trig_mi(int bdn, int pno, int pxitrg)
+    {
+        return Add(Begin(PE32Opcode.pe32_trig_mi).WriteInt32(bdn).WriteInt32(pno).WriteInt32(pxitrg));
+    }
+
+    public PE32Batch pe32_trig_imeas(int bdn, int pno)
+    {
+        return Add(Begin(PE32Opcode.pe32_trig_imeas).WriteInt32(bdn).WriteInt32(pno));
+    }
+
+    public PE32Batch pe32_trig_vmeas(int bdn, int pno)
+    {
+        return Add(Begin(PE32Opcode.pe32_trig_vmeas).WriteInt32(bdn).WriteInt32(pno));
+    }
+
+    public PE32Batch pe32_user_fram_save(int bdn, int add, string data, int size)
+    {
+        return Add(Begin(PE32Opcode.pe32_user_fram_save).WriteInt32(bdn).WriteInt32(add).WriteString(data).WriteInt32(size));
+    }
+
+    public PE32Batch pe32_user_fram_load(int bdn, int add, int size)
+    {
+        return Add(Begin(PE32Opcode.pe32_user_fram_load).WriteInt32(bdn).WriteInt32(add).WriteInt32(size));
+    }
+
+    public PE32Batch ipc_nop(int bdn)
+    {
+        return Add(Begin(PE32Opcode.ipc_nop).WriteInt32(bdn));
+    }
+
+    public PE32Batch ipc_echo(int bdn, int value)
+    {
+        return Add(Begin(PE32Opcode.ipc_echo).WriteInt32(bdn).WriteInt32(value));
+    }
+
+    public PE32Batch ipc_echo_bytes(int bdn, int size)
+    {
+        return Add(Begin(PE32Opcode.ipc_echo_bytes).WriteInt32(bdn).WriteInt32(size));
+    }
+
+    public PE32Batch pe32_pattern_lmload(int begbdno, int boardwidth, int begadd, int hashlo, int hashhi)
+    {
+        return Add(Begin(PE32Opcode.pe32_pattern_lmload).WriteInt32(begbdno).WriteInt32(boardwidth).WriteInt32(begadd).WriteInt32(hashlo).WriteInt32(hashhi));
+    }
+}
@@ -0,0 +1,71 @@
+﻿namespace PE32Proxy;
+
+// The bridge process exited while a call was waiting for it. With PE32ProxyOptions.Standby
+// the proxy has switched to its standby bridge when FailedOver is set, and later calls go there.
+public sealed class PE32BridgeLostException : Exception
+{
+    public PE32BridgeLostException(string message)
+        : base(message) { }
+
+    public PE32BridgeLostException(string message, Exception inner, bool failedOver)
+        : base(message, inner)
+    {
+        FailedOver = failedOver;
+    }
+
+    public bool FailedOver { get; }
+}
+
+// Requests that bring the hardware into its working state, in the order they succeeded.
+// A standby bridge runs them before it takes over, a new pe32_init starts a new prologue.
+// Calls, async calls and batches record them only once the bridge answered Ok.
+internal sealed class PE32Prologue
+{
+    private static readonly HashSet<PE32Opcode> recorded =
+    [
+        PE32Opcode.pe32_init,
+        PE32Opcode.pe32_cal_load,
+        PE32Opcode.pe32_cal_load_auto,
+    ];
+
+    private readonly List<(int Channel, byte[] Request)> requests = [];
+
+    public int Count => requests.Count;
+
+    public static bool Records(PE32Opcode opcode) => recorded.Contains(opcode);
+
+    public void Record(BinaryRequestWriter request)
+    {
+        if (Records(request.Opcode))
+            Record(request.Opcode, request.Channel, request.Written.ToArray());
+    }
+
+    // request is the complete binary request, as sent on channel
+    public void Record(PE32Opcode opcode, int channel, byte[] request)
+    {
+        // Async calls record from the poller thread
+        lock (requests)
+        {
+            if (opcode == PE32Opcode.pe32_init)
+                requests.Clear();
+            requests.Add((channel, request));
+        }
+    }
+
+    public void Replay(IReadOnlyList<UltraFastIPCClient> channels)
+    {
+        lock (requests)
+        {
+            foreach (var (channel, request) in requests)
+            {
+                var response = channels[channel].SendRequestBinary(request);
+                if (response.Status != BinaryStatus.Ok)
+                {
+                    throw new InvalidOperationException(
+                        $"Replaying {(PE32Opcode)BitConverter.ToUInt16(request)} failed: {response.Status}"
+                    );
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,145 @@
+﻿using System.Buffers.Binary;
+using System.IO.MemoryMappedFiles;
+using System.Security.Cryptography;
+
+namespace PE32Proxy;
+
+// Pattern loading through the pattern cache of the bridge, see UltraFastIPC/PatternCache.h.
+// A pattern crosses to the bridge once, through the bulk region, and is loaded by its content hash.
+public partial class PE32Proxy
+{
+    // Must match PATTERN_NOT_CACHED in UltraFastIPC/PatternCache.h
+    internal const int PatternNotCached = int.MinValue;
+
+    // Content hash per pattern file, computed again only when the file changes
+    private readonly Dictionary<string, (DateTime LastWrite, long Length, ulong Hash)> patternHashes =
+        [];
+
+    // Same as it_lmload, but the DLL reads the bridge's copy of the file. An unchanged file
+    // is not hashed again, and once the bridge holds it only its hash is sent.
+    public int it_lmload_cached(int begbdno, int boardwidth, int begadd, string patternfile)
+    {
+        var file = new FileInfo(patternfile);
+        if (!file.Exists)
+        {
+            throw new FileNotFoundException(
+                $"The Digital pattern PEZ file {patternfile} not found."
+            );
+        }
+
+        (DateTime LastWrite, long Length, ulong Hash) known;
+        lock (patternHashes)
+        {
+            if (
+                !patternHashes.TryGetValue(file.FullName, out known)
+                || known.LastWrite != file.LastWriteTimeUtc
+                || known.Length != file.Length
+            )
+            {
+                using var pattern = new MappedPattern(file);
+                known = (file.LastWriteTimeUtc, file.Length, PatternHash(pattern.Span));
+                patternHashes[file.FullName] = known;
+            }
+        }
+
+        int result = LoadStoredPattern(begbdno, boardwidth, begadd, known.Hash);
+        if (result != PatternNotCached)
+            return result;
+
+        using (var pattern = new MappedPattern(file))
+        {
+            StorePattern(known.Hash, pattern.Span);
+        }
+        return LoadStoredPattern(begbdno, boardwidth, begadd, known.Hash);
+    }
+
+    // For patterns built in memory, hashed on every call
+    public int it_lmload_cached(int begbdno, int boardwidth, int begadd, ReadOnlySpan<byte> pattern)
+    {
+        ulong hash = PatternHash(pattern);
+        int result = LoadStoredPattern(begbdno, boardwidth, begadd, hash);
+        if (result != PatternNotCached)
+            return result;
+
+        StorePattern(hash, pattern);
+        return LoadStoredPattern(begbdno, boardwidth, begadd, hash);
+    }
+
+    private int LoadStoredPattern(int begbdno, int boardwidth, int begadd, ulong hash)
+    {
+        return pe32_pattern_lmload(begbdno, boardwidth, begadd, (int)hash, (int)(hash >> 32));
+    }
+
+    // Sends the pattern in chunks of one bulk slot. The bridge answers 0 as soon as it holds
+    // the whole pattern, which may be right away when another proxy stored it first.
+    private void StorePattern(ulong hash, ReadOnlySpan<byte> pattern)
+    {
+        int chunkSize = client.BulkSlotSize;
+        if (chunkSize == 0)
+            throw new InvalidOperationException("Storing patterns needs PE32ProxyOptions.BulkSize");
+
+        int offset = 0;
+        do
+        {
+            var chunk = pattern.Slice(offset, Math.Min(chunkSize, pattern.Length - offset));
+            int missing = pe32_pattern_store((int)hash, (int)(hash >> 32), offset, pattern.Length, chunk);
+            if (missing == 0)
+                return;
+            offset += chunk.Length;
+        } while (offset < pattern.Length);
+
+        throw new InvalidOperationException("The bridge did not complete the stored pattern");
+    }
+
+    // First 64 bits of the SHA-256 of the content
+    private static ulong PatternHash(ReadOnlySpan<byte> pattern)
+    {
+        Span<byte> digest = stackalloc byte[SHA256.HashSizeInBytes];
+        SHA256.HashData(pattern, digest);
+        return BinaryPrimitives.ReadUInt64LittleEndian(digest);
+    }
+
+    // Read-only view of a pattern file, its pages are copied straight into the bulk region
+    private sealed unsafe class MappedPattern : IDisposable
+    {
+        private readonly MemoryMappedFile? file;
+        private readonly MemoryMappedViewAccessor? view;
+        private readonly byte* data;
+        private readonly int length;
+
+        public MappedPattern(FileInfo pattern)
+        {
+            if (pattern.Length > int.MaxValue)
+                throw new ArgumentException($"Pattern file {pattern.FullName} is larger than 2 GB");
+
+            // Empty files can not be mapped
+            length = (int)pattern.Length;
+            if (length == 0)
+                return;
+
+            file = MemoryMappedFile.CreateFromFile(
+                pattern.FullName,
+                FileMode.Open,
+                null,
+                0,
+                MemoryMappedFileAccess.Read
+            );
+            view = file.CreateViewAccessor(0, length, MemoryMappedFileAccess.Read);
+            byte* mapped = null;
+            view.SafeMemoryMappedViewHandle.AcquirePointer(ref mapped);
+            data = mapped + view.PointerOffset;
+        }
+
+        public ReadOnlySpan<byte> Span => new(data, length);
+
+        public void Dispose()
+        {
+            if (view != null)
+            {
+                view.SafeMemoryMappedViewHandle.ReleasePointer();
+                view.Dispose();
+            }
+            file?.Dispose();
+        }
+    }
+}
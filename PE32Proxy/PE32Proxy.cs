@@ -3,24 +3,79 @@ using System.Collections.Generic;
 using System.Diagnostics;
 using System.Linq;
 using System.Reflection;
+using System.Runtime.InteropServices;
 using System.Text;
 using System.Threading.Tasks;
 
 namespace PE32Proxy;
 
-public class PE32Proxy : IDisposable
+public partial class PE32Proxy : IDisposable
 {
     private bool disposed = false;
 
-    private readonly UltraFastIPCClient client;
+    // One client per channel, client is channel 0. Both change when a standby bridge takes over.
+    // Any number of threads may call through them at once.
+    private volatile UltraFastIPCClient[] channels;
+
+    private volatile UltraFastIPCClient client;
+
+    // Serializes failovers, several threads may notice the same dead bridge
+    private readonly object failoverLock = new();
+
+    // Channels of bridges that died, kept mapped until Dispose because other threads
+    // may still be returning from calls into them
+    private readonly List<UltraFastIPCClient[]> lostBridges = [];
+
+    private readonly PE32ProxyOptions options;
+    private readonly string exePath;
+
+    // Started in the background with PE32ProxyOptions.Standby, replaced after every failover
+    private Task<UltraFastIPCClient[]?>? standby;
+
+    // Requests replayed on the standby bridge before it takes over
+    private readonly PE32Prologue prologue = new();
+
+    private static int instanceCount;
+
+    // Each thread builds its own batches
+    private readonly ThreadLocal<PE32Batch?> batches = new();
+
+    private readonly PE32QueryCache queryCache;
+
+    // Completes every *_async call, started by the first of them
+    private PE32AsyncPoller? poller;
+    private object? pollerLock;
+
+    // Every stub encodes on a writer of its own thread, so any number of threads may call them
+    [ThreadStatic]
+    private static BinaryRequestWriter? threadRequest;
 
     public int SerialNumber { get; private set; }
 
+    // Breakdown of the last call that waited for its response, per thread so channel threads keep their own
+    [ThreadStatic]
+    private static PE32CallTimings lastCallTimings;
+
+    public PE32CallTimings LastCallTimings => lastCallTimings;
+
+    // When set, calls without a return value are queued and not waited for.
+    // A failure is thrown from the next call that returns a value or from Flush().
+    public bool FireAndForget { get; set; }
+
+    // Times a standby bridge took over from a bridge that died
+    public int Failovers { get; private set; }
+
     public PE32Proxy(bool debugMode)
+        : this(new PE32ProxyOptions { DebugMode = debugMode }) { }
+
+    public PE32Proxy(PE32ProxyOptions options)
     {
-        string exePath = "UltraFastIPC.exe";
+        options.CheckCpus();
+        this.options = options;
+        queryCache = new PE32QueryCache(options.CacheQueries);
+        exePath = options.BridgePath ?? "UltraFastIPC.exe";
 
-        if (!File.Exists(exePath))
+        if (options.BridgePath == null && !File.Exists(exePath))
         {
             exePath = Path.Combine(
                 Environment.GetFolderPath(Environment.SpecialFolder.ProgramFiles),
@@ -29,18 +84,137 @@ public class PE32Proxy : IDisposable
             );
         }
 
-        client = new UltraFastIPCClient(exePath) { DebugMode = debugMode };
+        if (options.PriorityClass is { } priorityClass)
+            Process.GetCurrentProcess().PriorityClass = priorityClass;
 
-        if (!client.StartBridgeProcess())
+        bool started = TryStartBridge(out var first);
+        channels = first;
+        client = first[0];
+
+        if (started && options.Standby)
+            standby = Task.Run(StartStandby);
+    }
+
+    // Starts a bridge with one client per channel and warms every channel up with the no-op opcode
+    private bool TryStartBridge(out UltraFastIPCClient[] started)
+    {
+        // Unique per host process and per bridge, so several hosts never share a mapping
+        string channelName =
+            $"UltraFastIPC_{Environment.ProcessId}_{Interlocked.Increment(ref instanceCount)}";
+        started = new UltraFastIPCClient[Math.Max(1, options.ChannelCount)];
+        for (int k = 0; k < started.Length; k++)
+        {
+            started[k] = new UltraFastIPCClient(exePath, $"{channelName}_{k}")
+            {
+                DebugMode = options.DebugMode,
+                WaitMode = options.WaitMode,
+                SpinCount = options.SpinCount,
+                BulkSize = options.BulkSize,
+                ShadowWrites = options.ShadowWrites,
+                ReduceBatches = options.ReduceBatches,
+                PatternCacheDirectory = options.PatternCacheDirectory,
+                TraceDirectory = options.TraceDirectory,
+                TelemetryCommands = options.TelemetryCommands,
+                TelemetryPeriod = options.TelemetryPeriod,
+                StartupTimeout = options.StartupTimeout,
+                BridgeArguments = options.BridgeArguments,
+                BridgeCpus = options.BridgeCpus,
+                AutoAffinity = options.AutoAffinity,
+                PreferredClientCpu = options.ClientCpus is { Count: > 0 } cpus ? cpus[k % cpus.Count] : null,
+                PriorityClass = options.PriorityClass,
+                HighThreadPriority = options.HighThreadPriority,
+                MmcssTask = options.MmcssTask,
+            };
+        }
+
+        if (!started[0].StartBridgeProcess(channelName, started.Length))
         {
             Console.WriteLine("Startup failed");
-            return;
+            return false;
+        }
+        for (int k = 1; k < started.Length; k++)
+        {
+            started[k].Connect(started[0].BridgeProcess);
         }
+        if (options.TelemetryCommands is { Count: > 0 } && OperatingSystem.IsWindows())
+            started[0].Telemetry = PE32Telemetry.Open(channelName);
 
-        // Warm up the system
-        for (int i = 0; i < 10; i++)
+        var nop = new BinaryRequestWriter().Begin(PE32Opcode.ipc_nop).WriteInt32(0);
+        foreach (var channel in started)
         {
-            client.SendRequestUltraFast("warmup");
+            for (int i = 0; i < 10; i++)
+            {
+                channel.SendRequestBinary(nop);
+            }
+        }
+        return true;
+    }
+
+    private UltraFastIPCClient[]? StartStandby()
+    {
+        UltraFastIPCClient[]? started = null;
+        try
+        {
+            if (TryStartBridge(out started))
+                return started;
+        }
+        catch (Exception ex)
+        {
+            Console.WriteLine($"Standby bridge failed: {ex.Message}");
+        }
+
+        if (started != null)
+            DisposeChannels(started);
+        return null;
+    }
+
+    // Called after the bridge died: the standby replays the prologue and serves all further calls.
+    // The call that noticed still fails, it may or may not have run before the bridge went away.
+    // lostChannels are the channels the call was sent through, every later caller that saw them
+    // fail finds them replaced already.
+    private PE32BridgeLostException Failover(PE32BridgeLostException lost, UltraFastIPCClient[] lostChannels)
+    {
+        lock (failoverLock)
+        {
+            if (channels != lostChannels)
+                return new PE32BridgeLostException(lost.Message, lost, failedOver: true);
+            return SwitchToStandby(lost);
+        }
+    }
+
+    private PE32BridgeLostException SwitchToStandby(PE32BridgeLostException lost)
+    {
+        var next = standby?.Result;
+        standby = null;
+        if (next == null)
+            return lost;
+
+        // The poller fails the calls still waiting on the old slots
+        var lostChannels = channels;
+        lostBridges.Add(lostChannels);
+        poller?.Retire(lostChannels);
+
+        // Replayed before other threads can see the new channels
+        queryCache.Invalidate();
+        prologue.Replay(next);
+        channels = next;
+        client = next[0];
+        Failovers++;
+
+        standby = Task.Run(StartStandby);
+        return new PE32BridgeLostException(
+            $"{lost.Message}, switched to the standby bridge after replaying {prologue.Count} requests",
+            lost,
+            failedOver: true
+        );
+    }
+
+    // Channel 0 owns the bridge process, it goes last
+    private static void DisposeChannels(UltraFastIPCClient[] disposed)
+    {
+        for (int k = disposed.Length - 1; k >= 0; k--)
+        {
+            disposed[k]?.Dispose();
         }
     }
 
@@ -59,7 +233,16 @@ public class PE32Proxy : IDisposable
         {
             if (disposing)
             {
-                client?.Dispose();
+                poller?.Dispose();
+                batches.Dispose();
+                foreach (var lost in lostBridges)
+                {
+                    DisposeChannels(lost);
+                }
+                DisposeChannels(channels);
+                var spare = standby?.Result;
+                if (spare != null)
+                    DisposeChannels(spare);
             }
             disposed = true;
         }
@@ -72,6 +255,155 @@ public class PE32Proxy : IDisposable
         return response;
     }
 
+    private BinaryRequestWriter Begin(PE32Opcode opcode)
+    {
+        return Begin(opcode, 1);
+    }
+
+    // Starts the request on the calling thread's writer, for the channel that serves board bdn
+    private BinaryRequestWriter Begin(PE32Opcode opcode, int bdn)
+    {
+        threadRequest ??= new BinaryRequestWriter();
+        threadRequest.Channel = (int)((uint)(bdn - 1) % (uint)channels.Length);
+        return threadRequest.Begin(opcode);
+    }
+
+    private BinaryResponseReader Call(BinaryRequestWriter request)
+    {
+        return Call(request, default);
+    }
+
+    // bulkInput goes into the slot's bulk region, for stubs with a bulk input argument
+    private BinaryResponseReader Call(BinaryRequestWriter request, ReadOnlySpan<byte> bulkInput)
+    {
+        var current = channels;
+        var channel = current[request.Channel];
+        BinaryResponseReader response;
+        try
+        {
+            response = channel.SendRequestBinary(request, bulkInput);
+        }
+        catch (PE32BridgeLostException lost) when (standby != null && !lost.FailedOver)
+        {
+            throw Failover(lost, current);
+        }
+        lastCallTimings = channel.LastTimings;
+        if (response.Status != BinaryStatus.Ok)
+        {
+            throw new InvalidOperationException($"{request.Opcode} failed: {response.Status}");
+        }
+        prologue.Record(request);
+        return response;
+    }
+
+    // Posts the request and returns at once, the poller decodes the response on its thread.
+    // A bridge that died fails the call with PE32BridgeLostException, the next synchronous
+    // call then switches to the standby bridge.
+    private ValueTask<T> CallAsync<T>(BinaryRequestWriter request, Func<BinaryResponseReader, T> decode)
+    {
+        var call = PostAsync(request, decode, out short token);
+        return new ValueTask<T>(call, token);
+    }
+
+    private ValueTask SendAsync(BinaryRequestWriter request)
+    {
+        var call = PostAsync(request, static _ => true, out short token);
+        return new ValueTask(call, token);
+    }
+
+    private PE32AsyncCall<T> PostAsync<T>(
+        BinaryRequestWriter request,
+        Func<BinaryResponseReader, T> decode,
+        out short token
+    )
+    {
+        if (PE32Prologue.Records(request.Opcode))
+        {
+            // The writer is reused before the response comes, decode only runs for an Ok one
+            var opcode = request.Opcode;
+            int channel = request.Channel;
+            byte[] written = request.Written.ToArray();
+            var inner = decode;
+            decode = response =>
+            {
+                prologue.Record(opcode, channel, written);
+                return inner(response);
+            };
+        }
+        var completions = LazyInitializer.EnsureInitialized(
+            ref poller,
+            ref pollerLock,
+            () => new PE32AsyncPoller(options.SpinCount)
+        );
+        var call = PE32AsyncCall<T>.Rent(
+            request.Opcode,
+            decode,
+            Stopwatch.GetTimestamp() + PE32AsyncPoller.Timeout
+        );
+        token = call.Version;
+        channels[request.Channel].PostAsync(request, call, completions);
+        return call;
+    }
+
+    private void Send(BinaryRequestWriter request)
+    {
+        if (!FireAndForget)
+        {
+            Call(request);
+            return;
+        }
+
+        var current = channels;
+        try
+        {
+            current[request.Channel].PostWithoutReply(request);
+        }
+        catch (PE32BridgeLostException lost) when (standby != null && !lost.FailedOver)
+        {
+            throw Failover(lost, current);
+        }
+    }
+
+    // Waits for every queued fire-and-forget call and throws the first failure among them
+    public void Flush()
+    {
+        foreach (var channel in channels)
+        {
+            channel.Flush();
+        }
+    }
+
+    // Starts collecting calls into a batch, sent with one handshake per 4 KB by Execute().
+    // The batch object and its results are reused by the next BeginBatch() of the same thread.
+    public PE32Batch BeginBatch()
+    {
+        var batch = batches.Value;
+        if (batch == null || batch.Client != client)
+            batches.Value = batch = new PE32Batch(client, queryCache, prologue);
+        return batch.Reset();
+    }
+
+    // Pins the calling thread to the CPU chosen for it by PE32ProxyOptions.ClientCpus or AutoAffinity,
+    // next to the bridge thread of the channel, and gives it HighThreadPriority and MmcssTask.
+    // Call it once from each thread that drives the channel, the thread keeps the placement.
+    public void PinCurrentThread(int channel = 0)
+    {
+        channels[channel].PinCallingThread();
+    }
+
+    // Call counts and timings of the bridge, read from shared memory without a round trip
+    public PE32Stats GetStats()
+    {
+        return PE32Stats.Snapshot(channels);
+    }
+
+    // Name the serving bridge was started with, a failover changes it.
+    // PE32Telemetry.Open(BridgeName) maps its telemetry from any process.
+    public string BridgeName => client.BridgeName;
+
+    // Latest samples of PE32ProxyOptions.TelemetryCommands, null without them
+    public PE32Telemetry? Telemetry => client.Telemetry;
+
     public void TestCommunication(string msg = "test")
     {
         string response = SendRequest(msg);
@@ -171,247 +503,248 @@ public class PE32Proxy : IDisposable
 
     public int it_api()
     {
-        return int.Parse(SendRequest("pe32_api"));
+        return pe32_api();
     }
 
     public int it_init()
     {
-        return int.Parse(SendRequest("pe32_init"));
+        return pe32_init();
     }
 
     public void it_reset(int bdno)
     {
-        SendRequest("pe32_reset", bdno);
+        pe32_reset(bdno);
     }
 
     public void it_set_ftcnt(int bdno, int cnt)
     {
-        SendRequest("pe32_set_ftcnt", bdno, cnt);
+        pe32_set_ftcnt(bdno, cnt);
     }
 
     public void it_set_addbeg(int bdno, int add)
     {
-        SendRequest("pe32_set_addbeg", bdno, add);
+        pe32_set_addbeg(bdno, add);
     }
 
     public void it_set_addend(int bdno, int add)
     {
-        SendRequest("pe32_set_addend", bdno, add);
+        pe32_set_addend(bdno, add);
     }
 
     public void it_set_addif(int bdno, int add)
     {
-        SendRequest("pe32_set_addif", bdno, add);
+        pe32_set_addif(bdno, add);
     }
 
     public void it_set_addsyn(int bdno, int add)
     {
-        SendRequest("pe32_set_addsyn", bdno, add);
+        pe32_set_addsyn(bdno, add);
     }
 
     public void it_set_lmsyn_enb(int bdno, int onoff)
     {
+        // Not exported by the bridge (no entry in PE32Commands.h), kept on the text path
         SendRequest("pe32_set_lmsyn_enb", bdno, onoff);
     }
 
     public void it_set_lmsyn_ch(int bdno, int ch)
     {
-        SendRequest("pe32_set_lmsyn_ch", bdno, ch);
+        pe32_set_lmsyn_ch(bdno, ch);
     }
 
     public void it_set_lmsyn_active_high(int bdno, int onoff)
     {
-        SendRequest("pe32_set_lmsyn_active_high", bdno, onoff);
+        pe32_set_lmsyn_active_high(bdno, onoff);
     }
 
     public void it_fstart(int bdno, int onoff)
     {
-        SendRequest("pe32_fstart", bdno, onoff);
+        pe32_fstart(bdno, onoff);
     }
 
     public void it_set_trigmode(int bdno, int onoff)
     {
-        SendRequest("pe32_set_trigmode", bdno, onoff);
+        pe32_set_trigmode(bdno, onoff);
     }
 
     public int it_check_tprun(int bdno)
     {
-        return int.Parse(SendRequest("pe32_check_tprun", bdno));
+        return pe32_check_tprun(bdno);
     }
 
     public int it_check_tpass(int bdno)
     {
-        return int.Parse(SendRequest("pe32_check_tpass", bdno));
+        return pe32_check_tpass(bdno);
     }
 
     public void it_cycle(int bdno, int onoff)
     {
-        SendRequest("pe32_cycle", bdno, onoff);
+        pe32_cycle(bdno, onoff);
     }
 
     public int it_check_sync(int bdno)
     {
-        return int.Parse(SendRequest("pe32_check_sync", bdno));
+        return pe32_check_sync(bdno);
     }
 
     public int it_check_testbeg(int bdno)
     {
-        return int.Parse(SendRequest("pe32_check_testbeg", bdno));
+        return pe32_check_testbeg(bdno);
     }
 
     public int it_check_ftend(int bdno)
     {
-        return int.Parse(SendRequest("pe32_check_ftend", bdno));
+        return pe32_check_ftend(bdno);
     }
 
     public int it_check_lend(int bdno)
     {
-        return int.Parse(SendRequest("pe32_check_lend", bdno));
+        return pe32_check_lend(bdno);
     }
 
     public void it_set_pxi(int bdno, int data)
     {
-        SendRequest("pe32_set_pxi", bdno, data);
+        pe32_set_pxi(bdno, data);
     }
 
     public void it_pxi_fstart(int bdno, int ch, int onoff)
     {
-        SendRequest("pe32_pxi_fstart", bdno, ch, onoff);
+        pe32_pxi_fstart(bdno, ch, onoff);
     }
 
     public void it_pxi_cfail(int bdno, int ch, int onoff)
     {
-        SendRequest("pe32_pxi_cfail", bdno, ch, onoff);
+        pe32_pxi_cfail(bdno, ch, onoff);
     }
 
     public void it_pxi_lmsyn(int bdno, int ch, int onoff)
     {
-        SendRequest("pe32_pxi_lmsyn", bdno, ch, onoff);
+        pe32_pxi_lmsyn(bdno, ch, onoff);
     }
 
     public void it_set_seq(int bdno, int data)
     {
-        SendRequest("pe32_set_seq", bdno, data);
+        pe32_set_seq(bdno, data);
     }
 
     public void it_set_lmf(int bdno, int data)
     {
-        SendRequest("pe32_set_lmf", bdno, data);
+        pe32_set_lmf(bdno, data);
     }
 
     public long it_rd_seq(int bdno)
     {
-        return long.Parse(SendRequest("pe32_rd_seq", bdno));
+        return pe32_rd_seq(bdno);
     }
 
     public long it_rd_lmf(int bdno)
     {
-        return long.Parse(SendRequest("pe32_rd_lmf", bdno));
+        return pe32_rd_lmf(bdno);
     }
 
     public long it_rd_lmadd(int bdno)
     {
-        return long.Parse(SendRequest("pe32_rd_lmadd", bdno));
+        return pe32_rd_lmadd(bdno);
     }
 
     public uint it_rd_fccnt(int bdno)
     {
-        return uint.Parse(SendRequest("pe32_rd_fccnt", bdno));
+        return pe32_rd_fccnt(bdno);
     }
 
     public uint it_rd_flcnt(int bdno)
     {
-        return uint.Parse(SendRequest("pe32_rd_flcnt", bdno));
+        return pe32_rd_flcnt(bdno);
     }
 
     public uint it_rd_ftcnt(int bdno)
     {
-        return uint.Parse(SendRequest("pe32_rd_ftcnt", bdno));
+        return pe32_rd_ftcnt(bdno);
     }
 
     public int it_check_checkmode(int bdno)
     {
-        return int.Parse(SendRequest("pe32_check_checkmode", bdno));
+        return pe32_check_checkmode(bdno);
     }
 
     public int it_check_dataready(int bdno)
     {
-        return int.Parse(SendRequest("pe32_check_dataready", bdno));
+        return pe32_check_dataready(bdno);
     }
 
     public void it_set_checkmode(int bdno, int onoff)
     {
-        SendRequest("pe32_set_checkmode", bdno, onoff);
+        pe32_set_checkmode(bdno, onoff);
     }
 
     public void it_set_logmode(int bdno, int onoff)
     {
-        SendRequest("pe32_set_logmode", bdno, onoff);
+        pe32_set_logmode(bdno, onoff);
     }
 
     public int it_rd_clog(int bdno, int addr)
     {
-        return int.Parse(SendRequest("pe32_rd_clog", bdno, addr));
+        return pe32_rd_clog(bdno, addr);
     }
 
     public int it_rd_alog(int bdno, int addr)
     {
-        return int.Parse(SendRequest("pe32_rd_alog", bdno, addr));
+        return pe32_rd_alog(bdno, addr);
     }
 
     public int it_rd_logadd(int bdno)
     {
-        return int.Parse(SendRequest("pe32_rd_logadd", bdno));
+        return pe32_rd_logadd(bdno);
     }
 
     public int it_rd_logcnt(int bdno)
     {
-        return int.Parse(SendRequest("pe32_rd_logcnt", bdno));
+        return pe32_rd_logcnt(bdno);
     }
 
     public int it_rd_pesno(int bdno)
     {
-        return int.Parse(SendRequest($"pe32_rd_pesno {bdno}"));
+        return pe32_rd_pesno(bdno);
     }
 
     public double it_get_temp(int bdno, int cno)
     {
-        return double.Parse(SendRequest("pe32_get_temp", bdno, cno));
+        return pe32_get_temp(bdno, cno);
     }
 
     public void it_dc_range(int bdno, int range)
     {
-        SendRequest("pe32_dc_range", bdno, range);
+        pe32_dc_range(bdno, range);
     }
 
     public void it_set_tp(int bdno, int ts, int data)
     {
-        SendRequest("pe32_set_tp", bdno, ts, data);
+        pe32_set_tp(bdno, ts, data);
     }
 
     public void it_set_tstart(int bdno, int pno, int ts, int data)
     {
-        SendRequest("pe32_set_tstart", bdno, pno, ts, data);
+        pe32_set_tstart(bdno, pno, ts, data);
     }
 
     public void it_set_tstop(int bdno, int pno, int ts, int data)
     {
-        SendRequest("pe32_set_tstop", bdno, pno, ts, data);
+        pe32_set_tstop(bdno, pno, ts, data);
     }
 
     public void it_set_tstrob(int bdno, int pno, int ts, int data)
     {
-        SendRequest("pe32_set_tstrob", bdno, pno, ts, data);
+        pe32_set_tstrob(bdno, pno, ts, data);
     }
 
     public void it_set_rz(int bdno, int fs, int data)
     {
-        SendRequest("pe32_set_rz", bdno, fs, data);
+        pe32_set_rz(bdno, fs, data);
     }
 
     public void it_set_ro(int bdno, int fs, int data)
     {
-        SendRequest("pe32_set_ro", bdno, fs, data);
+        pe32_set_ro(bdno, fs, data);
     }
 
     public int it_lmload(int begbdno, int boardwidth, int begadd, string patternfile)
@@ -423,167 +756,201 @@ public class PE32Proxy : IDisposable
             );
         }
 
-        return int.Parse(SendRequest("pe32_lmload", begbdno, boardwidth, begadd, patternfile));
+        return pe32_lmload(begbdno, boardwidth, begadd, patternfile);
     }
 
     public void it_set_qmode(int bdno, int onoff)
     {
-        SendRequest("pe32_set_qmode", bdno, onoff);
+        pe32_set_qmode(bdno, onoff);
     }
 
     public int it_check_qfail(int bdno, int cno)
     {
-        return int.Parse(SendRequest("pe32_check_qfail", bdno, cno));
+        return pe32_check_qfail(bdno, cno);
     }
 
     public void it_con_2k2vtt(int bdno, int pno, int onoff, double vtt)
     {
-        SendRequest("pe32_con_2k2vtt", bdno, pno, onoff, vtt);
+        pe32_con_2k2vtt(bdno, pno, onoff, vtt);
     }
 
     public void it_set_vih(int bdno, int pno, double rv)
     {
-        SendRequest("pe32_set_vih", bdno, pno, rv);
+        pe32_set_vih(bdno, pno, rv);
     }
 
     public void it_set_vil(int bdno, int pno, double rv)
     {
-        SendRequest("pe32_set_vil", bdno, pno, rv);
+        pe32_set_vil(bdno, pno, rv);
     }
 
     public void it_set_voh(int bdno, int pno, double rv)
     {
-        SendRequest("pe32_set_voh", bdno, pno, rv);
+        pe32_set_voh(bdno, pno, rv);
     }
 
     public void it_set_vol(int bdno, int pno, double rv)
     {
-        SendRequest("pe32_set_vol", bdno, pno, rv);
+        pe32_set_vol(bdno, pno, rv);
     }
 
     public void it_cpu_df(int bdno, int pno, int donoff, int fonoff)
     {
-        SendRequest("pe32_cpu_df", bdno, pno, donoff, fonoff);
+        pe32_cpu_df(bdno, pno, donoff, fonoff);
     }
 
     public void it_pmufv(int bdno, int chip, double rv, double clampi)
     {
-        SendRequest("pe32_pmufv", bdno, chip, rv, clampi);
+        pe32_pmufv(bdno, chip, rv, clampi);
     }
 
     public void it_pmufi(int bdno, int chip, double ri, double cvh, double cvl)
     {
-        SendRequest("pe32_pmufi", bdno, chip, ri, cvh, cvl);
+        pe32_pmufi(bdno, chip, ri, cvh, cvl);
     }
 
     public void it_pmufir(int bdno, int cno, double ri, double cvh, double cvl, int rang)
     {
-        SendRequest("pe32_pmufir", bdno, cno, ri, cvh, cvl, rang);
+        pe32_pmufir(bdno, cno, ri, cvh, cvl, rang);
     }
 
     public void it_pmucv(int bdno, int cno, double cvh, double cvl)
     {
-        SendRequest("pe32_pmucv", bdno, cno, cvh, cvl);
+        pe32_pmucv(bdno, cno, cvh, cvl);
     }
 
     public void it_pmuci(int bdno, int cno, double cih, double cil)
     {
-        SendRequest("pe32_pmuci", bdno, cno, cih, cil);
+        pe32_pmuci(bdno, cno, cih, cil);
     }
 
     public void it_con_pmu(int bdno, int pno, int onoff)
     {
-        SendRequest("pe32_con_pmu", bdno, pno, onoff);
+        pe32_con_pmu(bdno, pno, onoff);
     }
 
     public void it_con_pmus(int bdno, int pno, int onoff)
     {
-        SendRequest("pe32_con_pmus", bdno, pno, onoff);
+        pe32_con_pmus(bdno, pno, onoff);
     }
 
     public int it_check_pmu(int bdno, int cno)
     {
-        return int.Parse(SendRequest("pe32_check_pmu", bdno, cno));
+        return pe32_check_pmu(bdno, cno);
     }
 
     public double it_vmeas(int bdno, int pno)
     {
-        return double.Parse(SendRequest("pe32_vmeas", bdno, pno));
+        return pe32_vmeas(bdno, pno);
     }
 
     public double it_imeas(int bdno, int pno)
     {
-        return double.Parse(SendRequest("pe32_imeas", bdno, pno));
+        return pe32_imeas(bdno, pno);
     }
 
     public int it_cal_load(int bdno, string calfile)
     {
-        return int.Parse(SendRequest("pe32_cal_load", bdno, calfile));
+        return pe32_cal_load(bdno, calfile);
     }
 
     public int it_cal_load_auto(int bdno, string calfile)
     {
-        return int.Parse(SendRequest("pe32_cal_load_auto", bdno, calfile));
+        return pe32_cal_load_auto(bdno, calfile);
     }
 
     public void it_cal_reset(int bdno)
     {
-        SendRequest("pe32_cal_reset", bdno);
+        pe32_cal_reset(bdno);
     }
 
     public void it_set_rffemode(int bdno, int port, int onoff)
     {
-        SendRequest("pe32_set_rffemode", bdno, port, onoff);
+        pe32_set_rffemode(bdno, port, onoff);
     }
 
     public void it_rffe_ftp(int bdno, int wtp, int rtp)
     {
-        SendRequest("pe32_rffe_ftp", bdno, wtp, rtp);
+        pe32_rffe_ftp(bdno, wtp, rtp);
     }
 
     public void it_rffe_wr(int bdno, int port, int sadd, int add, short data)
     {
-        SendRequest("pe32_rffe_wr", bdno, port, sadd, add, data);
+        pe32_rffe_wr(bdno, port, sadd, add, data);
     }
 
     public int it_rffe_rd(int bdno, int port, int sadd, int add)
     {
-        return int.Parse(SendRequest("pe32_rffe_rd", bdno, port, sadd, add));
+        return pe32_rffe_rd(bdno, port, sadd, add);
     }
 
     public void it_rffe_ewr(int bdno, int port, int sadd, int add, int data, int Bcnt)
     {
-        SendRequest("pe32_rffe_ewr", bdno, port, sadd, add, data, Bcnt);
+        pe32_rffe_ewr(bdno, port, sadd, add, data, Bcnt);
     }
 
     public int it_rffe_erd(int bdno, int port, int sadd, int add, int Bcnt)
     {
-        return int.Parse(SendRequest("pe32_rffe_erd", bdno, port, sadd, add, Bcnt));
+        return pe32_rffe_erd(bdno, port, sadd, add, Bcnt);
     }
 
     public int it_rffe_getword(int bdno, int port)
     {
-        return int.Parse(SendRequest("pe32_rffe_getword", bdno, port));
+        return pe32_rffe_getword(bdno, port);
     }
 
     public void it_set_driver(int bdno, int pno, int onoff)
     {
-        SendRequest("pe32_set_driver", bdno, pno, onoff);
+        pe32_set_driver(bdno, pno, onoff);
     }
 
     public void it_set_rcvskew(int bdno, int pno, int rt)
     {
-        SendRequest("pe32_set_rcvskew", bdno, pno, rt);
+        pe32_set_rcvskew(bdno, pno, rt);
     }
 
     public void it_set_deskew(int bdno, int pno, int rt)
     {
-        SendRequest("pe32_set_deskew", bdno, pno, rt);
+        pe32_set_deskew(bdno, pno, rt);
     }
 
     public void it_rffe_wr0(int bdno, int port, int sadd, short data)
     {
-        SendRequest("pe32_rffe_wr0", bdno, port, sadd, data);
+        pe32_rffe_wr0(bdno, port, sadd, data);
+    }
+
+    // Bulk reads: one round trip for count values, returned in place in shared memory.
+    // The span stays valid until 16 more requests have been sent, copy it to keep it longer.
+    public ReadOnlySpan<int> it_dump_getalog(int bdno, int addr, int count)
+    {
+        return MemoryMarshal.Cast<byte, int>(pe32_bulk_dump_getalog(bdno, addr, count));
+    }
+
+    public ReadOnlySpan<int> it_dump_getclog(int bdno, int addr, int count)
+    {
+        return MemoryMarshal.Cast<byte, int>(pe32_bulk_dump_getclog(bdno, addr, count));
+    }
+
+    public ReadOnlySpan<int> it_srd_getword(int bdno, int count)
+    {
+        return MemoryMarshal.Cast<byte, int>(pe32_bulk_srd_getword(bdno, count));
+    }
+
+    // Range reads over [begin, end), the loop runs in the bridge
+    public ReadOnlySpan<AlogClog> it_dump_getalogclog(int bdno, int begin, int end)
+    {
+        return MemoryMarshal.Cast<byte, AlogClog>(pe32_bulk_dump_getalogclog(bdno, begin, end));
+    }
+
+    public ReadOnlySpan<int> it_srd_rdblock32(int bdno, int begin, int end)
+    {
+        return MemoryMarshal.Cast<byte, int>(pe32_bulk_srd_rdblock32(bdno, begin, end));
+    }
+
+    // lmf, lmd and lmm of the boards firstBdno..lastBdno
+    public ReadOnlySpan<LmCounters> it_rd_lm(int firstBdno, int lastBdno)
+    {
+        return MemoryMarshal.Cast<byte, LmCounters>(pe32_bulk_rd_lm(firstBdno, lastBdno + 1));
     }
 
     #endregion
@@ -0,0 +1,117 @@
+﻿using System.Diagnostics;
+
+namespace PE32Proxy;
+
+// How the client and the bridge wait for each other - must match WaitMode on the C++ end
+public enum WaitMode
+{
+    // Poll with Thread.Yield/Sleep(0), lowest latency but each side burns a core while idle
+    BusySpin = 0,
+
+    // Poll for SpinCount rounds, then block on a named event until the other side signals
+    Hybrid = 1,
+}
+
+// Settings of a PE32Proxy and of the bridge process it starts
+public sealed class PE32ProxyOptions
+{
+    public bool DebugMode { get; init; }
+
+    public WaitMode WaitMode { get; init; } = WaitMode.Hybrid;
+
+    // Polling rounds before a side blocks in WaitMode.Hybrid
+    public int SpinCount { get; init; } = 20000;
+
+    // Size of the shared memory the bridge returns bulk reads in, split between the ring slots
+    public int BulkSize { get; init; } = 16 * 1024 * 1024;
+
+    // Independent IPC channels to the bridge. Board bdn is served by channel (bdn - 1) % ChannelCount,
+    // calls without a board number by channel 0. Use one thread per channel at most.
+    public int ChannelCount { get; init; } = 1;
+
+    // Answers board identity queries (pe32_rd_id, pe32_rd_pesno, ...) in process after the first call,
+    // until the next pe32_init or pe32_reset sent through this proxy
+    public bool CacheQueries { get; init; }
+
+    // The bridge skips level and timing writes (pe32_set_vih, pe32_set_tstrob, ...) of the value
+    // a pin already holds, until a reset or calibration. See PE32Stats.ShadowSkipped.
+    public bool ShadowWrites { get; init; }
+
+    // The bridge drops level and timing writes a later write of the same target in the same
+    // batch overwrites, and groups the other commands of a batch by board. See PE32Stats.BatchCoalesced.
+    public bool ReduceBatches { get; init; }
+
+    // Directory where the bridge keeps the patterns of PE32Proxy.it_lmload_cached(), by content
+    // hash. Null uses UltraFastIPC\Patterns in the temp directory of the bridge.
+    public string? PatternCacheDirectory { get; init; }
+
+    // Commands the bridge samples in the background every TelemetryPeriod, in text protocol form such
+    // as "pe32_get_temp 1 0", from the first pe32_init on. Monitors read the latest results from
+    // PE32Proxy.Telemetry or PE32Telemetry.Open(BridgeName) without a request. Only the reads in
+    // kTelemetryCommands (UltraFastIPC/TelemetryPage.h) are accepted, at most 63.
+    public IReadOnlyList<string>? TelemetryCommands { get; init; }
+
+    public TimeSpan TelemetryPeriod { get; init; } = TimeSpan.FromMilliseconds(100);
+
+    // Directory where the bridge records every request into <name>.trace, see TraceReplay.
+    // DebugMode records into UltraFastIPC in the temp directory when this is null.
+    public string? TraceDirectory { get; init; }
+
+    // Keeps a second bridge started and warmed up. When the bridge dies, the call that noticed throws
+    // PE32BridgeLostException and the standby takes over after replaying pe32_init and the calibration
+    // loads sent so far. A new standby is started in the background.
+    public bool Standby { get; init; }
+
+    // Pins bridge channel k to CPU BridgeCpus[k % Count]
+    public IReadOnlyList<int>? BridgeCpus { get; init; }
+
+    // Pins every bridge channel to one CPU of a pair sharing an L2 cache, or an L3 cache
+    // if none is shared, and suggests the other one to PinCurrentThread. Ignored with BridgeCpus.
+    public bool AutoAffinity { get; init; }
+
+    // CPU PinCurrentThread(k) pins to, ClientCpus[k % Count], instead of the bridge's suggestion
+    public IReadOnlyList<int>? ClientCpus { get; init; }
+
+    // Priority class of this process and of the bridge, High or RealTime keeps the spinning
+    // threads from being preempted by ordinary work
+    public ProcessPriorityClass? PriorityClass { get; init; }
+
+    // Highest priority for the bridge channel threads and the PinCurrentThread callers,
+    // time critical for the bridge under ProcessPriorityClass.RealTime
+    public bool HighThreadPriority { get; init; }
+
+    // MMCSS task such as "Pro Audio" for the bridge channel threads and the PinCurrentThread callers
+    public string? MmcssTask { get; init; }
+
+    // Longest wait for a starting bridge to map its channels
+    public TimeSpan StartupTimeout { get; init; } = TimeSpan.FromSeconds(10);
+
+    // UltraFastIPC.exe to start instead of the installed one, e.g. the Mock build
+    public string? BridgePath { get; init; }
+
+    // Extra bridge options such as "--mock-latency=5 --mock-boards=8"
+    public string? BridgeArguments { get; init; }
+
+    // Affinity masks address processor group 0 only, 32 CPUs in the 32-bit bridge and
+    // UltraFastIPCClient.AffinityCpus in this process. Pinning across groups is out of scope.
+    internal void CheckCpus()
+    {
+        CheckCpus(BridgeCpus, 32, nameof(BridgeCpus));
+        CheckCpus(ClientCpus, UltraFastIPCClient.AffinityCpus, nameof(ClientCpus));
+    }
+
+    private static void CheckCpus(IReadOnlyList<int>? cpus, int count, string name)
+    {
+        foreach (int cpu in cpus ?? [])
+        {
+            if (cpu < 0 || cpu >= count)
+            {
+                throw new ArgumentOutOfRangeException(
+                    name,
+                    cpu,
+                    $"CPUs must be 0 to {count - 1} of processor group 0"
+                );
+            }
+        }
+    }
+}
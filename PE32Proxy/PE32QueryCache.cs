@@ -0,0 +1,63 @@
+﻿namespace PE32Proxy;
+
+// In process answers of the commands UltraFastIPC/CommandRegistry.h marks immutable, such as
+// board ids and serial numbers, kept when PE32ProxyOptions.CacheQueries is set.
+// Every pe32_init and pe32_reset starts a new version. Answers fetched under an older
+// version are dropped, so a call racing an invalidation never repopulates the cache.
+internal sealed class PE32QueryCache(bool enabled)
+{
+    private readonly Dictionary<(PE32Opcode Opcode, int Key), int> values = [];
+    private readonly object gate = new();
+    private long version;
+
+    public bool TryGet(PE32Opcode opcode, int key, out int value, out long version)
+    {
+        if (!enabled)
+        {
+            value = 0;
+            version = 0;
+            return false;
+        }
+        lock (gate)
+        {
+            version = this.version;
+            return values.TryGetValue((opcode, key), out value);
+        }
+    }
+
+    // Keeps value only if nothing invalidated the cache since TryGet returned version
+    public void Store(PE32Opcode opcode, int key, int value, long version)
+    {
+        if (!enabled)
+            return;
+        lock (gate)
+        {
+            if (version == this.version)
+                values[(opcode, key)] = value;
+        }
+    }
+
+    public void Invalidate()
+    {
+        if (!enabled)
+            return;
+        lock (gate)
+        {
+            version++;
+            values.Clear();
+        }
+    }
+
+    // Invalidates now and once more when disposed, after the invalidating command ran
+    public Invalidation BeginInvalidation(bool active = true)
+    {
+        if (active)
+            Invalidate();
+        return new Invalidation(active ? this : null);
+    }
+
+    internal readonly ref struct Invalidation(PE32QueryCache? cache)
+    {
+        public void Dispose() => cache?.Invalidate();
+    }
+}
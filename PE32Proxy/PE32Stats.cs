@@ -0,0 +1,179 @@
+﻿namespace PE32Proxy;
+
+// Timing of one opcode across all channels, read from the bridge's <name>_Stats pages.
+// Offsets must match CommandStats in UltraFastIPC/StatsPage.h.
+public sealed unsafe class PE32CommandStats
+{
+    internal const int Size = 576;
+    internal const int CountOffset = 0;
+    internal const int TotalOffset = 8;
+    internal const int MinOffset = 16;
+    internal const int MaxOffset = 24;
+    internal const int BucketsOffset = 32;
+    internal const int SkippedOffset = 544;
+    internal const int BucketCount = 128;
+    internal const int SubBucketBits = 2;
+
+    private readonly ulong[] buckets = new ulong[BucketCount];
+    private readonly long ticksPerSecond;
+    private ulong totalTicks;
+    private ulong minTicks = ulong.MaxValue;
+    private ulong maxTicks;
+
+    internal PE32CommandStats(string name, long ticksPerSecond)
+    {
+        Name = name;
+        this.ticksPerSecond = ticksPerSecond;
+    }
+
+    public string Name { get; }
+
+    public long Count { get; private set; }
+
+    // Shadowed writes answered without the DLL, coalesced ones included, not part of Count
+    public long Skipped { get; private set; }
+
+    public TimeSpan Total => FromTicks(totalTicks);
+
+    public TimeSpan Min => Count == 0 ? TimeSpan.Zero : FromTicks(minTicks);
+
+    public TimeSpan Max => FromTicks(maxTicks);
+
+    public TimeSpan Mean => Count == 0 ? TimeSpan.Zero : FromTicks(totalTicks / (ulong)Count);
+
+    // Upper edge of the histogram bucket holding the given percentile (0 - 100), within 25 %
+    public TimeSpan Percentile(double percentile)
+    {
+        if (Count == 0)
+            return TimeSpan.Zero;
+
+        ulong target = (ulong)Math.Max(1, Math.Ceiling(percentile / 100 * Count));
+        ulong seen = 0;
+        for (int i = 0; i < BucketCount - 1; i++)
+        {
+            seen += buckets[i];
+            if (seen >= target)
+                return FromTicks(Math.Min(BucketStart(i + 1) - 1, maxTicks));
+        }
+        return Max;
+    }
+
+    public override string ToString() =>
+        $"{Name}: {Count} calls, mean {Mean.TotalMicroseconds:F1} us, "
+        + $"p99 {Percentile(99).TotalMicroseconds:F1} us, max {Max.TotalMicroseconds:F1} us";
+
+    // Adds the entry at stats, the counters of one channel
+    internal void Add(byte* stats)
+    {
+        Count += (long)Volatile.Read(ref *(ulong*)(stats + CountOffset));
+        totalTicks += Volatile.Read(ref *(ulong*)(stats + TotalOffset));
+        minTicks = Math.Min(minTicks, Volatile.Read(ref *(ulong*)(stats + MinOffset)));
+        maxTicks = Math.Max(maxTicks, Volatile.Read(ref *(ulong*)(stats + MaxOffset)));
+        Skipped += (long)Volatile.Read(ref *(ulong*)(stats + SkippedOffset));
+        uint* source = (uint*)(stats + BucketsOffset);
+        for (int i = 0; i < BucketCount; i++)
+        {
+            buckets[i] += Volatile.Read(ref source[i]);
+        }
+    }
+
+    // Smallest tick count of bucket i, the inverse of StatsBucket() on the C++ end
+    private static ulong BucketStart(int bucket)
+    {
+        const int subBuckets = 1 << SubBucketBits;
+        if (bucket < subBuckets)
+            return (ulong)bucket;
+
+        int msb = bucket / subBuckets + SubBucketBits - 1;
+        return (ulong)(subBuckets + bucket % subBuckets) << (msb - SubBucketBits);
+    }
+
+    private TimeSpan FromTicks(ulong ticks) =>
+        TimeSpan.FromTicks((long)(ticks * (double)TimeSpan.TicksPerSecond / ticksPerSecond));
+}
+
+// Snapshot of the always-on bridge counters, taken without a round trip.
+// Any call may be running while it is read, so a snapshot can be one sample behind.
+public sealed unsafe class PE32Stats
+{
+    // Must match STATS_LAYOUT_VERSION and StatsPage in UltraFastIPC/StatsPage.h
+    internal const uint LayoutVersion = 3;
+    internal const int CommandCountOffset = 4;
+    internal const int CommandStatsSizeOffset = 8;
+    internal const int TicksPerSecondOffset = 24;
+    internal const int ShadowIssuedOffset = 32;
+    internal const int ShadowSkippedOffset = 40;
+    internal const int BatchCoalescedOffset = 48;
+    internal const int RequestsOffset = 64;
+    internal const int CommandsOffset = 640;
+
+    private PE32Stats(
+        PE32CommandStats requests,
+        IReadOnlyList<PE32CommandStats> commands,
+        long shadowIssued,
+        long shadowSkipped,
+        long batchCoalesced
+    )
+    {
+        Requests = requests;
+        Commands = commands;
+        ShadowIssued = shadowIssued;
+        ShadowSkipped = shadowSkipped;
+        BatchCoalesced = batchCoalesced;
+    }
+
+    // Pickup to response publish in the bridge, per request or batch
+    public PE32CommandStats Requests { get; }
+
+    // Time spent in the vendor DLL, for every opcode called at least once
+    public IReadOnlyList<PE32CommandStats> Commands { get; }
+
+    // Shadowed writes that reached the DLL and those skipped, with PE32ProxyOptions.ShadowWrites
+    public long ShadowIssued { get; }
+
+    public long ShadowSkipped { get; }
+
+    // Writes a later write in their batch overwrote, with PE32ProxyOptions.ReduceBatches
+    public long BatchCoalesced { get; }
+
+    internal static void CheckLayout(byte* page)
+    {
+        uint version = *(uint*)page;
+        int count = *(int*)(page + CommandCountOffset);
+        int size = *(int*)(page + CommandStatsSizeOffset);
+        if (version != LayoutVersion || count != Enum.GetValues<PE32Opcode>().Length || size != PE32CommandStats.Size)
+        {
+            throw new InvalidOperationException(
+                $"Bridge uses stats layout {version} ({count} commands of {size} bytes)"
+            );
+        }
+    }
+
+    internal static PE32Stats Snapshot(IReadOnlyList<UltraFastIPCClient> channels)
+    {
+        long ticksPerSecond = *(long*)(channels[0].StatsPage + TicksPerSecondOffset);
+        var requests = new PE32CommandStats("requests", ticksPerSecond);
+        var commands = new List<PE32CommandStats>();
+        long shadowIssued = 0;
+        long shadowSkipped = 0;
+        long batchCoalesced = 0;
+        foreach (var channel in channels)
+        {
+            requests.Add(channel.StatsPage + RequestsOffset);
+            shadowIssued += (long)Volatile.Read(ref *(ulong*)(channel.StatsPage + ShadowIssuedOffset));
+            shadowSkipped += (long)Volatile.Read(ref *(ulong*)(channel.StatsPage + ShadowSkippedOffset));
+            batchCoalesced += (long)Volatile.Read(ref *(ulong*)(channel.StatsPage + BatchCoalescedOffset));
+        }
+        foreach (PE32Opcode opcode in Enum.GetValues<PE32Opcode>())
+        {
+            var stats = new PE32CommandStats(opcode.ToString(), ticksPerSecond);
+            foreach (var channel in channels)
+            {
+                stats.Add(channel.StatsPage + CommandsOffset + (int)opcode * PE32CommandStats.Size);
+            }
+            if (stats.Count > 0 || stats.Skipped > 0)
+                commands.Add(stats);
+        }
+        return new PE32Stats(requests, commands, shadowIssued, shadowSkipped, batchCoalesced);
+    }
+}
@@ -0,0 +1,164 @@
+﻿using System.Diagnostics;
+using System.IO.MemoryMappedFiles;
+using System.Runtime.Versioning;
+using System.Text;
+
+namespace PE32Proxy;
+
+// Latest result of one command in PE32ProxyOptions.TelemetryCommands. Samples is 0, and
+// Value meaningless, until the bridge ran pe32_init and sampled the command once.
+public readonly record struct PE32TelemetrySample(
+    string Command,
+    double Value,
+    BinaryStatus Status,
+    long Samples,
+    TimeSpan Age
+);
+
+// Read-only view of the <name>_Telemetry page a bridge started with --telemetry publishes.
+// Reading sends no request, so monitors in any process can poll it while the test flow runs.
+// Offsets must match TelemetryPage in UltraFastIPC/TelemetryPage.h.
+[SupportedOSPlatform("windows")]
+public sealed unsafe class PE32Telemetry : IDisposable
+{
+    internal const uint LayoutVersion = 1;
+    internal const int EntryCountOffset = 4;
+    internal const int EntrySizeOffset = 8;
+    internal const int PeriodOffset = 12;
+    internal const int TicksPerSecondOffset = 16;
+    internal const int RoundsOffset = 24;
+    internal const int EntriesOffset = 64;
+    internal const int EntrySize = 64;
+    internal const int StatusOffset = 4;
+    internal const int ValueOffset = 8;
+    internal const int SampleTimeOffset = 16;
+    internal const int SamplesOffset = 24;
+    internal const int LabelOffset = 32;
+    internal const int LabelSize = 32;
+
+    private readonly MemoryMappedFile mapping;
+    private readonly MemoryMappedViewAccessor accessor;
+    private readonly string[] commands;
+    private readonly long ticksPerSecond;
+    private byte* page;
+
+    private PE32Telemetry(MemoryMappedFile mapping, MemoryMappedViewAccessor accessor, byte* page)
+    {
+        this.mapping = mapping;
+        this.accessor = accessor;
+        this.page = page;
+        ticksPerSecond = *(long*)(page + TicksPerSecondOffset);
+        Period = TimeSpan.FromMicroseconds(*(uint*)(page + PeriodOffset));
+
+        // The labels are written before the bridge signals it is ready and never change
+        commands = new string[*(int*)(page + EntryCountOffset)];
+        for (int i = 0; i < commands.Length; i++)
+        {
+            var label = new ReadOnlySpan<byte>(Entry(i) + LabelOffset, LabelSize);
+            int end = label.IndexOf((byte)0);
+            commands[i] = Encoding.ASCII.GetString(end >= 0 ? label[..end] : label);
+        }
+    }
+
+    // Maps the page of the bridge started as bridgeName, see PE32Proxy.BridgeName
+    public static PE32Telemetry Open(string bridgeName)
+    {
+        MemoryMappedFile mapping;
+        try
+        {
+            mapping = MemoryMappedFile.OpenExisting(
+                bridgeName + "_Telemetry",
+                MemoryMappedFileRights.Read
+            );
+        }
+        catch (FileNotFoundException)
+        {
+            throw new InvalidOperationException($"Bridge {bridgeName} samples no telemetry");
+        }
+
+        var accessor = mapping.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+        byte* view = null;
+        accessor.SafeMemoryMappedViewHandle.AcquirePointer(ref view);
+        byte* page = view + accessor.PointerOffset;
+
+        uint version = *(uint*)page;
+        int size = *(int*)(page + EntrySizeOffset);
+        if (version != LayoutVersion || size != EntrySize)
+        {
+            accessor.SafeMemoryMappedViewHandle.ReleasePointer();
+            accessor.Dispose();
+            mapping.Dispose();
+            throw new InvalidOperationException(
+                $"Bridge uses telemetry layout {version} ({size} byte entries)"
+            );
+        }
+        return new PE32Telemetry(mapping, accessor, page);
+    }
+
+    // The sampled commands as configured, in entry order
+    public IReadOnlyList<string> Commands => commands;
+
+    public TimeSpan Period { get; }
+
+    // Passes the sampler completed over all commands
+    public long Rounds => (long)Volatile.Read(ref *(ulong*)(page + RoundsOffset));
+
+    // Reads entry index consistently, retrying while the sampler rewrites it
+    public PE32TelemetrySample Read(int index)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegative(index);
+        ArgumentOutOfRangeException.ThrowIfGreaterThanOrEqual(index, commands.Length);
+
+        byte* entry = Entry(index);
+        ref uint sequence = ref *(uint*)entry;
+        var spin = new SpinWait();
+        for (; ; spin.SpinOnce())
+        {
+            uint before = Volatile.Read(ref sequence);
+            if ((before & 1) != 0)
+                continue;
+
+            var status = (BinaryStatus)Volatile.Read(ref *(int*)(entry + StatusOffset));
+            long value = Volatile.Read(ref *(long*)(entry + ValueOffset));
+            long sampleTime = Volatile.Read(ref *(long*)(entry + SampleTimeOffset));
+            long samples = Volatile.Read(ref *(long*)(entry + SamplesOffset));
+            if (Volatile.Read(ref sequence) != before)
+                continue;
+
+            var age =
+                samples > 0
+                    ? TimeSpan.FromSeconds((double)(Stopwatch.GetTimestamp() - sampleTime) / ticksPerSecond)
+                    : TimeSpan.Zero;
+            return new PE32TelemetrySample(
+                commands[index],
+                BitConverter.Int64BitsToDouble(value),
+                status,
+                samples,
+                age
+            );
+        }
+    }
+
+    public IReadOnlyList<PE32TelemetrySample> ReadAll()
+    {
+        var samples = new PE32TelemetrySample[commands.Length];
+        for (int i = 0; i < samples.Length; i++)
+        {
+            samples[i] = Read(i);
+        }
+        return samples;
+    }
+
+    public void Dispose()
+    {
+        if (page != null)
+        {
+            accessor.SafeMemoryMappedViewHandle.ReleasePointer();
+            page = null;
+        }
+        accessor.Dispose();
+        mapping.Dispose();
+    }
+
+    private byte* Entry(int index) => page + EntriesOffset + index * EntrySize;
+}
@@ -0,0 +1,60 @@
+﻿using System.Text;
+
+namespace PE32Proxy;
+
+// Replay of requests the bridge recorded with --trace, see UltraFastIPC/TraceRing.h and TraceReplay
+public partial class PE32Proxy
+{
+    // FNV-1a over the command names in opcode order, must match TraceCommandHash() in
+    // UltraFastIPC/TraceRing.h. A trace only replays on a bridge with the same commands.
+    public static uint CommandHash { get; } = ComputeCommandHash();
+
+    public static string CommandName(ushort opcode)
+    {
+        if (opcode == BinaryRequestWriter.BatchOpcode)
+            return "batch";
+        return Enum.IsDefined((PE32Opcode)opcode) ? ((PE32Opcode)opcode).ToString() : $"opcode_{opcode}";
+    }
+
+    // Sends a recorded binary request unchanged on a channel and returns the status of its
+    // response, timed in LastCallTimings. A fire-and-forget request is only posted, and a
+    // failure is reported by Flush().
+    public BinaryStatus SendRecorded(int channel, ReadOnlySpan<byte> request)
+    {
+        var target = channels[channel % channels.Length];
+        if (request.Length < 4)
+            throw new ArgumentException("A binary request starts with its 4 byte header");
+
+        if ((request[3] & (byte)BinaryRequestFlags.NoReply) != 0)
+        {
+            target.PostWithoutReply(request);
+            return BinaryStatus.Ok;
+        }
+        var status = target.SendRequestBinary(request).Status;
+        lastCallTimings = target.LastTimings;
+        return status;
+    }
+
+    // Sends a recorded text protocol request and returns its text response
+    public string SendRecordedText(int channel, string request)
+    {
+        var target = channels[channel % channels.Length];
+        string response = target.SendRequestUltraFast(request);
+        lastCallTimings = target.LastTimings;
+        return response;
+    }
+
+    private static uint ComputeCommandHash()
+    {
+        uint hash = 2166136261;
+        foreach (var opcode in Enum.GetValues<PE32Opcode>().OrderBy(opcode => (ushort)opcode))
+        {
+            foreach (byte c in Encoding.ASCII.GetBytes(opcode.ToString() + "\n"))
+            {
+                hash ^= c;
+                hash *= 16777619;
+            }
+        }
+        return hash;
+    }
+}
@@ -1,42 +1,201 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.ComponentModel;
 using System.Diagnostics;
 using System.IO.MemoryMappedFiles;
 using System.Linq;
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using System.Text;
 using System.Threading.Tasks;
 
 namespace PE32Proxy;
 
-// Shared memory layout structure - must be exactly the same as the C++ end
-[StructLayout(LayoutKind.Sequential)]
+// One request/response slot of the ring - must be exactly the same as RingSlot in
+// UltraFastIPC/SharedMemoryLayout.h, which static_asserts the same offsets.
+// Client written, server written and payload regions each start on their own cache line.
+[StructLayout(LayoutKind.Explicit, Size = Size)]
+public unsafe struct RingSlot
+{
+    internal const int Size = 8320;
+    internal const int RequestSequenceOffset = 0;
+    internal const int ProtocolVersionOffset = 4;
+    internal const int RequestSizeOffset = 8;
+    internal const int SubmitTimeOffset = 16;
+    internal const int ResponseSequenceOffset = 64;
+    internal const int ResponseSizeOffset = 68;
+    internal const int PickupTimeOffset = 72;
+    internal const int DllEnterTimeOffset = 80;
+    internal const int DllExitTimeOffset = 88;
+    internal const int PublishTimeOffset = 96;
+    internal const int RequestDataOffset = 128;
+    internal const int ResponseDataOffset = 4224;
+
+    // Written by the client
+    [FieldOffset(RequestSequenceOffset)]
+    public uint request_sequence;
+
+    [FieldOffset(ProtocolVersionOffset)]
+    public uint protocol_version;
+
+    [FieldOffset(RequestSizeOffset)]
+    public uint request_size;
+
+    // QueryPerformanceCounter ticks (Stopwatch.GetTimestamp) like the server times
+    [FieldOffset(SubmitTimeOffset)]
+    public long submit_time;
+
+    // Written by the server
+    [FieldOffset(ResponseSequenceOffset)]
+    public uint response_sequence;
+
+    [FieldOffset(ResponseSizeOffset)]
+    public uint response_size;
+
+    [FieldOffset(PickupTimeOffset)]
+    public long pickup_time;
+
+    // 0 if the request made no vendor DLL call
+    [FieldOffset(DllEnterTimeOffset)]
+    public long dll_enter_time;
+
+    [FieldOffset(DllExitTimeOffset)]
+    public long dll_exit_time;
+
+    [FieldOffset(PublishTimeOffset)]
+    public long publish_time;
+
+    [FieldOffset(RequestDataOffset)]
+    public fixed byte request_data[UltraFastIPCClient.BufferSize];
+
+    [FieldOffset(ResponseDataOffset)]
+    public fixed byte response_data[UltraFastIPCClient.BufferSize];
+}
+
+// Shared memory layout structure - must be exactly the same as UltraFastIPC/SharedMemoryLayout.h
+[StructLayout(LayoutKind.Explicit, Size = Size)]
 public struct SharedMemoryLayout
 {
-    public uint request_flag; // Offset: 0
-    public uint response_flag; // Offset: 4
-    public uint sequence_id; // Offset: 8
-    public uint request_size; // Offset: 12
-    public uint response_size; // Offset: 16
+    internal const int Size = SlotsOffset + UltraFastIPCClient.SlotCount * RingSlot.Size;
+    internal const int LayoutVersionOffset = 0;
+    internal const int LayoutSizeOffset = 4;
+    internal const int SlotCountOffset = 8;
+    internal const int BulkSlotSizeOffset = 12;
+    internal const int ServerCpuOffset = 16;
+    internal const int ClientCpuOffset = 20;
+    internal const int StickyErrorOffset = 64;
+    internal const int StickyErrorOpcodeOffset = 68;
+    internal const int StickyErrorSequenceOffset = 72;
+    internal const int ServerWaitingOffset = 76;
+    internal const int LastRequestTimeOffset = 80;
+    internal const int LastResponseTimeOffset = 88;
+    internal const int ClientWaitingOffset = 128;
+    internal const int SlotsOffset = 192;
+
+    // Written once by the server before the client connects
+    [FieldOffset(LayoutVersionOffset)]
+    public uint layout_version;
+
+    [FieldOffset(LayoutSizeOffset)]
+    public uint layout_size;
+
+    [FieldOffset(SlotCountOffset)]
+    public uint slot_count;
+
+    // Bytes of the <name>_Bulk mapping owned by each slot
+    [FieldOffset(BulkSlotSizeOffset)]
+    public uint bulk_slot_size;
+
+    // CPU of the channel thread and the one suggested for the client, -1 for none
+    [FieldOffset(ServerCpuOffset)]
+    public int server_cpu;
+
+    [FieldOffset(ClientCpuOffset)]
+    public int client_cpu;
+
+    // Written by the server
+    [FieldOffset(StickyErrorOffset)]
+    public int sticky_error;
+
+    [FieldOffset(StickyErrorOpcodeOffset)]
+    public uint sticky_error_opcode;
+
+    [FieldOffset(StickyErrorSequenceOffset)]
+    public uint sticky_error_sequence;
+
+    [FieldOffset(ServerWaitingOffset)]
+    public uint server_waiting;
+
+    [FieldOffset(LastRequestTimeOffset)]
+    public ulong last_request_time;
+
+    [FieldOffset(LastResponseTimeOffset)]
+    public ulong last_response_time;
+
+    // Written by the client
+    [FieldOffset(ClientWaitingOffset)]
+    public uint client_waiting;
+
+    // First of UltraFastIPCClient.SlotCount slots, the others follow it
+    [FieldOffset(SlotsOffset)]
+    public RingSlot slots;
+}
 
-    [MarshalAs(UnmanagedType.ByValArray, SizeConst = 4096)]
-    public byte[] request_data; // Offset: 20
+internal unsafe partial class UltraFastIPCClient : IDisposable
+{
+    internal const int BufferSize = 4096;
 
-    [MarshalAs(UnmanagedType.ByValArray, SizeConst = 4096)]
-    public byte[] response_data; // Offset: 4116
+    // Bits of the affinity mask SetThreadAffinityMask takes in this process
+    internal static readonly int AffinityCpus = nuint.Size * 8;
 
-    public ulong last_request_time; // Offset: 8212
-    public ulong last_response_time; // Offset: 8216
-}
+    // Must match SHARED_MEMORY_LAYOUT_VERSION and RING_SLOT_COUNT on the C++ end
+    internal const uint LayoutVersion = 8;
+    internal const int SlotCount = 16;
 
-internal partial class UltraFastIPCClient : IDisposable
-{
     private readonly string sharedMemoryName;
     private readonly string bridgeExecutablePath;
     private MemoryMappedFile? mmf;
     private MemoryMappedViewAccessor? accessor;
+
+    // The mapped view, every request and response is read and written through it in place
+    private SharedMemoryLayout* layout;
+
+    // Bulk side channel, slot i owns bulkSlotSize bytes at bulk + i * bulkSlotSize
+    private MemoryMappedFile? bulkMmf;
+    private MemoryMappedViewAccessor? bulkAccessor;
+    private byte* bulk;
+    private int bulkSlotSize;
+    // Read-only view of <name>_Stats, see PE32Stats
+    private MemoryMappedFile? statsMmf;
+    private MemoryMappedViewAccessor? statsAccessor;
+    internal byte* StatsPage { get; private set; }
+
+    private EventWaitHandle? requestEvent;
+    private EventWaitHandle? responseEvent;
     private Process? bridgeProcess;
-    private uint sequenceCounter = 1;
+
+    // Only the client that started the bridge stops it, the other channels share its process
+    private bool ownsBridge;
+
+    // Sequence of the last request claimed. Producers take the next one with Interlocked.Increment,
+    // so any number of threads post at once without a lock.
+    private uint postedSequence;
+
+    // Sequence of the request owning each slot until its response has been read, 0 for none
+    private readonly uint[] reservedSlots = new uint[SlotCount];
+
+    // The response event is auto-reset, so only the leading waiter blocks on it.
+    // It wakes the other waiting threads through waitLock whenever it wakes itself.
+    private readonly object waitLock = new();
+    private bool waitLeader;
+
+    // Responses are copied out of their slot, which then takes the next request at once.
+    // One copy per thread, valid until the thread's next call.
+    [ThreadStatic]
+    private static BinaryResponseReader? threadResponse;
+
+    [ThreadStatic]
+    private static byte[]? threadResponseData;
     private bool disposed = false;
 
     // High precision timer
@@ -50,12 +209,87 @@ internal partial class UltraFastIPCClient : IDisposable
 
     private long performanceFrequency;
 
+    [LibraryImport("kernel32.dll")]
+    private static partial nint GetCurrentThread();
+
+    [LibraryImport("kernel32.dll", SetLastError = true)]
+    private static partial nuint SetThreadAffinityMask(nint hThread, nuint dwThreadAffinityMask);
+
+    [LibraryImport(
+        "avrt.dll",
+        EntryPoint = "AvSetMmThreadCharacteristicsW",
+        SetLastError = true,
+        StringMarshalling = StringMarshalling.Utf16
+    )]
+    private static partial nint AvSetMmThreadCharacteristics(string taskName, ref uint taskIndex);
+
     internal bool DebugMode { get; init; }
 
-    internal UltraFastIPCClient(
-        string bridgeExePath,
-        string sharedMemName = "UltraFastIPC_SharedMem"
-    )
+    internal WaitMode WaitMode { get; init; } = WaitMode.Hybrid;
+
+    internal int SpinCount { get; init; } = 20000;
+
+    internal int BulkSize { get; init; } = 16 * 1024 * 1024;
+
+    internal bool ShadowWrites { get; init; }
+
+    internal bool ReduceBatches { get; init; }
+
+    // Where the bridge keeps stored patterns, null for its default
+    internal string? PatternCacheDirectory { get; init; }
+
+    // Where the bridge records its trace, null for none. The bridge only takes a directory that exists.
+    internal string? TraceDirectory { get; init; }
+
+    internal IReadOnlyList<string>? TelemetryCommands { get; init; }
+
+    internal TimeSpan TelemetryPeriod { get; init; }
+
+    // --name of the bridge this client started, empty for the other channels
+    internal string BridgeName { get; private set; } = "";
+
+    // Set on the client that started the bridge when it samples telemetry, disposed with it
+    internal PE32Telemetry? Telemetry { get; set; }
+
+    // Largest bulk input of one request, 0 without a bulk mapping
+    internal int BulkSlotSize => bulkSlotSize;
+
+    // Longest wait for the bridge to signal <name>_Ready
+    internal TimeSpan StartupTimeout { get; init; } = TimeSpan.FromSeconds(10);
+
+    // How often a waiting StartBridgeProcess checks that the bridge is still alive
+    private const int StartupPollInterval = 20;
+
+    // BusySpin looks at the bridge process every 4096 polls, Hybrid after every blocking wait
+    private const int BridgeCheckInterval = 4095;
+
+    // Appended to the bridge command line as is, e.g. the --mock-* options of the Mock build
+    internal string? BridgeArguments { get; init; }
+
+    // Thread placement of the bridge channels, see PE32ProxyOptions
+    internal IReadOnlyList<int>? BridgeCpus { get; init; }
+
+    internal bool AutoAffinity { get; init; }
+
+    internal ProcessPriorityClass? PriorityClass { get; init; }
+
+    internal bool HighThreadPriority { get; init; }
+
+    internal string? MmcssTask { get; init; }
+
+    // Overrides the client_cpu the bridge suggests
+    internal int? PreferredClientCpu { get; init; }
+
+    // CPU PinCallingThread pins to, -1 leaves the thread to the scheduler
+    internal int ClientCpu { get; private set; } = -1;
+
+    // Where the time of the last request completed by the calling thread went
+    [ThreadStatic]
+    private static PE32CallTimings lastTimings;
+
+    internal PE32CallTimings LastTimings => lastTimings;
+
+    internal UltraFastIPCClient(string bridgeExePath, string sharedMemName = "UltraFastIPC_SharedMem_0")
     {
         this.bridgeExecutablePath = bridgeExePath;
         this.sharedMemoryName = sharedMemName;
@@ -77,20 +311,60 @@ internal partial class UltraFastIPCClient : IDisposable
         "CA1416:Validate platform compatibility",
         Justification = "<Pending>"
     )]
-    public bool StartBridgeProcess()
+    // Starts a bridge serving channelCount channels mapped as <channelName>_<k>, then connects.
+    // The other channels connect with Connect() once this has returned.
+    public bool StartBridgeProcess(string channelName, int channelCount)
     {
+        BridgeName = channelName;
         try
         {
             Console.WriteLine("Starting 32-bit bridge process...");
 
+            // Created before the bridge starts so its signal can not be missed
+            using var ready = new EventWaitHandle(
+                false,
+                EventResetMode.ManualReset,
+                channelName + "_Ready"
+            );
+
+            if (TraceDirectory != null)
+                Directory.CreateDirectory(TraceDirectory);
+
             ProcessStartInfo startInfo =
                 new()
                 {
                     FileName = bridgeExecutablePath,
                     Arguments = string.Join(
                         " ",
-                        [Environment.ProcessId.ToString(), DebugMode ? "1" : "0"]
-                    ),
+                        [
+                            Environment.ProcessId.ToString(),
+                            DebugMode ? "1" : "0",
+                            WaitMode == WaitMode.BusySpin ? "--wait=spin" : "--wait=hybrid",
+                            $"--spin={SpinCount}",
+                            $"--bulk={BulkSize}",
+                            $"--name={channelName}",
+                            $"--channels={channelCount}",
+                            ShadowWrites ? "--shadow-writes" : "",
+                            ReduceBatches ? "--reduce-batches" : "",
+                            PatternCacheDirectory != null
+                                ? $"\"--pattern-cache={PatternCacheDirectory}\""
+                                : "",
+                            TraceDirectory != null ? $"\"--trace={TraceDirectory}\"" : "",
+                            TelemetryCommands is { Count: > 0 }
+                                ? $"\"--telemetry={string.Join(";", TelemetryCommands)}\" "
+                                    + $"--telemetry-period={Math.Max(1, (int)TelemetryPeriod.TotalMilliseconds)}"
+                                : "",
+                            BridgeCpus is { Count: > 0 } ? $"--cpu={string.Join(",", BridgeCpus)}"
+                                : AutoAffinity ? "--cpu=auto"
+                                : "",
+                            PriorityClass is { } priorityClass
+                                ? $"--priority={PriorityArgument(priorityClass)}"
+                                : "",
+                            HighThreadPriority ? "--thread-priority=high" : "",
+                            MmcssTask != null ? $"\"--mmcss={MmcssTask}\"" : "",
+                            BridgeArguments ?? "",
+                        ]
+                    ).TrimEnd(),
                     UseShellExecute = DebugMode,
                     CreateNoWindow = !DebugMode,
                 };
@@ -98,88 +372,408 @@ internal partial class UltraFastIPCClient : IDisposable
             bridgeProcess =
                 Process.Start(startInfo)
                 ?? throw new InvalidOperationException("Failed to start bridge process");
+            ownsBridge = true;
 
-            // Wait for process initialization
-            Thread.Sleep(1000);
+            WaitUntilReady(ready);
+            Connect();
+            return true;
+        }
+        catch (Exception ex)
+        {
+            Console.WriteLine($"Startup failed: {ex.Message}");
+            return false;
+        }
+    }
 
-            // Connect to shared memory
-            try
+    private static string PriorityArgument(ProcessPriorityClass priorityClass) =>
+        priorityClass switch
+        {
+            ProcessPriorityClass.Idle => "idle",
+            ProcessPriorityClass.BelowNormal => "below_normal",
+            ProcessPriorityClass.AboveNormal => "above_normal",
+            ProcessPriorityClass.High => "high",
+            ProcessPriorityClass.RealTime => "realtime",
+            _ => "normal",
+        };
+
+    // The bridge sets <name>_Ready once every channel is mapped, or exits if one fails
+    private void WaitUntilReady(EventWaitHandle ready)
+    {
+        long start = Stopwatch.GetTimestamp();
+        while (!ready.WaitOne(StartupPollInterval))
+        {
+            if (bridgeProcess!.HasExited)
             {
-                mmf = MemoryMappedFile.OpenExisting(sharedMemoryName);
-                accessor = mmf.CreateViewAccessor(0, Marshal.SizeOf<SharedMemoryLayout>());
-
-                Console.WriteLine("Successfully connected to shared memory");
-                return true;
+                throw new InvalidOperationException(
+                    $"Bridge process exited with code {bridgeProcess.ExitCode} during startup"
+                );
             }
-            catch (FileNotFoundException)
+            if (Stopwatch.GetElapsedTime(start) > StartupTimeout)
+            {
+                throw new TimeoutException(
+                    $"Bridge process was not ready within {StartupTimeout.TotalSeconds:F1} s"
+                );
+            }
+        }
+    }
+
+    // The bridge process this channel talks to, watched while waiting for responses
+    internal Process? BridgeProcess => bridgeProcess;
+
+    [System.Diagnostics.CodeAnalysis.SuppressMessage(
+        "Interoperability",
+        "CA1416:Validate platform compatibility",
+        Justification = "The bridge and its named mappings only exist on Windows"
+    )]
+    // Maps the channel of a running bridge
+    internal void Connect(Process? bridge = null)
+    {
+        bridgeProcess ??= bridge;
+        try
+        {
+            mmf = MemoryMappedFile.OpenExisting(sharedMemoryName);
+            accessor = mmf.CreateViewAccessor(0, SharedMemoryLayout.Size);
+
+            byte* view = null;
+            accessor.SafeMemoryMappedViewHandle.AcquirePointer(ref view);
+            layout = (SharedMemoryLayout*)(view + accessor.PointerOffset);
+
+            uint layoutVersion = layout->layout_version;
+            uint layoutSize = layout->layout_size;
+            if (layoutVersion != LayoutVersion || layoutSize != SharedMemoryLayout.Size)
             {
                 throw new InvalidOperationException(
-                    "Failed to connect to shared memory, please ensure the 32-bit program is running"
+                    $"Bridge uses shared memory layout {layoutVersion} ({layoutSize} bytes), "
+                        + $"expected {LayoutVersion} ({SharedMemoryLayout.Size} bytes)"
                 );
             }
+
+            bulkSlotSize = (int)layout->bulk_slot_size;
+            ClientCpu = PreferredClientCpu ?? layout->client_cpu;
+            if (bulkSlotSize > 0)
+            {
+                bulkMmf = MemoryMappedFile.OpenExisting(sharedMemoryName + "_Bulk");
+                bulkAccessor = bulkMmf.CreateViewAccessor(0, (long)bulkSlotSize * SlotCount);
+
+                byte* bulkView = null;
+                bulkAccessor.SafeMemoryMappedViewHandle.AcquirePointer(ref bulkView);
+                bulk = bulkView + bulkAccessor.PointerOffset;
+            }
+
+            statsMmf = MemoryMappedFile.OpenExisting(
+                sharedMemoryName + "_Stats",
+                MemoryMappedFileRights.Read
+            );
+            statsAccessor = statsMmf.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+
+            byte* statsView = null;
+            statsAccessor.SafeMemoryMappedViewHandle.AcquirePointer(ref statsView);
+            StatsPage = statsView + statsAccessor.PointerOffset;
+            PE32Stats.CheckLayout(StatsPage);
+
+            requestEvent = EventWaitHandle.OpenExisting(sharedMemoryName + "_RequestEvent");
+            responseEvent = EventWaitHandle.OpenExisting(sharedMemoryName + "_ResponseEvent");
+
+            Console.WriteLine($"Successfully connected to shared memory {sharedMemoryName}");
         }
-        catch (Exception ex)
+        catch (Exception ex) when (ex is FileNotFoundException or WaitHandleCannotBeOpenedException)
         {
-            Console.WriteLine($"Startup failed: {ex.Message}");
-            return false;
+            throw new InvalidOperationException(
+                "Failed to connect to shared memory, please ensure the 32-bit program is running"
+            );
+        }
+    }
+
+    // Applies ClientCpu, HighThreadPriority and MmcssTask to the calling thread
+    internal void PinCallingThread()
+    {
+        if (ClientCpu >= AffinityCpus)
+        {
+            throw new InvalidOperationException(
+                $"CPU {ClientCpu} is outside the {AffinityCpus} CPUs an affinity mask holds"
+            );
+        }
+        if (ClientCpu >= 0 && SetThreadAffinityMask(GetCurrentThread(), (nuint)1 << ClientCpu) == 0)
+        {
+            throw new Win32Exception(Marshal.GetLastPInvokeError(), $"Pinning to CPU {ClientCpu} failed");
+        }
+        if (HighThreadPriority)
+        {
+            Thread.CurrentThread.Priority = ThreadPriority.Highest;
+        }
+        uint taskIndex = 0;
+        if (MmcssTask != null && AvSetMmThreadCharacteristics(MmcssTask, ref taskIndex) == 0)
+        {
+            throw new Win32Exception(
+                Marshal.GetLastPInvokeError(),
+                $"MMCSS registration as \"{MmcssTask}\" failed"
+            );
         }
     }
 
     public string SendRequestUltraFast(string request, int timeoutMicroseconds = 1000000)
     {
-        if (accessor == null)
-            throw new InvalidOperationException("IPC client is not initialized");
+        // Prepare request data
+        if (Encoding.UTF8.GetByteCount(request) > BufferSize)
+            throw new ArgumentException("Request data is too large");
+        Span<byte> text = stackalloc byte[BufferSize];
+        int length = Encoding.UTF8.GetBytes(request, text);
 
-        long startTime = GetMicroseconds();
+        uint sequence = Post(text.Slice(0, length), ProtocolVersion.Text, reserve: true);
+        try
+        {
+            RingSlot* slot = WaitForResponse(sequence, timeoutMicroseconds);
+            lastTimings = new PE32CallTimings(slot, Stopwatch.GetTimestamp());
+            return Encoding.UTF8.GetString(slot->response_data, (int)slot->response_size);
+        }
+        finally
+        {
+            ReleaseSlot(sequence);
+        }
+    }
 
+    public BinaryResponseReader SendRequestBinary(
+        BinaryRequestWriter request,
+        int timeoutMicroseconds = 1000000
+    )
+    {
+        return Complete(Post(request.Written, ProtocolVersion.Binary, reserve: true), timeoutMicroseconds);
+    }
+
+    // Copies bulkInput into the slot's bulk region before the request is published,
+    // for requests with a WriteBulk() argument
+    internal BinaryResponseReader SendRequestBinary(
+        BinaryRequestWriter request,
+        ReadOnlySpan<byte> bulkInput,
+        int timeoutMicroseconds = 1000000
+    )
+    {
+        uint sequence = Post(request.Written, ProtocolVersion.Binary, reserve: true, bulkInput);
+        return Complete(sequence, timeoutMicroseconds);
+    }
+
+    // Sends a request encoded earlier, e.g. one recorded by PE32Prologue
+    internal BinaryResponseReader SendRequestBinary(
+        ReadOnlySpan<byte> request,
+        int timeoutMicroseconds = 1000000
+    )
+    {
+        return Complete(Post(request, ProtocolVersion.Binary, reserve: true), timeoutMicroseconds);
+    }
+
+    // Queues a request the server runs without answering. A failure is latched
+    // and thrown from the next Complete() or Flush().
+    internal void PostWithoutReply(BinaryRequestWriter request)
+    {
+        Post(request.NoReply().Written, ProtocolVersion.Binary, reserve: false);
+    }
+
+    // Same for a request encoded earlier with the no-reply flag already set
+    internal void PostWithoutReply(ReadOnlySpan<byte> request)
+    {
+        Post(request, ProtocolVersion.Binary, reserve: false);
+    }
+
+    // Posts a request PE32AsyncPoller completes, its slot stays reserved until the poller has read it
+    internal void PostAsync<T>(
+        BinaryRequestWriter request,
+        PE32AsyncCall<T> call,
+        PE32AsyncPoller poller
+    )
+    {
+        uint sequence = Post(request.Written, ProtocolVersion.Binary, reserve: true);
+        call.Posted(this, sequence);
+        poller.Add(call);
+    }
+
+    // Points reader at the response of an async call if it has arrived, called by the poller
+    internal bool TryReadResponse(uint sequence, BinaryResponseReader reader)
+    {
+        RingSlot* slot = Slot(sequence);
+        if (!Answered(slot, sequence))
+            return false;
+
+        byte* slotBulk = bulk != null ? bulk + (long)((sequence - 1) % SlotCount) * bulkSlotSize : null;
+        reader.Reset(slot->response_data, (int)slot->response_size, slotBulk, bulkSlotSize);
+        return true;
+    }
+
+    // Hands the slot back to Post once the response has been read, or the call has failed
+    internal void ReleaseSlot(uint sequence)
+    {
+        Interlocked.CompareExchange(ref reservedSlots[(sequence - 1) % SlotCount], 0, sequence);
+    }
+
+    // Waits until every posted request has run, then reports a latched failure
+    internal void Flush(int timeoutMicroseconds = 1000000)
+    {
+        uint posted = Volatile.Read(ref postedSequence);
+        if (posted != 0)
+            WaitForResponse(posted, timeoutMicroseconds);
+
+        ThrowIfStickyError();
+    }
+
+    private void ThrowIfStickyError()
+    {
+        int stickyError = Volatile.Read(ref layout->sticky_error);
+        if (stickyError == 0)
+            return;
+
+        var opcode = (PE32Opcode)layout->sticky_error_opcode;
+        uint sequence = layout->sticky_error_sequence;
+
+        // Cleared so the server may latch the next failure. Only the thread that clears it throws.
+        if (Interlocked.CompareExchange(ref layout->sticky_error, 0, stickyError) != stickyError)
+            return;
+
+        throw new InvalidOperationException(
+            $"{opcode} (request {sequence}) failed: {(BinaryStatus)stickyError}"
+        );
+    }
+
+    // Waits for a posted request and copies its response to the calling thread's reader, which
+    // stays valid until the thread's next call. A bulk payload is read in place and stays valid
+    // until SlotCount newer requests have been posted.
+    private BinaryResponseReader Complete(uint sequence, int timeoutMicroseconds)
+    {
+        BinaryResponseReader reader;
         try
         {
-            // Prepare request data
-            byte[] requestBytes = Encoding.UTF8.GetBytes(request);
-            if (requestBytes.Length > 4096)
-                throw new ArgumentException("Request data is too large");
+            RingSlot* slot = WaitForResponse(sequence, timeoutMicroseconds);
+            lastTimings = new PE32CallTimings(slot, Stopwatch.GetTimestamp());
+
+            threadResponse ??= new BinaryResponseReader();
+            threadResponseData ??= GC.AllocateUninitializedArray<byte>(BufferSize, pinned: true);
+            int size = (int)Math.Min(slot->response_size, (uint)BufferSize);
+            new ReadOnlySpan<byte>(slot->response_data, size).CopyTo(threadResponseData);
+
+            // Pinned, so the address stays valid
+            byte* data = (byte*)Unsafe.AsPointer(ref MemoryMarshal.GetArrayDataReference(threadResponseData));
+            byte* slotBulk = bulk != null ? bulk + (long)((sequence - 1) % SlotCount) * bulkSlotSize : null;
+            reader = threadResponse.Reset(data, size, slotBulk, bulkSlotSize);
+        }
+        finally
+        {
+            ReleaseSlot(sequence);
+        }
 
-            uint currentSequence = ++sequenceCounter;
+        // Earlier fire-and-forget requests have all run by now
+        ThrowIfStickyError();
+        return reader;
+    }
 
-            // Write request to shared memory - these operations are memory level and extremely fast
-            accessor.Write(12, (uint)requestBytes.Length); // request_size position
-            accessor.WriteArray(20, requestBytes, 0, requestBytes.Length); // request_data position
+    private RingSlot* Slot(uint sequence)
+    {
+        return &layout->slots + (sequence - 1) % SlotCount;
+    }
 
-            // Atomically set sequence number and flag
-            accessor.Write(8, currentSequence); // sequence_id
-            accessor.Write(0, (uint)1); // request_flag = 1
+    // Claims the next sequence, copies the request into its slot and publishes it. Threads that
+    // post at once each wait only for their own slot, and the server runs the requests in sequence
+    // order. With reserve set the slot stays with the caller until ReleaseSlot().
+    // The request is length delimited, so nothing in the slot has to be cleared.
+    private uint Post(
+        ReadOnlySpan<byte> request,
+        ProtocolVersion protocol,
+        bool reserve,
+        ReadOnlySpan<byte> bulkInput = default
+    )
+    {
+        if (layout == null)
+            throw new InvalidOperationException("IPC client is not initialized");
+        if (request.Length > BufferSize)
+            throw new ArgumentException("Request data is too large");
+        if (bulkInput.Length > bulkSlotSize)
+            throw new ArgumentException("Bulk input exceeds the bulk region of the slot");
+
+        // Past the claim nothing may throw but a lost bridge, the server would wait for the gap forever
+        uint sequence = Interlocked.Increment(ref postedSequence);
+        uint index = (sequence - 1) % SlotCount;
+        RingSlot* slot = Slot(sequence);
+
+        // The slot belongs to the server until the request it held last is answered,
+        // and to that request's owner until it has read the answer
+        if (sequence > SlotCount)
+            WaitForResponse(sequence - SlotCount, Timeout.Infinite);
+        while (Volatile.Read(ref reservedSlots[index]) != 0)
+        {
+            Thread.Yield();
+        }
+        if (reserve)
+            Volatile.Write(ref reservedSlots[index], sequence);
 
-            // Wait for response - use busy waiting to get the lowest latency
-            long timeoutTime = startTime + timeoutMicroseconds;
+        // Write request to shared memory - these operations are memory level and extremely fast
+        if (!bulkInput.IsEmpty)
+        {
+            byte* slotBulk = bulk + (long)index * bulkSlotSize;
+            bulkInput.CopyTo(new Span<byte>(slotBulk, bulkSlotSize));
+        }
+        request.CopyTo(new Span<byte>(slot->request_data, BufferSize));
+        slot->request_size = (uint)request.Length;
+        slot->protocol_version = (uint)protocol;
+        slot->submit_time = Stopwatch.GetTimestamp();
 
-            while (GetMicroseconds() < timeoutTime || DebugMode)
-            {
-                uint responseFlag = accessor.ReadUInt32(4); // response_flag position
-                uint requestFlag = accessor.ReadUInt32(0); // requestFlag position
+        // Publish last, the release write keeps the stores above ahead of it
+        Volatile.Write(ref slot->request_sequence, sequence);
 
-                if (responseFlag == 1 && requestFlag == 0)
-                {
-                    // Read response
-                    uint responseSize = accessor.ReadUInt32(16); // response_size position
-                    byte[] responseBytes = new byte[responseSize];
-                    accessor.ReadArray(4116, responseBytes, 0, (int)responseSize); // response_data position
+        // The barrier orders the publish before the check, pairing with the server's re-check
+        Interlocked.MemoryBarrier();
+        if (Volatile.Read(ref layout->server_waiting) != 0)
+            requestEvent!.Set();
+
+        return sequence;
+    }
 
-                    // Clear response flag
-                    accessor.Write(4, (uint)0); // response_flag = 0
+    // Whether the slot holds the response of sequence or of a later request. Later ones only
+    // get there once sequence has been answered and read, so either way it has run.
+    private static bool Answered(RingSlot* slot, uint sequence)
+    {
+        return (int)(Volatile.Read(ref slot->response_sequence) - sequence) >= 0;
+    }
+
+    // Spins until the server has answered the given request, returns its slot.
+    // Timeout.Infinite waits as long as the bridge runs.
+    private RingSlot* WaitForResponse(uint sequence, int timeoutMicroseconds)
+    {
+        RingSlot* slot = Slot(sequence);
+        long startTime = GetMicroseconds();
 
-                    // Clear request data
-                    byte[] emptyRequestBytes = new byte[requestBytes.Length];
-                    accessor.WriteArray(20, emptyRequestBytes, 0, requestBytes.Length);
+        try
+        {
+            // Wait for response - use busy waiting to get the lowest latency
+            long timeoutTime =
+                timeoutMicroseconds == Timeout.Infinite ? long.MaxValue : startTime + timeoutMicroseconds;
 
-                    string response = Encoding.UTF8.GetString(responseBytes);
+            int spins = 0;
 
-                    return response;
+            while (GetMicroseconds() < timeoutTime || DebugMode)
+            {
+                if (Answered(slot, sequence))
+                {
+                    return slot;
                 }
 
-                // Extremely short CPU yield, but maintains high responsiveness
-                Thread.Yield();
+                if (WaitMode == WaitMode.BusySpin)
+                {
+                    // Extremely short CPU yield, but maintains high responsiveness
+                    Thread.Yield();
+                    if ((++spins & BridgeCheckInterval) == 0)
+                        ThrowIfBridgeExited(sequence);
+                }
+                else if (spins++ < SpinCount)
+                {
+                    Thread.SpinWait(1);
+                }
+                else
+                {
+                    long remaining = (timeoutTime - GetMicroseconds()) / 1000;
+                    BlockOnce(slot, sequence, DebugMode ? 100 : (int)Math.Clamp(remaining, 1, 100));
+                    ThrowIfBridgeExited(sequence);
+                }
             }
 
+            ThrowIfBridgeExited(sequence);
+
             throw new TimeoutException($"Request timed out ({timeoutMicroseconds / 1000_000.0} s)");
         }
         catch (Exception ex)
@@ -189,19 +783,104 @@ internal partial class UltraFastIPCClient : IDisposable
         }
     }
 
+    // One blocking wait of a Hybrid waiter, at most timeoutMilliseconds. The server signals the
+    // auto-reset response event once per response, so a single leader blocks on it and wakes the
+    // other waiters, which then look at their own slots.
+    private void BlockOnce(RingSlot* slot, uint sequence, int timeoutMilliseconds)
+    {
+        lock (waitLock)
+        {
+            if (Answered(slot, sequence))
+                return;
+            if (waitLeader)
+            {
+                Monitor.Wait(waitLock, timeoutMilliseconds);
+                return;
+            }
+            waitLeader = true;
+        }
+
+        try
+        {
+            // Announce first and look again, the server may have answered in between. Waiters
+            // that looked before the announcement look again too.
+            Volatile.Write(ref layout->client_waiting, 1u);
+            Interlocked.MemoryBarrier();
+            lock (waitLock)
+            {
+                Monitor.PulseAll(waitLock);
+            }
+            if (!Answered(slot, sequence))
+                responseEvent!.WaitOne(timeoutMilliseconds);
+            Volatile.Write(ref layout->client_waiting, 0u);
+        }
+        finally
+        {
+            lock (waitLock)
+            {
+                waitLeader = false;
+                Monitor.PulseAll(waitLock);
+            }
+        }
+    }
+
+    // A dead bridge never answers, so waiting for it stops early instead of running into the timeout
+    private void ThrowIfBridgeExited(uint sequence)
+    {
+        if (BridgeLost(sequence) is { } lost)
+            throw lost;
+    }
+
+    // The exception for a request the dead bridge will never answer, null while it runs
+    internal PE32BridgeLostException? BridgeLost(uint sequence)
+    {
+        if (bridgeProcess == null || !bridgeProcess.HasExited)
+            return null;
+
+        return new PE32BridgeLostException(
+            $"Bridge process exited with code {bridgeProcess.ExitCode} before answering request {sequence}"
+        );
+    }
+
     public void Dispose()
     {
         if (!disposed)
         {
+            if (layout != null)
+            {
+                accessor!.SafeMemoryMappedViewHandle.ReleasePointer();
+                layout = null;
+            }
             accessor?.Dispose();
             mmf?.Dispose();
-
-            if (bridgeProcess != null && !bridgeProcess.HasExited)
+            if (bulk != null)
             {
-                bridgeProcess.Kill();
-                bridgeProcess.WaitForExit(1000);
+                bulkAccessor!.SafeMemoryMappedViewHandle.ReleasePointer();
+                bulk = null;
+            }
+            bulkAccessor?.Dispose();
+            bulkMmf?.Dispose();
+            if (StatsPage != null)
+            {
+                statsAccessor!.SafeMemoryMappedViewHandle.ReleasePointer();
+                StatsPage = null;
+            }
+            statsAccessor?.Dispose();
+            statsMmf?.Dispose();
+            if (OperatingSystem.IsWindows())
+                Telemetry?.Dispose();
+            requestEvent?.Dispose();
+            responseEvent?.Dispose();
+
+            if (ownsBridge && bridgeProcess != null)
+            {
+                if (!bridgeProcess.HasExited)
+                {
+                    bridgeProcess.Kill();
+                    bridgeProcess.WaitForExit(1000);
+                }
+                bridgeProcess.Dispose();
             }
-            bridgeProcess?.Dispose();
 
             disposed = true;
         }
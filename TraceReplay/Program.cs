@@ -0,0 +1,154 @@
+﻿using System.Diagnostics;
+using System.Globalization;
+using System.Text;
+using PE32Proxy;
+using TraceReplay;
+
+// Sends the requests of a trace recorded with the bridge's --trace through a new bridge,
+// usually one built with the mock backend, and compares the replayed times and statuses
+// with the recorded ones. Requests with a bulk input are skipped, the trace does not hold it.
+var settings = ReplaySettings.Parse(args);
+var trace = TraceFile.Read(settings.TracePath);
+if (trace.CommandHash != PE32Proxy.PE32Proxy.CommandHash)
+{
+    Console.Error.WriteLine($"{settings.TracePath} was recorded by a bridge with other commands");
+    return 1;
+}
+
+var commands = new SortedDictionary<string, ReplayedCommand>();
+int skipped = 0;
+int failures = 0;
+using (
+    var pe32 = new PE32Proxy.PE32Proxy(
+        new PE32ProxyOptions
+        {
+            WaitMode = settings.WaitMode,
+            ChannelCount = settings.Channels ?? trace.ChannelCount,
+            BridgePath = settings.BridgePath,
+            BridgeArguments = settings.BridgeArguments,
+        }
+    )
+)
+{
+    long firstPickup = trace.Records.Count > 0 ? trace.Records[0].PickupTime : 0;
+    long start = Stopwatch.GetTimestamp();
+    foreach (var record in trace.Records)
+    {
+        if (record.BulkInput)
+        {
+            skipped++;
+            continue;
+        }
+        if (settings.RecordedTiming)
+        {
+            var due = TimeSpan.FromSeconds((double)(record.PickupTime - firstPickup) / trace.TicksPerSecond);
+            while (Stopwatch.GetElapsedTime(start) < due)
+            {
+                Thread.Yield();
+            }
+        }
+
+        string name = record.Binary ? PE32Proxy.PE32Proxy.CommandName(record.Opcode) : "text";
+        bool noReply = record.Binary && record.Request.Length >= 4 && (record.Request[3] & 0x01) != 0;
+        int status;
+        long before = Stopwatch.GetTimestamp();
+        try
+        {
+            status = record.Binary
+                ? (int)pe32.SendRecorded(record.Channel, record.Request)
+                : SendText(pe32, record);
+        }
+        catch (InvalidOperationException)
+        {
+            // An earlier fire-and-forget request failed, the bridge reports it with the next call
+            failures++;
+            continue;
+        }
+        long roundTrip = Stopwatch.GetTimestamp() - before;
+
+        if (!commands.TryGetValue(name, out var command))
+            commands[name] = command = new ReplayedCommand();
+        command.Add(record, trace.TicksPerSecond, status, noReply ? null : pe32.LastCallTimings, roundTrip);
+    }
+
+    try
+    {
+        pe32.Flush();
+    }
+    catch (InvalidOperationException)
+    {
+        failures++;
+    }
+}
+
+var csv = new StringBuilder(
+    "command,count,round_trip_mean_us,round_trip_p99_us,bridge_mean_us,recorded_bridge_mean_us,"
+        + "dll_mean_us,recorded_dll_mean_us,status_changed\n"
+);
+foreach (var (name, command) in commands)
+{
+    csv.AppendLine(string.Join(',', [name, .. command.Columns()]));
+}
+if (settings.Output == null)
+    Console.Write(csv);
+else
+    File.WriteAllText(settings.Output, csv.ToString());
+
+Console.Error.WriteLine(
+    $"Replayed {trace.Records.Count - skipped} of {trace.Records.Count} requests, {skipped} with bulk input skipped, "
+        + $"{trace.Dropped} dropped while recording, {failures} fire-and-forget failures"
+);
+return 0;
+
+static int SendText(PE32Proxy.PE32Proxy pe32, TraceRecord record)
+{
+    pe32.SendRecordedText(record.Channel, Encoding.UTF8.GetString(record.Request));
+    return 0;
+}
+
+// Replayed and recorded times of one command, fire-and-forget requests are only counted
+internal sealed class ReplayedCommand
+{
+    private readonly List<double> roundTripUs = [];
+    private double bridgeUs;
+    private double dllUs;
+    private double recordedBridgeUs;
+    private double recordedDllUs;
+    private int timed;
+    private int count;
+    private int statusChanged;
+
+    public void Add(TraceRecord record, long ticksPerSecond, int status, PE32CallTimings? timings, long roundTrip)
+    {
+        count++;
+        if (status != record.Status)
+            statusChanged++;
+        if (timings is not { } replayed)
+            return;
+
+        timed++;
+        roundTripUs.Add(Stopwatch.GetElapsedTime(0, roundTrip).TotalMicroseconds);
+        bridgeUs += (replayed.Dispatch + replayed.Dll + replayed.Encode).TotalMicroseconds;
+        dllUs += replayed.Dll.TotalMicroseconds;
+        recordedBridgeUs += record.BridgeTicks * 1e6 / ticksPerSecond;
+        recordedDllUs += record.DllTicks * 1e6 / ticksPerSecond;
+    }
+
+    public IEnumerable<string> Columns()
+    {
+        roundTripUs.Sort();
+        double p99 = timed > 0 ? roundTripUs[Math.Clamp((int)Math.Ceiling(0.99 * timed) - 1, 0, timed - 1)] : 0;
+        int divisor = Math.Max(1, timed);
+        return
+        [
+            count.ToString(CultureInfo.InvariantCulture),
+            (roundTripUs.Sum() / divisor).ToString("F3", CultureInfo.InvariantCulture),
+            p99.ToString("F3", CultureInfo.InvariantCulture),
+            (bridgeUs / divisor).ToString("F3", CultureInfo.InvariantCulture),
+            (recordedBridgeUs / divisor).ToString("F3", CultureInfo.InvariantCulture),
+            (dllUs / divisor).ToString("F3", CultureInfo.InvariantCulture),
+            (recordedDllUs / divisor).ToString("F3", CultureInfo.InvariantCulture),
+            statusChanged.ToString(CultureInfo.InvariantCulture),
+        ];
+    }
+}
@@ -0,0 +1,64 @@
+﻿using PE32Proxy;
+
+namespace TraceReplay;
+
+// Command line of the replay:
+// <trace> --timing=asap|recorded --channels=K --wait=spin|hybrid --output=file
+// --bridge=path --bridge-args="--mock-latency=5"
+internal sealed class ReplaySettings
+{
+    public string TracePath { get; private set; } = "";
+
+    // Keeps the gaps between the recorded pickups instead of sending back to back
+    public bool RecordedTiming { get; private set; }
+
+    // Defaults to the channel count of the bridge that recorded the trace
+    public int? Channels { get; private set; }
+
+    public WaitMode WaitMode { get; private set; } = WaitMode.Hybrid;
+
+    public string? Output { get; private set; }
+
+    public string? BridgePath { get; private set; }
+
+    public string? BridgeArguments { get; private set; }
+
+    public static ReplaySettings Parse(string[] args)
+    {
+        var settings = new ReplaySettings();
+        foreach (string arg in args)
+        {
+            string[] option = arg.Split('=', 2);
+            string value = option.Length > 1 ? option[1] : "";
+            switch (option[0])
+            {
+                case "--timing":
+                    settings.RecordedTiming = value == "recorded";
+                    break;
+                case "--channels":
+                    settings.Channels = Math.Max(1, int.Parse(value));
+                    break;
+                case "--wait":
+                    settings.WaitMode = value == "spin" ? WaitMode.BusySpin : WaitMode.Hybrid;
+                    break;
+                case "--output":
+                    settings.Output = value;
+                    break;
+                case "--bridge":
+                    settings.BridgePath = value;
+                    break;
+                case "--bridge-args":
+                    settings.BridgeArguments = value;
+                    break;
+                default:
+                    if (arg.StartsWith("--") || settings.TracePath != "")
+                        throw new ArgumentException($"Unknown option {arg}");
+                    settings.TracePath = arg;
+                    break;
+            }
+        }
+        if (settings.TracePath == "")
+            throw new ArgumentException("Usage: TraceReplay <trace> [--timing=asap|recorded] [--bridge=path]");
+        return settings;
+    }
+}
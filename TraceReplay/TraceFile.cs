@@ -0,0 +1,104 @@
+﻿using System.Buffers.Binary;
+
+namespace TraceReplay;
+
+// One request of a trace, see TraceRecord in UltraFastIPC/TraceRing.h
+internal sealed record TraceRecord(
+    int Channel,
+    uint Sequence,
+    bool Binary,
+    bool BulkInput,
+    int Status,
+    long PickupTime,
+    long DllEnterTime,
+    long DllExitTime,
+    long PublishTime,
+    byte[] Request
+)
+{
+    public ushort Opcode => Binary && Request.Length >= 2 ? BinaryPrimitives.ReadUInt16LittleEndian(Request) : (ushort)0;
+
+    // Pickup to publish in the bridge that recorded it
+    public long BridgeTicks => PublishTime - PickupTime;
+
+    public long DllTicks => DllEnterTime != 0 ? DllExitTime - DllEnterTime : 0;
+}
+
+// A file written by the bridge's --trace, the layouts must match UltraFastIPC/TraceRing.h
+internal sealed class TraceFile
+{
+    private const uint Magic = 0x52544655;
+    private const uint LayoutVersion = 1;
+    private const int RecordHeaderSize = 56;
+    private const uint ProtocolBinary = 1;
+    private const byte FlagBulkInput = 0x01;
+
+    public int ChannelCount { get; private init; }
+
+    public long TicksPerSecond { get; private init; }
+
+    public uint CommandHash { get; private init; }
+
+    public long Dropped { get; private init; }
+
+    // In pickup order over all channels, the file only keeps each channel in order
+    public IReadOnlyList<TraceRecord> Records { get; private init; } = [];
+
+    public static TraceFile Read(string path)
+    {
+        // The bridge may still be writing it
+        using var stream = new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.ReadWrite);
+        byte[] file = new byte[stream.Length];
+        stream.ReadExactly(file);
+        var header = file.AsSpan();
+        if (
+            header.Length < 56
+            || BinaryPrimitives.ReadUInt32LittleEndian(header) != Magic
+            || BinaryPrimitives.ReadUInt32LittleEndian(header[4..]) != LayoutVersion
+        )
+        {
+            throw new InvalidDataException($"{path} is not a trace file of this bridge version");
+        }
+
+        int headerSize = BinaryPrimitives.ReadInt32LittleEndian(header[8..]);
+        long used = BinaryPrimitives.ReadInt64LittleEndian(header[32..]);
+
+        var records = new List<TraceRecord>();
+        var rest = header.Slice(headerSize, (int)Math.Min(used, header.Length - headerSize));
+        while (rest.Length >= RecordHeaderSize)
+        {
+            int size = BinaryPrimitives.ReadInt32LittleEndian(rest);
+            if (size < RecordHeaderSize || size > rest.Length)
+                break;
+
+            var record = rest[..size];
+            int requestSize = BinaryPrimitives.ReadInt32LittleEndian(record[48..]);
+            if (requestSize < 0 || RecordHeaderSize + requestSize > size)
+                break;
+            records.Add(
+                new TraceRecord(
+                    BinaryPrimitives.ReadUInt16LittleEndian(record[8..]),
+                    BinaryPrimitives.ReadUInt32LittleEndian(record[4..]),
+                    record[10] == ProtocolBinary,
+                    (record[11] & FlagBulkInput) != 0,
+                    BinaryPrimitives.ReadInt32LittleEndian(record[12..]),
+                    BinaryPrimitives.ReadInt64LittleEndian(record[16..]),
+                    BinaryPrimitives.ReadInt64LittleEndian(record[24..]),
+                    BinaryPrimitives.ReadInt64LittleEndian(record[32..]),
+                    BinaryPrimitives.ReadInt64LittleEndian(record[40..]),
+                    record.Slice(RecordHeaderSize, requestSize).ToArray()
+                )
+            );
+            rest = rest[size..];
+        }
+
+        return new TraceFile
+        {
+            ChannelCount = BinaryPrimitives.ReadInt32LittleEndian(header[12..]),
+            TicksPerSecond = BinaryPrimitives.ReadInt64LittleEndian(header[16..]),
+            CommandHash = BinaryPrimitives.ReadUInt32LittleEndian(header[24..]),
+            Dropped = BinaryPrimitives.ReadInt64LittleEndian(header[40..]),
+            Records = [.. records.OrderBy(record => record.PickupTime)],
+        };
+    }
+}
@@ -0,0 +1,186 @@
+// BatchReducer.h - Plans a batch before it runs, with --reduce-batches
+//
+// Generated test programs repeat themselves. A shadowed write that a later
+// write of the same target overwrites is answered without the DLL, as long as
+// nothing else on its board runs in between. It reports NotRun instead when the
+// batch stops before the overwriting write succeeded. Between barriers the commands are
+// grouped per board, each board keeps the order of its own commands. The rules
+// come from kDispatchPolicies and kShadowRoles, the results still go back in
+// the order the client sent the commands.
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include "BinaryProtocol.h"
+#include "CommandRegistry.h"
+#include "DispatchPolicy.h"
+#include "ShadowRegisters.h"
+
+// The smallest sub-request is its size and a header without arguments
+constexpr uint32_t MAX_BATCH_ENTRIES = MESSAGE_BUFFER_SIZE / (sizeof(uint16_t) + sizeof(BinaryRequestHeader));
+
+// Packed size of the arguments of a command, 0 when one of them has no fixed size
+constexpr uint32_t FixedArgumentsSize(const CommandInfo& command) {
+	uint32_t size = 0;
+	for (size_t k = 0; k < command.argCount; k++) {
+		switch (command.argTypes[k]) {
+		case WireType::Int32:
+		case WireType::UInt32:
+			size += sizeof(int32_t);
+			break;
+		case WireType::Double:
+			size += sizeof(double);
+			break;
+		default:
+			return 0;
+		}
+	}
+	return size;
+}
+
+struct BatchEntry {
+	const char* data;           // The complete sub-request, header first
+	uint16_t size;
+	BinaryRequestHeader header;
+	bool barrier;               // Global, unbound, a poll or malformed, nothing moves across it
+	bool coalesced;             // Overwritten later in the batch, answered without the DLL
+	uint16_t overwrittenBy;     // Index of the write that overwrites a coalesced one
+	int32_t board;              // bdn of a board command
+};
+
+class BatchReducer {
+public:
+	// Set by --reduce-batches
+	static inline bool enabled = false;
+
+	// Reads all sub-requests of the batch, false if it is malformed
+	bool Parse(BinaryReader& in, uint16_t batchCount) {
+		if (batchCount > MAX_BATCH_ENTRIES) {
+			return false;
+		}
+		count = batchCount;
+		for (uint16_t i = 0; i < count; i++) {
+			BatchEntry& entry = entries[i];
+			entry.size = in.Read<uint16_t>();
+			entry.data = in.ReadBytes(entry.size);
+			if (entry.data == nullptr) {
+				return false;
+			}
+			entry.header = {};
+			entry.coalesced = false;
+			entry.overwrittenBy = 0;
+			entry.board = 0;
+			entry.barrier = true;
+			if (entry.size < sizeof(BinaryRequestHeader)) {
+				continue;
+			}
+			memcpy(&entry.header, entry.data, sizeof(entry.header));
+			if (entry.header.opcode >= (uint16_t)Opcode::Count || entry.header.flags != 0
+				|| entry.size < sizeof(BinaryRequestHeader) + sizeof(int32_t)) {
+				continue;
+			}
+			DispatchPolicy policy = kDispatchPolicies[entry.header.opcode];
+			if (policy == DispatchPolicy::BoardExclusive || policy == DispatchPolicy::ReadOnlyConcurrent) {
+				memcpy(&entry.board, entry.data + sizeof(BinaryRequestHeader), sizeof(entry.board));
+				entry.barrier = false;
+			}
+		}
+		return in.AtEnd();
+	}
+
+	// Marks the overwritten writes and plans the order to run the batch in
+	void Reduce() {
+		for (uint16_t i = 0; i < count; i++) {
+			entries[i].overwrittenBy = OverwrittenBy(i);
+			entries[i].coalesced = entries[i].overwrittenBy != 0;
+		}
+
+		reordered = false;
+		uint16_t planned = 0;
+		uint16_t segment = 0;
+		for (uint16_t i = 0; i <= count; i++) {
+			if (i < count && !entries[i].barrier) {
+				continue;
+			}
+			planned = GroupByBoard(segment, i, planned);
+			if (i < count) {
+				order[planned++] = i;
+			}
+			segment = i + 1;
+		}
+	}
+
+	uint16_t Count() const { return count; }
+
+	const BatchEntry& Entry(uint16_t index) const { return entries[index]; }
+
+	// Index of the entry to run as step-th
+	uint16_t Order(uint16_t step) const { return order[step]; }
+
+	// False when the plan runs the batch as sent
+	bool Reordered() const { return reordered; }
+
+private:
+	// A well formed shadowed write whose target gets another write before anything
+	// reads its board. Writes to other targets of the board observe nothing.
+	// Returns the index of that write, 0 for none as no write overwrites entry 0.
+	uint16_t OverwrittenBy(uint16_t index) const {
+		const BatchEntry& write = entries[index];
+		if (write.barrier || kShadowRoles[write.header.opcode] != ShadowRole::Write) {
+			return 0;
+		}
+		const CommandInfo& command = kCommands[write.header.opcode];
+		uint32_t arguments = FixedArgumentsSize(command);
+		if (arguments == 0 || write.header.arg_count != command.argCount
+			|| write.size != sizeof(BinaryRequestHeader) + arguments) {
+			return 0;
+		}
+		// All arguments but the value address the target
+		uint32_t valueSize = command.argTypes[command.argCount - 1] == WireType::Double ? sizeof(double) : sizeof(int32_t);
+		uint32_t targetSize = write.size - valueSize;
+
+		for (uint16_t i = index + 1; i < count; i++) {
+			const BatchEntry& next = entries[i];
+			if (next.barrier) {
+				return 0;
+			}
+			if (next.board != write.board) {
+				continue;
+			}
+			if (next.size == write.size && memcmp(next.data, write.data, targetSize) == 0) {
+				return i;
+			}
+			if (kShadowRoles[next.header.opcode] != ShadowRole::Write) {
+				return 0;
+			}
+		}
+		return 0;
+	}
+
+	// Appends [begin, end) to the order board by board, in order of first appearance
+	uint16_t GroupByBoard(uint16_t begin, uint16_t end, uint16_t planned) {
+		for (uint16_t i = begin; i < end; i++) {
+			grouped[i] = false;
+		}
+		for (uint16_t i = begin; i < end; i++) {
+			if (grouped[i]) {
+				continue;
+			}
+			for (uint16_t k = i; k < end; k++) {
+				if (!grouped[k] && entries[k].board == entries[i].board) {
+					reordered |= k != planned;
+					grouped[k] = true;
+					order[planned++] = k;
+				}
+			}
+		}
+		return planned;
+	}
+
+	std::array<BatchEntry, MAX_BATCH_ENTRIES> entries;
+	std::array<uint16_t, MAX_BATCH_ENTRIES> order;
+	std::array<bool, MAX_BATCH_ENTRIES> grouped;
+	uint16_t count = 0;
+	bool reordered = false;
+};
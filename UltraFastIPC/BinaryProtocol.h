@@ -0,0 +1,448 @@
+// BinaryProtocol.h - Binary request/response format for the shared memory channel
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+// Size of the request and of the response buffer of a ring slot
+constexpr uint32_t MESSAGE_BUFFER_SIZE = 4096;
+
+// Request format in use, selected by the client through SharedMemoryLayout::protocol_version
+enum ProtocolVersion : uint32_t {
+	PROTOCOL_TEXT = 0,      // Space separated command line, decimal text response
+	PROTOCOL_BINARY = 1,    // BinaryRequestHeader followed by packed arguments
+};
+
+// Bits of BinaryRequestHeader::flags
+enum BinaryRequestFlags : uint8_t {
+	BINARY_FLAG_NO_REPLY = 0x01,    // Fire-and-forget: no response is written, errors go to the sticky error word
+};
+
+// Opcode of a batch request, outside the range of PE32Commands.h. The header is followed by
+// uint16 count and count sub-requests, each as uint16 size + a complete binary request.
+// The response holds uint16 executed and, per executed sub-request, uint16 size + status + result.
+constexpr uint16_t BATCH_OPCODE = 0xFFFF;
+
+// Opcode of a poll, only valid as a sub-request of a batch. The header (arg_count 5) is
+// followed by a BinaryPollCondition and the complete binary request to repeat, which must
+// return an int32 or uint32. The server runs it until the condition holds for its return
+// value or the timeout passes, then answers like the request itself did on its last run.
+constexpr uint16_t POLL_OPCODE = 0xFFFE;
+
+enum PollCompare : int32_t {
+	POLL_EQUAL = 0,         // Stops once (result & mask) == value
+	POLL_NOT_EQUAL = 1,     // Stops once (result & mask) != value
+};
+
+#pragma pack(push, 1)
+struct BinaryPollCondition {
+	int32_t compare;        // PollCompare
+	int32_t mask;
+	int32_t value;
+	uint32_t interval_us;   // pe32_usleep between runs, 0 repeats at once
+	uint32_t timeout_us;    // BinaryStatus::Timeout once exceeded
+};
+#pragma pack(pop)
+static_assert(sizeof(BinaryPollCondition) == 20, "BinaryPollCondition is sent as five int32 arguments");
+
+// Fixed request header - the packed arguments of the command follow directly
+#pragma pack(push, 1)
+struct BinaryRequestHeader {
+	uint16_t opcode;        // Index of the command in PE32Commands.h
+	uint8_t arg_count;      // Number of packed arguments sent by the client
+	uint8_t flags;          // BinaryRequestFlags, unknown bits are rejected
+};
+#pragma pack(pop)
+static_assert(sizeof(BinaryRequestHeader) == 4, "BinaryRequestHeader must stay 4 bytes");
+
+// Every binary response starts with an int32 status, followed by the packed return value
+// and then the out-parameters of the command in signature order
+enum class BinaryStatus : int32_t {
+	Ok = 0,
+	UnknownOpcode = -1,
+	BadArguments = -2,
+	Exception = -3,
+	ResponseTooLarge = -4,
+	Timeout = -5,           // A poll whose condition did not hold in time
+	NotRun = -6,            // A batch command --reduce-batches had moved behind the one that failed
+};
+
+// Wire representation of a parameter or return value, used by the command registry
+enum class WireType : uint8_t {
+	Void,       // No value (void return or out-parameter)
+	Int32,
+	UInt32,
+	Double,
+	String,
+	Bytes,      // uint32 length + bytes, no terminator
+	Bulk,       // uint32 offset + uint32 size into the bulk region of the slot
+};
+
+// Bulk side channel of the ring slot a request runs in. Commands with a
+// BulkBuffer* out-parameter write there, results of a batch are appended.
+// A const BulkInput* argument is read from there, written by the client
+// before it posted the request.
+struct BulkRegion {
+	char* data;
+	uint32_t capacity;
+	uint32_t used;
+};
+
+// Sequential little-endian reader over a request buffer, no allocation
+class BinaryReader {
+public:
+	BinaryReader(const char* data, uint32_t size, BulkRegion* bulk = nullptr)
+		: pos(data), end(data + size), bulk(bulk), failed(false) {
+	}
+
+	template <typename T>
+	T Read() {
+		T value{};
+		if (end - pos < (ptrdiff_t)sizeof(T)) {
+			failed = true;
+			return value;
+		}
+		memcpy(&value, pos, sizeof(T));
+		pos += sizeof(T);
+		return value;
+	}
+
+	// Strings are sent as uint32 length + bytes + NUL, so they can be used in place
+	char* ReadString() {
+		uint32_t length = Read<uint32_t>();
+		if (failed || (uint64_t)(end - pos) < (uint64_t)length + 1 || pos[length] != '\0') {
+			failed = true;
+			return nullptr;
+		}
+		char* value = const_cast<char*>(pos);
+		pos += length + 1;
+		return value;
+	}
+
+	// Returns nullptr if fewer than size bytes are left
+	const char* ReadBytes(uint32_t size) {
+		if (failed || (uint64_t)(end - pos) < size) {
+			failed = true;
+			return nullptr;
+		}
+		const char* value = pos;
+		pos += size;
+		return value;
+	}
+
+	// uint32 offset + uint32 size of a payload the client put into the bulk region
+	const char* ReadBulk(uint32_t& size) {
+		uint32_t offset = Read<uint32_t>();
+		size = Read<uint32_t>();
+		if (failed || bulk == nullptr || (uint64_t)offset + size > bulk->capacity) {
+			failed = true;
+			return nullptr;
+		}
+		return bulk->data + offset;
+	}
+
+	bool Ok() const { return !failed; }
+	bool AtEnd() const { return pos == end; }
+	uint32_t Remaining() const { return (uint32_t)(end - pos); }
+
+	// Bulk region of the slot the request came in, nullptr if there is none
+	BulkRegion* Bulk() const { return bulk; }
+
+private:
+	const char* pos;
+	const char* end;
+	BulkRegion* bulk;
+	bool failed;
+};
+
+// Sequential little-endian writer over a response buffer, no allocation
+class BinaryWriter {
+public:
+	BinaryWriter(char* data, uint32_t capacity)
+		: begin(data), pos(data), end(data + capacity), failed(false) {
+	}
+
+	template <typename T>
+	void Write(const T& value) {
+		if (end - pos < (ptrdiff_t)sizeof(T)) {
+			failed = true;
+			return;
+		}
+		memcpy(pos, &value, sizeof(T));
+		pos += sizeof(T);
+	}
+
+	void WriteBytes(const void* value, uint32_t size) {
+		if (failed || (uint64_t)(end - pos) < size) {
+			failed = true;
+			return;
+		}
+		memcpy(pos, value, size);
+		pos += size;
+	}
+
+	void WriteString(const char* value) {
+		uint32_t length = value != nullptr ? (uint32_t)strlen(value) : 0;
+		Write(length);
+		WriteBytes(value, length);
+	}
+
+	// Skips size bytes that are filled in later, returns nullptr if they do not fit
+	char* Reserve(uint32_t size) {
+		if (failed || (uint64_t)(end - pos) < size) {
+			failed = true;
+			return nullptr;
+		}
+		char* value = pos;
+		pos += size;
+		return value;
+	}
+
+	// Drops everything written after the first size bytes
+	void Rewind(uint32_t size) { pos = begin + size; failed = false; }
+
+	void Reset() { pos = begin; failed = false; }
+	bool Ok() const { return !failed; }
+	uint32_t Size() const { return (uint32_t)(pos - begin); }
+
+	// What was written at offset, e.g. the return value of a command
+	const char* At(uint32_t offset) const { return begin + offset; }
+	char* At(uint32_t offset) { return begin + offset; }
+
+private:
+	char* begin;
+	char* pos;
+	char* end;
+	bool failed;
+};
+
+// Byte payload filled by a command wrapper, sent back as an out-value.
+// Leaves room in the response buffer for the status, the result and a few int outs.
+struct OutBytes {
+	static constexpr uint32_t Capacity = MESSAGE_BUFFER_SIZE - 64;
+
+	char data[Capacity];
+	uint32_t size = 0;
+};
+
+// Wire codec of one parameter type of a command signature.
+// Storage is what the decoded argument lives in until the vendor call,
+// Pass converts it to what the vendor function expects and EncodeOut
+// sends an out-parameter back after the return value.
+template <typename T>
+struct ArgCodec;
+
+// Argument sent by the client, nothing goes back
+template <typename T>
+struct InArgCodec {
+	using Storage = T;
+	static constexpr bool OnWire = true;
+	static constexpr WireType OutType = WireType::Void;
+	static T Pass(Storage& value) { return value; }
+	static void EncodeOut(BinaryWriter&, Storage&) {}
+};
+
+template <typename T>
+struct Int32ArgCodec : InArgCodec<T> {
+	static constexpr WireType Type = WireType::Int32;
+	static T Decode(BinaryReader& in) { return (T)in.Read<int32_t>(); }
+};
+
+template <> struct ArgCodec<int> : Int32ArgCodec<int> {};
+template <> struct ArgCodec<long> : Int32ArgCodec<long> {};
+template <> struct ArgCodec<short> : Int32ArgCodec<short> {};
+template <> struct ArgCodec<unsigned long> : Int32ArgCodec<unsigned long> {};
+
+template <>
+struct ArgCodec<double> : InArgCodec<double> {
+	static constexpr WireType Type = WireType::Double;
+	static double Decode(BinaryReader& in) { return in.Read<double>(); }
+};
+
+// The vendor API is not const-correct, strings are handed over as char*
+template <>
+struct ArgCodec<const char*> : InArgCodec<char*> {
+	static constexpr WireType Type = WireType::String;
+	static char* Decode(BinaryReader& in) { return in.ReadString(); }
+};
+
+// Out-parameter: not sent by the client, the vendor writes into a local
+// that is sent back as an int32 out-value
+template <>
+struct ArgCodec<int*> {
+	using Storage = int;
+	static constexpr bool OnWire = false;
+	static constexpr WireType Type = WireType::Void;
+	static constexpr WireType OutType = WireType::Int32;
+	static Storage Decode(BinaryReader&) { return 0; }
+	static int* Pass(Storage& value) { return &value; }
+	static void EncodeOut(BinaryWriter& out, Storage& value) { out.Write((int32_t)value); }
+};
+
+// Out-parameter: byte payload filled by a wrapper, sent back as uint32 length + bytes
+template <>
+struct ArgCodec<OutBytes*> {
+	using Storage = OutBytes;
+	static constexpr bool OnWire = false;
+	static constexpr WireType Type = WireType::Void;
+	static constexpr WireType OutType = WireType::Bytes;
+	static Storage Decode(BinaryReader&) { return {}; }
+	static OutBytes* Pass(Storage& value) { return &value; }
+	static void EncodeOut(BinaryWriter& out, Storage& value) {
+		uint32_t size = value.size < OutBytes::Capacity ? value.size : OutBytes::Capacity;
+		out.Write(size);
+		out.WriteBytes(value.data, size);
+	}
+};
+
+// Out-parameter: the free part of the slot's bulk region. The command writes
+// up to capacity bytes at data and sets size, the client gets offset + size.
+struct BulkBuffer {
+	char* data;
+	uint32_t capacity;
+	uint32_t size;
+	uint32_t offset;
+	BulkRegion* region;
+};
+
+template <>
+struct ArgCodec<BulkBuffer*> {
+	using Storage = BulkBuffer;
+	static constexpr bool OnWire = false;
+	static constexpr WireType Type = WireType::Void;
+	static constexpr WireType OutType = WireType::Bulk;
+	static Storage Decode(BinaryReader& in) {
+		BulkRegion* region = in.Bulk();
+		if (region == nullptr) {
+			return { nullptr, 0, 0, 0, nullptr };
+		}
+		return { region->data + region->used, region->capacity - region->used, 0, region->used, region };
+	}
+	static BulkBuffer* Pass(Storage& value) { return &value; }
+	static void EncodeOut(BinaryWriter& out, Storage& value) {
+		uint32_t size = value.size < value.capacity ? value.size : value.capacity;
+		if (value.region != nullptr) {
+			// Keep the next payload 8 byte aligned so the client can read it as int/double
+			value.region->used += (size + 7) & ~7u;
+			value.region->used = value.region->used < value.region->capacity ? value.region->used : value.region->capacity;
+		}
+		out.Write(value.offset);
+		out.Write(size);
+	}
+};
+
+// In-parameter: a payload in the slot's bulk region, sent as offset + size
+struct BulkInput {
+	const char* data;
+	uint32_t size;
+};
+
+template <>
+struct ArgCodec<const BulkInput*> : InArgCodec<const BulkInput*> {
+	using Storage = BulkInput;
+	static constexpr WireType Type = WireType::Bulk;
+	static Storage Decode(BinaryReader& in) {
+		BulkInput value{};
+		value.data = in.ReadBulk(value.size);
+		return value;
+	}
+	static const BulkInput* Pass(Storage& value) { return &value; }
+	static void EncodeOut(BinaryWriter&, Storage&) {}
+};
+
+template <typename R>
+constexpr WireType ResultWireType() {
+	if constexpr (std::is_void_v<R>) {
+		return WireType::Void;
+	}
+	else if constexpr (std::is_same_v<R, double>) {
+		return WireType::Double;
+	}
+	else if constexpr (std::is_same_v<R, const char*>) {
+		return WireType::String;
+	}
+	else {
+		return std::is_unsigned_v<R> ? WireType::UInt32 : WireType::Int32;
+	}
+}
+
+// Wire encoding of a command return value
+template <typename R>
+inline void WriteResult(BinaryWriter& out, R value) {
+	if constexpr (std::is_same_v<R, double>) {
+		out.Write(value);
+	}
+	else if constexpr (std::is_same_v<R, const char*>) {
+		out.WriteString(value);
+	}
+	else {
+		// int, long and unsigned long are all 32 bits on the Win32 server
+		static_assert(std::is_integral_v<R>, "Unsupported return type in PE32Commands.h");
+		out.Write((int32_t)value);
+	}
+}
+
+// Decodes the arguments of a signature, invokes the target and encodes the result
+template <typename Signature>
+struct CommandThunk;
+
+template <typename R, typename... A>
+struct CommandThunk<R(A...)> {
+	// Number of arguments the client has to send
+	static constexpr int WireArgCount = (0 + ... + (ArgCodec<A>::OnWire ? 1 : 0));
+
+	static constexpr WireType ReturnType = ResultWireType<R>();
+
+	// Number of out-values sent back after the return value
+	static constexpr int OutArgCount = (0 + ... + (ArgCodec<A>::OutType != WireType::Void ? 1 : 0));
+
+	// Wire types of the arguments the client sends, in order
+	static constexpr std::array<WireType, WireArgCount> ArgTypes = [] {
+		std::array<WireType, WireArgCount> types{};
+		size_t next = 0;
+		((ArgCodec<A>::OnWire ? (void)(types[next++] = ArgCodec<A>::Type) : (void)0), ...);
+		return types;
+	}();
+
+	// Wire types of the out-values, in order
+	static constexpr std::array<WireType, OutArgCount> OutTypes = [] {
+		std::array<WireType, OutArgCount> types{};
+		size_t next = 0;
+		((ArgCodec<A>::OutType != WireType::Void ? (void)(types[next++] = ArgCodec<A>::OutType) : (void)0), ...);
+		return types;
+	}();
+
+	template <typename F>
+	static BinaryStatus Invoke(F target, const BinaryRequestHeader& header, BinaryReader& in, BinaryWriter& out) {
+		if (header.arg_count != WireArgCount) {
+			return BinaryStatus::BadArguments;
+		}
+
+		// Braced initialization guarantees left-to-right decoding order
+		std::tuple<typename ArgCodec<A>::Storage...> args{ ArgCodec<A>::Decode(in)... };
+		if (!in.Ok() || !in.AtEnd()) {
+			return BinaryStatus::BadArguments;
+		}
+
+		if constexpr (std::is_void_v<R>) {
+			std::apply([&](auto&... values) { target(ArgCodec<A>::Pass(values)...); }, args);
+		}
+		else {
+			R result = std::apply([&](auto&... values) { return (R)target(ArgCodec<A>::Pass(values)...); }, args);
+			WriteResult<R>(out, result);
+		}
+		std::apply([&](auto&... values) { (ArgCodec<A>::EncodeOut(out, values), ...); }, args);
+		return out.Ok() ? BinaryStatus::Ok : BinaryStatus::ResponseTooLarge;
+	}
+};
+
+// Opcode ids of the binary protocol, one per entry of PE32Commands.h
+enum class Opcode : uint16_t {
+#define PE32_COMMAND(name, signature) name,
+#include "PE32Commands.h"
+#undef PE32_COMMAND
+	Count
+};
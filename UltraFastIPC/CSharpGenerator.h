@@ -0,0 +1,321 @@
+// CSharpGenerator.h - Emits PE32Proxy/PE32Commands.g.cs from the command registry
+//
+// Run "UltraFastIPC.exe --emit-csharp <file>" after changing PE32Commands.h so
+// the opcode ids and typed stubs on the C# side stay in sync.
+#pragma once
+
+#include <algorithm>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CommandRegistry.h"
+
+// Splits "int(int bdn, int* buffer)" into its parameter declarations
+inline std::vector<std::string_view> SignatureParameters(std::string_view signature) {
+	std::vector<std::string_view> parameters;
+	size_t open = signature.find('(');
+	size_t close = signature.rfind(')');
+	std::string_view list = signature.substr(open + 1, close - open - 1);
+	while (!list.empty()) {
+		size_t comma = list.find(',');
+		std::string_view parameter = list.substr(0, comma);
+		while (!parameter.empty() && parameter.front() == ' ') {
+			parameter.remove_prefix(1);
+		}
+		parameters.push_back(parameter);
+		list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+	}
+	return parameters;
+}
+
+inline const char* CSharpType(WireType type) {
+	switch (type) {
+	case WireType::Int32: return "int";
+	case WireType::UInt32: return "uint";
+	case WireType::Double: return "double";
+	case WireType::String: return "string";
+	case WireType::Bytes: return "byte[]";
+	case WireType::Bulk: return "ReadOnlySpan<byte>";
+	default: return "void";
+	}
+}
+
+inline const char* CSharpWriter(WireType type) {
+	switch (type) {
+	case WireType::Double: return "WriteDouble";
+	case WireType::String: return "WriteString";
+	case WireType::Bulk: return "WriteBulk";
+	default: return "WriteInt32";
+	}
+}
+
+inline const char* CSharpReader(WireType type) {
+	switch (type) {
+	case WireType::UInt32: return "ReadUInt32";
+	case WireType::Double: return "ReadDouble";
+	case WireType::String: return "ReadString";
+	case WireType::Bulk: return "ReadBulk";
+	default: return "ReadInt32";
+	}
+}
+
+// Parameter name of a declaration such as "int* alog"
+inline std::string ParameterName(std::string_view parameter) {
+	return std::string(parameter.substr(parameter.find_last_of(" *") + 1));
+}
+
+// Out-parameters are the non-const pointers, strings and bulk inputs are sent
+inline bool IsOutParameter(std::string_view parameter) {
+	return parameter.find('*') != std::string_view::npos && parameter.substr(0, 6) != "const ";
+}
+
+// "alog" -> "Alog", used for tuple element names
+inline std::string PascalCase(std::string name) {
+	if (!name.empty() && name[0] >= 'a' && name[0] <= 'z') {
+		name[0] = (char)(name[0] - 'a' + 'A');
+	}
+	return name;
+}
+
+// C# shape of one command: what is sent, and the values read back in wire order
+struct CSharpStub {
+	std::string parameters;                 // Sent arguments
+	std::string request;                    // Request builder expression
+	std::string routed;                     // Same, started on the channel of the command's board
+	std::string cacheKey;                   // Board number, or 0 without one
+	std::string bulkInput;                  // Span copied into the bulk region when posting, if any
+	std::vector<std::string> valueNames;    // "result" and the out-parameter names
+	std::vector<WireType> valueTypes;
+};
+
+inline CSharpStub DescribeStub(const CommandInfo& command) {
+	CSharpStub stub;
+	std::vector<std::string> inNames;
+	for (std::string_view parameter : SignatureParameters(command.signature)) {
+		if (IsOutParameter(parameter)) {
+			stub.valueNames.push_back(ParameterName(parameter));
+		}
+		else {
+			inNames.push_back(ParameterName(parameter));
+		}
+	}
+	stub.valueTypes.assign(command.outTypes, command.outTypes + command.outCount);
+	if (command.returnType != WireType::Void) {
+		stub.valueNames.insert(stub.valueNames.begin(), "result");
+		stub.valueTypes.insert(stub.valueTypes.begin(), command.returnType);
+	}
+
+	std::string writes;
+	for (size_t i = 0; i < command.argCount; i++) {
+		stub.parameters += (i > 0 ? ", " : "") + std::string(CSharpType(command.argTypes[i])) + " " + inNames[i];
+		if (command.argTypes[i] == WireType::Bulk) {
+			// The request carries offset and size, the bytes go into the slot's bulk region
+			writes += ".WriteBulk(" + inNames[i] + ".Length)";
+			stub.bulkInput = inNames[i];
+		}
+		else {
+			writes += "." + std::string(CSharpWriter(command.argTypes[i])) + "(" + inNames[i] + ")";
+		}
+	}
+
+	// Commands that take a board number as their first argument go to that board's channel
+	std::string opcode = "PE32Opcode." + std::string(command.name);
+	bool board = !inNames.empty() && inNames[0] == "bdn";
+	stub.request = "Begin(" + opcode + ")" + writes;
+	stub.routed = "Begin(" + opcode + (board ? ", bdn)" : ")") + writes;
+	stub.cacheKey = board ? "bdn" : "0";
+	return stub;
+}
+
+// PE32Proxy method: byte payloads are copied into a caller supplied span,
+// one value is returned as is and several as a named tuple. A bulk payload is
+// a span over shared memory, so it has to be the only value of its command.
+inline void EmitProxyStub(std::ostream& out, const CommandInfo& command) {
+	CSharpStub stub = DescribeStub(command);
+
+	std::string parameters = stub.parameters;
+	std::vector<size_t> returned;
+	for (size_t i = 0; i < stub.valueTypes.size(); i++) {
+		if (stub.valueTypes[i] == WireType::Bytes) {
+			parameters += (parameters.empty() ? "" : ", ") + std::string("Span<byte> ") + stub.valueNames[i];
+		}
+		else {
+			returned.push_back(i);
+		}
+	}
+
+	std::string returnType = "void";
+	if (returned.size() == 1) {
+		returnType = CSharpType(stub.valueTypes[returned[0]]);
+	}
+	else if (returned.size() > 1) {
+		returnType = "(";
+		for (size_t i : returned) {
+			returnType += (i == returned[0] ? "" : ", ") + std::string(CSharpType(stub.valueTypes[i])) + " "
+				+ PascalCase(stub.valueNames[i]);
+		}
+		returnType += ")";
+	}
+
+	std::string call = "Call(" + stub.routed + (stub.bulkInput.empty() ? ")" : ", " + stub.bulkInput + ")");
+	out << "    public " << returnType << " " << command.name << "(" << parameters << ")\n"
+		<< "    {\n";
+	CachePolicy cache = CommandCachePolicy(command);
+	if (cache == CachePolicy::Invalidates) {
+		out << "        using var invalidation = queryCache.BeginInvalidation();\n";
+	}
+	if (cache == CachePolicy::Immutable) {
+		std::string opcode = "PE32Opcode." + std::string(command.name);
+		out << "        if (queryCache.TryGet(" << opcode << ", " << stub.cacheKey << ", out int cached, out long version))\n"
+			<< "            return cached;\n"
+			<< "        var result = " << call << ".ReadInt32();\n"
+			<< "        queryCache.Store(" << opcode << ", " << stub.cacheKey << ", result, version);\n"
+			<< "        return result;\n";
+	}
+	else if (stub.valueTypes.empty() && stub.bulkInput.empty()) {
+		out << "        Send(" << stub.routed << ");\n";
+	}
+	else if (stub.valueTypes.empty()) {
+		out << "        " << call << ";\n";
+	}
+	else if (returned.size() == 1 && stub.valueTypes.size() == 1) {
+		out << "        return " << call << "." << CSharpReader(stub.valueTypes[0]) << "();\n";
+	}
+	else {
+		out << "        var response = " << call << ";\n";
+		for (size_t i = 0; i < stub.valueTypes.size(); i++) {
+			if (stub.valueTypes[i] == WireType::Bytes) {
+				out << "        response.ReadBytes(" << stub.valueNames[i] << ");\n";
+			}
+			else {
+				out << "        var " << stub.valueNames[i] << " = response." << CSharpReader(stub.valueTypes[i]) << "();\n";
+			}
+		}
+		if (returned.size() == 1) {
+			out << "        return " << stub.valueNames[returned[0]] << ";\n";
+		}
+		else if (returned.size() > 1) {
+			out << "        return (";
+			for (size_t i : returned) {
+				out << (i == returned[0] ? "" : ", ") << stub.valueNames[i];
+			}
+			out << ");\n";
+		}
+	}
+	out << "    }\n";
+}
+
+// Awaitable PE32Proxy method, the response is decoded on the poller thread. Byte and bulk
+// payloads need a buffer that outlives the call, and invalidating commands a cache scope
+// around it, so those commands have no async variant, nor have bulk inputs. Cache hits are served, but async
+// answers are not stored.
+inline bool EmitAsyncStub(std::ostream& out, const CommandInfo& command) {
+	CSharpStub stub = DescribeStub(command);
+	CachePolicy cache = CommandCachePolicy(command);
+	for (WireType type : stub.valueTypes) {
+		if (type == WireType::Bytes || type == WireType::Bulk) {
+			return false;
+		}
+	}
+	if (cache == CachePolicy::Invalidates || !stub.bulkInput.empty()) {
+		return false;
+	}
+
+	std::string valueType;
+	std::string decode;
+	if (stub.valueTypes.size() == 1) {
+		valueType = CSharpType(stub.valueTypes[0]);
+		decode = "response." + std::string(CSharpReader(stub.valueTypes[0])) + "()";
+	}
+	else if (stub.valueTypes.size() > 1) {
+		// Tuple elements are evaluated left to right, in wire order
+		valueType = "(";
+		decode = "(";
+		for (size_t i = 0; i < stub.valueTypes.size(); i++) {
+			valueType += (i == 0 ? "" : ", ") + std::string(CSharpType(stub.valueTypes[i])) + " " + PascalCase(stub.valueNames[i]);
+			decode += (i == 0 ? "" : ", ") + std::string("response.") + CSharpReader(stub.valueTypes[i]) + "()";
+		}
+		valueType += ")";
+		decode += ")";
+	}
+
+	out << "    public " << (valueType.empty() ? "ValueTask" : "ValueTask<" + valueType + ">") << " "
+		<< command.name << "_async(" << stub.parameters << ")\n"
+		<< "    {\n";
+	if (cache == CachePolicy::Immutable) {
+		out << "        if (queryCache.TryGet(PE32Opcode." << command.name << ", " << stub.cacheKey << ", out int cached, out _))\n"
+			<< "            return new ValueTask<int>(cached);\n";
+	}
+	if (valueType.empty()) {
+		out << "        return SendAsync(" << stub.routed << ");\n";
+	}
+	else {
+		out << "        return CallAsync(" << stub.routed << ", static response => " << decode << ");\n";
+	}
+	out << "    }\n";
+	return true;
+}
+
+inline void EmitCSharpStubs(std::ostream& out) {
+	out << "// <auto-generated>\n"
+		<< "//     Generated by \"UltraFastIPC.exe --emit-csharp\" from UltraFastIPC/PE32Commands.h.\n"
+		<< "//     Do not edit, regenerate after changing the command list.\n"
+		<< "// </auto-generated>\n"
+		<< "namespace PE32Proxy;\n\n"
+		<< "// Opcode ids of the binary protocol, in the order of PE32Commands.h\n"
+		<< "internal enum PE32Opcode : ushort\n{\n";
+	for (const CommandInfo& command : kCommands) {
+		out << "    " << command.name << ",\n";
+	}
+	out << "}\n\n"
+		<< "// Typed stubs for every PE32 entry point exported by the bridge\n"
+		<< "public partial class PE32Proxy\n{\n";
+
+	bool first = true;
+	for (const CommandInfo& command : kCommands) {
+		out << (first ? "" : "\n");
+		EmitProxyStub(out, command);
+		first = false;
+	}
+	out << "}\n\n"
+		<< "// Awaitable variants, any number of threads may have them outstanding.\n"
+		<< "// One poller thread per proxy completes them, see PE32Proxy.CallAsync().\n"
+		<< "public partial class PE32Proxy\n{\n";
+
+	first = true;
+	for (const CommandInfo& command : kCommands) {
+		std::ostringstream stubText;
+		if (EmitAsyncStub(stubText, command)) {
+			out << (first ? "" : "\n") << stubText.str();
+			first = false;
+		}
+	}
+	out << "}\n\n"
+		<< "// The same calls queued into a batch, see PE32Proxy.BeginBatch().\n"
+		<< "// Return and out-values are read back through PE32BatchResults.GetValues().\n"
+		<< "// Bulk commands and bulk inputs are not batchable.\n"
+		<< "public sealed partial class PE32Batch\n{\n";
+
+	first = true;
+	for (const CommandInfo& command : kCommands) {
+		CSharpStub stub = DescribeStub(command);
+		if (std::find(stub.valueTypes.begin(), stub.valueTypes.end(), WireType::Bulk) != stub.valueTypes.end()) {
+			continue;  // Bulk views are only valid until the next request, PE32BatchResults cannot hold them
+		}
+		if (!stub.bulkInput.empty()) {
+			continue;  // The slot's bulk region holds one input, not one per sub-request
+		}
+		out << (first ? "" : "\n")
+			<< "    public PE32Batch " << command.name << "(" << stub.parameters << ")\n"
+			<< "    {\n";
+		if (CommandCachePolicy(command) == CachePolicy::Invalidates) {
+			out << "        invalidatesQueryCache = true;\n";
+		}
+		out << "        return Add(" << stub.request << ");\n"
+			<< "    }\n";
+		first = false;
+	}
+	out << "}\n";
+}
@@ -0,0 +1,246 @@
+// CommandRegistry.h - Compile time name/opcode table built from PE32Commands.h
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "BinaryProtocol.h"
+
+// Static description of one exported command
+struct CommandInfo {
+	std::string_view name;
+	Opcode opcode;
+	std::string_view signature;     // Signature as written in PE32Commands.h
+	WireType returnType;
+	const WireType* argTypes;       // Wire types of the arguments sent by the client
+	uint8_t argCount;
+	const WireType* outTypes;       // Wire types of the out-values sent back after the result
+	uint8_t outCount;
+};
+
+// Indexed by opcode
+inline constexpr CommandInfo kCommands[] = {
+#define PE32_COMMAND(name, signature) \
+	{ #name, Opcode::name, #signature, CommandThunk<signature>::ReturnType, \
+	  CommandThunk<signature>::ArgTypes.data(), (uint8_t)CommandThunk<signature>::WireArgCount, \
+	  CommandThunk<signature>::OutTypes.data(), (uint8_t)CommandThunk<signature>::OutArgCount },
+#include "PE32Commands.h"
+#undef PE32_COMMAND
+};
+static_assert(std::size(kCommands) == (size_t)Opcode::Count, "kCommands must cover every opcode");
+
+// FNV-1a, usable both at compile time and on the request path
+constexpr uint32_t HashCommandName(std::string_view name) {
+	uint32_t hash = 2166136261u;
+	for (char c : name) {
+		hash ^= (uint8_t)c;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+// Open addressing table from name hash to opcode, built by the compiler
+constexpr size_t kCommandTableSize = 1024;
+static_assert((kCommandTableSize & (kCommandTableSize - 1)) == 0, "Table size must be a power of two");
+static_assert(kCommandTableSize >= 2 * std::size(kCommands), "Keep the name table at most half full");
+
+inline constexpr auto kCommandTable = [] {
+	std::array<int16_t, kCommandTableSize> table{};
+	for (auto& slot : table) {
+		slot = -1;
+	}
+	for (size_t i = 0; i < std::size(kCommands); i++) {
+		size_t slot = HashCommandName(kCommands[i].name) & (kCommandTableSize - 1);
+		while (table[slot] >= 0) {
+			slot = (slot + 1) & (kCommandTableSize - 1);
+		}
+		table[slot] = (int16_t)i;
+	}
+	return table;
+}();
+
+// Longest probe sequence of any name, this bounds the cost of every lookup
+constexpr size_t CommandTableMaxProbes() {
+	size_t longest = 0;
+	for (size_t i = 0; i < std::size(kCommands); i++) {
+		size_t slot = HashCommandName(kCommands[i].name) & (kCommandTableSize - 1);
+		size_t probes = 1;
+		while (kCommandTable[slot] != (int16_t)i) {
+			slot = (slot + 1) & (kCommandTableSize - 1);
+			probes++;
+		}
+		longest = probes > longest ? probes : longest;
+	}
+	return longest;
+}
+static_assert(CommandTableMaxProbes() <= 4, "Command name hash clusters too much, grow kCommandTableSize");
+
+// Returns nullptr for unknown names, never more than CommandTableMaxProbes() compares
+inline const CommandInfo* FindCommand(std::string_view name) {
+	size_t slot = HashCommandName(name) & (kCommandTableSize - 1);
+	while (kCommandTable[slot] >= 0) {
+		const CommandInfo& command = kCommands[kCommandTable[slot]];
+		if (command.name == name) {
+			return &command;
+		}
+		slot = (slot + 1) & (kCommandTableSize - 1);
+	}
+	return nullptr;
+}
+
+inline const CommandInfo* FindCommand(Opcode opcode) {
+	return (size_t)opcode < std::size(kCommands) ? &kCommands[(size_t)opcode] : nullptr;
+}
+
+constexpr bool ListContains(const std::string_view* list, size_t count, std::string_view name) {
+	for (size_t i = 0; i < count; i++) {
+		if (list[i] == name) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// What the C# client may keep of an answer, see PE32ProxyOptions.CacheQueries
+enum class CachePolicy : uint8_t {
+	None,
+	Immutable,      // Board identity, unchanged until the next invalidating command
+	Invalidates,    // Drops every cached answer
+};
+
+inline constexpr std::string_view kImmutableCommands[] = {
+	"pe32_api",
+	"pe32_rd_id",
+	"pe32_rd_vc",
+	"pe32_rd_pesno",
+	"pe32_rd_PciRevId",
+	"pe32_rd_PciDevId",
+	"pe32_rd_PciSubId",
+};
+
+inline constexpr std::string_view kCacheInvalidatingCommands[] = {
+	"pe32_init",
+	"pe32_reset",
+};
+
+constexpr CachePolicy CommandCachePolicy(const CommandInfo& command) {
+	if (ListContains(kImmutableCommands, std::size(kImmutableCommands), command.name)) {
+		return CachePolicy::Immutable;
+	}
+	if (ListContains(kCacheInvalidatingCommands, std::size(kCacheInvalidatingCommands), command.name)) {
+		return CachePolicy::Invalidates;
+	}
+	return CachePolicy::None;
+}
+
+// The client caches one int per opcode and board, so that is all an immutable command may return
+constexpr bool CacheableCommandsFit() {
+	for (const CommandInfo& command : kCommands) {
+		if (CommandCachePolicy(command) == CachePolicy::Immutable
+			&& (command.returnType != WireType::Int32 || command.outCount != 0 || command.argCount > 1
+				|| (command.argCount == 1 && command.argTypes[0] != WireType::Int32))) {
+			return false;
+		}
+	}
+	return true;
+}
+static_assert(CacheableCommandsFit(), "Immutable commands must be int(int bdn) or int()");
+
+// Text protocol front end: tokens[1..] are encoded as a binary request so both
+// formats share one dispatch path. Throws std::invalid_argument/out_of_range
+// like the std::sto* calls it is built on.
+inline bool EncodeTextRequest(const CommandInfo& command, const std::vector<std::string>& tokens, BinaryWriter& out) {
+	if (tokens.size() != (size_t)command.argCount + 1) {
+		return false;
+	}
+	// A bulk result can be far larger than the text response, such commands are binary only
+	if (command.returnType == WireType::Bulk) {
+		return false;
+	}
+	for (size_t i = 0; i < command.outCount; i++) {
+		if (command.outTypes[i] == WireType::Bulk) {
+			return false;
+		}
+	}
+
+	out.Write(BinaryRequestHeader{ (uint16_t)command.opcode, command.argCount, 0 });
+	for (size_t i = 0; i < command.argCount; i++) {
+		const std::string& token = tokens[i + 1];
+		switch (command.argTypes[i]) {
+		case WireType::Int32:
+		case WireType::UInt32:
+			out.Write((int32_t)std::stoi(token));
+			break;
+		case WireType::Double:
+			out.Write(std::stod(token));
+			break;
+		case WireType::String:
+			out.Write((uint32_t)token.size());
+			out.WriteBytes(token.c_str(), (uint32_t)token.size() + 1);
+			break;
+		default:
+			return false;
+		}
+	}
+	return out.Ok();
+}
+
+// Byte payloads are sent as hex, two digits per byte
+inline std::string FormatTextHex(const char* value, uint32_t length) {
+	static const char digits[] = "0123456789abcdef";
+	std::string hex;
+	for (uint32_t i = 0; value != nullptr && i < length; i++) {
+		hex += digits[(uint8_t)value[i] >> 4];
+		hex += digits[(uint8_t)value[i] & 0xF];
+	}
+	return hex;
+}
+
+// Formats one value of a successful binary response the way the text protocol always has
+inline std::string FormatTextValue(WireType type, BinaryReader& in) {
+	switch (type) {
+	case WireType::Int32:
+		return std::to_string(in.Read<int32_t>());
+	case WireType::UInt32:
+		return std::to_string(in.Read<uint32_t>());
+	case WireType::Double:
+		return std::to_string(in.Read<double>());
+	case WireType::String: {
+		uint32_t length = in.Read<uint32_t>();
+		const char* value = in.ReadBytes(length);
+		return value != nullptr ? std::string(value, length) : std::string();
+	}
+	case WireType::Bytes: {
+		uint32_t length = in.Read<uint32_t>();
+		return FormatTextHex(in.ReadBytes(length), length);
+	}
+	case WireType::Bulk: {
+		// Offset and size into the slot's bulk region
+		uint32_t offset = in.Read<uint32_t>();
+		uint32_t size = in.Read<uint32_t>();
+		BulkRegion* bulk = in.Bulk();
+		if (bulk == nullptr || (uint64_t)offset + size > bulk->capacity) {
+			return std::string();
+		}
+		return FormatTextHex(bulk->data + offset, size);
+	}
+	default:
+		return "0";
+	}
+}
+
+// Result first, then the out-values, separated by spaces
+inline std::string FormatTextResult(const CommandInfo& command, BinaryReader& in) {
+	if (command.returnType == WireType::Void && command.outCount == 0) {
+		return "0";
+	}
+
+	std::string text = command.returnType != WireType::Void ? FormatTextValue(command.returnType, in) : std::string();
+	for (size_t i = 0; i < command.outCount; i++) {
+		text += (text.empty() ? "" : " ") + FormatTextValue(command.outTypes[i], in);
+	}
+	return text;
+}
@@ -0,0 +1,132 @@
+// DispatchPolicy.h - Which vendor DLL calls may run at the same time
+//
+// Channels run their commands on their own threads. Before a command enters
+// the DLL it takes a DispatchLock, whose kind comes from the policy table below.
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include "CommandRegistry.h"
+
+enum class DispatchPolicy : uint8_t {
+	GlobalExclusive,        // Nothing else runs in the DLL meanwhile
+	BoardExclusive,         // Excludes other commands on the same board and global ones
+	ReadOnlyConcurrent,     // Shares its board with other read-only commands
+	Unlocked,               // Touches no board or DLL state, runs alongside anything
+};
+
+// Commands that take a board number but change DLL wide state
+inline constexpr std::string_view kGlobalCommands[] = {
+	"pe32_cal_load_auto",
+	"pe32_cal_save_auto",
+};
+
+// Commands that touch no board or DLL state at all
+inline constexpr std::string_view kUnboundCommands[] = {
+	"pe32_usleep",
+	"pe32_pattern_store",   // Only writes the pattern cache, which has a lock of its own
+	"ipc_nop",
+	"ipc_echo",
+	"ipc_echo_bytes",
+	"ipc_echo_bulk",
+};
+
+// Board commands are exclusive per board, status and register reads share it,
+// and everything without a board number (pe32_init, pe32_lmload, ...) is global.
+// There is no worker per board: the policy only decides which channel threads may
+// overlap in the DLL. Boards routed to the same channel, (bdn - 1) % channels,
+// still run one after the other, so boards overlap only when --channels spreads them.
+constexpr DispatchPolicy CommandPolicy(const CommandInfo& command) {
+	if (ListContains(kUnboundCommands, std::size(kUnboundCommands), command.name)) {
+		return DispatchPolicy::Unlocked;
+	}
+	std::string_view parameters = command.signature.substr(command.signature.find('('));
+	if (parameters.substr(0, 8) != "(int bdn" || ListContains(kGlobalCommands, std::size(kGlobalCommands), command.name)) {
+		return DispatchPolicy::GlobalExclusive;
+	}
+	bool read = command.name.substr(0, 11) == "pe32_check_" || command.name.substr(0, 8) == "pe32_rd_";
+	if (read && command.returnType != WireType::Void && command.outCount == 0) {
+		return DispatchPolicy::ReadOnlyConcurrent;
+	}
+	return DispatchPolicy::BoardExclusive;
+}
+
+// Indexed by opcode
+inline constexpr auto kDispatchPolicies = [] {
+	std::array<DispatchPolicy, std::size(kCommands)> policies{};
+	for (size_t i = 0; i < std::size(kCommands); i++) {
+		policies[i] = CommandPolicy(kCommands[i]);
+	}
+	return policies;
+}();
+
+static_assert(kDispatchPolicies[(size_t)Opcode::pe32_init] == DispatchPolicy::GlobalExclusive, "pe32_init must be global");
+static_assert(kDispatchPolicies[(size_t)Opcode::pe32_lmload] == DispatchPolicy::GlobalExclusive, "pe32_lmload must be global");
+static_assert(kDispatchPolicies[(size_t)Opcode::pe32_vmeas] == DispatchPolicy::BoardExclusive, "pe32_vmeas must only lock its board");
+
+// Held while one command runs in the DLL. Boards share lock stripes beyond MAX_BOARD_LOCKS.
+class DispatchLock {
+public:
+	static constexpr uint32_t MAX_BOARD_LOCKS = 64;
+
+	// Set by --dispatch=serial, every command is then global
+	static inline bool serialized = false;
+
+	template <typename... A>
+	DispatchLock(Opcode opcode, A... args)
+		: policy(serialized ? DispatchPolicy::GlobalExclusive : kDispatchPolicies[(size_t)opcode]), board(nullptr) {
+		if (policy == DispatchPolicy::Unlocked) {
+			return;
+		}
+		if (policy == DispatchPolicy::GlobalExclusive) {
+			globalLock.lock();
+			return;
+		}
+		globalLock.lock_shared();
+		if constexpr (sizeof...(A) > 0) {
+			board = &boardLocks[(uint32_t)FirstArgument(args...) % MAX_BOARD_LOCKS];
+		}
+		if (policy == DispatchPolicy::BoardExclusive) {
+			board->lock();
+		}
+		else {
+			board->lock_shared();
+		}
+	}
+
+	~DispatchLock() {
+		if (policy == DispatchPolicy::Unlocked) {
+			return;
+		}
+		if (policy == DispatchPolicy::GlobalExclusive) {
+			globalLock.unlock();
+			return;
+		}
+		if (board != nullptr) {
+			if (policy == DispatchPolicy::BoardExclusive) {
+				board->unlock();
+			}
+			else {
+				board->unlock_shared();
+			}
+		}
+		globalLock.unlock_shared();
+	}
+
+	DispatchLock(const DispatchLock&) = delete;
+	DispatchLock& operator=(const DispatchLock&) = delete;
+
+private:
+	template <typename T, typename... Rest>
+	static T FirstArgument(T first, Rest...) { return first; }
+
+	static inline std::shared_mutex globalLock;
+	static inline std::array<std::shared_mutex, MAX_BOARD_LOCKS> boardLocks;
+
+	DispatchPolicy policy;
+	std::shared_mutex* board;
+};
@@ -0,0 +1,242 @@
+// MockPE32.h - Simulated PE32 backend, replaces PE32.h in the Mock configuration
+//
+// Every vendor entry point of PE32Commands.h becomes a callable object with the
+// same signature, so the dispatch code compiles unchanged. Calls spin for a
+// configurable latency and return values derived from their arguments only,
+// which makes runs repeatable on machines without a tester board:
+//   pe32_writel / pe32_readl            register file per board, unwritten registers read 0
+//   pe32_user_fram_save / _load         FRAM bytes per board, unwritten bytes read 0xFF
+//   pe32_rd_alog, pe32_dump_getalog...  one alog and clog word per board and address
+//   pe32_init                           --mock-boards, pe32_check_* always report 1
+//   pe32_usleep                         spins for the requested time on top of the latency
+//   --mock-fail=<command>               throws, like a faulting vendor call
+//   everything else                     a hash of the opcode and the arguments
+#pragma once
+
+#include <windows.h>
+#include <intrin.h>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include "CommandRegistry.h"
+
+namespace MockPE32 {
+
+	constexpr int DEFAULT_BOARD_COUNT = 4;
+
+	// Set from the command line before the first call, read-only afterwards
+	struct Settings {
+		int boardCount = DEFAULT_BOARD_COUNT;
+		std::array<uint64_t, (size_t)Opcode::Count> latencyTicks{};   // Busy wait per call, 0 returns at once
+		std::array<bool, (size_t)Opcode::Count> failing{};            // Calls that throw
+	};
+
+	inline Settings settings;
+
+	// Simulated register and FRAM contents, shared by all channels
+	struct Memory {
+		std::mutex lock;
+		std::unordered_map<uint64_t, int> registers;
+		std::unordered_map<uint64_t, char> fram;
+	};
+
+	inline Memory memory;
+
+	constexpr uint64_t Mix(uint64_t hash, uint64_t value) {
+		hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+		return hash * 0xFF51AFD7ED558CCDull;
+	}
+
+	constexpr uint64_t Key(int bdn, int address) {
+		return ((uint64_t)(uint32_t)bdn << 32) | (uint32_t)address;
+	}
+
+	// Log memory is addressed the same way by every read command
+	constexpr int LogWord(int kind, int bdn, int addr) {
+		return (int)(Mix(Mix(kind, (uint32_t)bdn), (uint32_t)addr) & 0xFFFF);
+	}
+
+	// Out-parameters do not take part, so a call returns the same values every time
+	template <typename T>
+	uint64_t MixArgument(uint64_t hash, T value) {
+		if constexpr (std::is_same_v<T, const char*>) {
+			for (const char* c = value; c != nullptr && *c != '\0'; c++) {
+				hash = Mix(hash, (uint8_t)*c);
+			}
+			return hash;
+		}
+		else if constexpr (std::is_arithmetic_v<T>) {
+			return Mix(hash, (uint64_t)(int64_t)value);
+		}
+		else {
+			return hash;
+		}
+	}
+
+	template <typename R>
+	R Value(uint64_t seed) {
+		if constexpr (std::is_same_v<R, const char*>) {
+			return "PE32 mock backend";
+		}
+		else if constexpr (std::is_floating_point_v<R>) {
+			return (R)(seed % 10000000) / 1000000;
+		}
+		else {
+			return (R)(seed & 0x7FFFFFFF);
+		}
+	}
+
+	// Sleep() is far too coarse for microsecond latencies
+	inline void Spin(uint64_t ticks) {
+		if (ticks == 0) {
+			return;
+		}
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		uint64_t end = (uint64_t)now.QuadPart + ticks;
+		do {
+			_mm_pause();
+			QueryPerformanceCounter(&now);
+		} while ((uint64_t)now.QuadPart < end);
+	}
+
+	inline uint64_t MicrosecondsToTicks(double microseconds) {
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		return (uint64_t)(microseconds * frequency.QuadPart / 1000000);
+	}
+
+	inline void Delay(Opcode opcode) {
+		Spin(settings.latencyTicks[(size_t)opcode]);
+	}
+
+	template <Opcode Op, typename Signature>
+	struct Command;
+
+	template <Opcode Op, typename R, typename... A>
+	struct Command<Op, R(A...)> {
+		static constexpr std::string_view name = kCommands[(size_t)Op].name;
+
+		R operator()(A... args) const {
+			Delay(Op);
+			if (settings.failing[(size_t)Op]) {
+				throw std::runtime_error(std::string(name) + " failed (--mock-fail)");
+			}
+			std::tuple<A...> in(args...);
+			if constexpr (Op == Opcode::pe32_init) {
+				return settings.boardCount;
+			}
+			else if constexpr (Op == Opcode::pe32_usleep) {
+				Spin(MicrosecondsToTicks(std::get<0>(in)));
+			}
+			else if constexpr (Op == Opcode::pe32_writel) {
+				std::lock_guard<std::mutex> guard(memory.lock);
+				memory.registers[Key(std::get<0>(in), std::get<1>(in))] = std::get<2>(in);
+			}
+			else if constexpr (Op == Opcode::pe32_readl) {
+				std::lock_guard<std::mutex> guard(memory.lock);
+				auto found = memory.registers.find(Key(std::get<0>(in), std::get<1>(in)));
+				*std::get<2>(in) = found != memory.registers.end() ? found->second : 0;
+				return 0;
+			}
+			else if constexpr (Op == Opcode::pe32_user_fram_save) {
+				auto [bdn, add, data, size] = in;
+				std::lock_guard<std::mutex> guard(memory.lock);
+				for (int i = 0; data != nullptr && i < size; i++) {
+					memory.fram[Key(bdn, add + i)] = data[i];
+				}
+			}
+			else if constexpr (Op == Opcode::pe32_rd_alog || Op == Opcode::pe32_dump_getalog) {
+				return LogWord(0, std::get<0>(in), std::get<1>(in));
+			}
+			else if constexpr (Op == Opcode::pe32_rd_clog || Op == Opcode::pe32_dump_getclog) {
+				return LogWord(1, std::get<0>(in), std::get<1>(in));
+			}
+			else if constexpr (Op == Opcode::pe32_rd_alogclog || Op == Opcode::pe32_dump_getalogclog) {
+				*std::get<2>(in) = LogWord(0, std::get<0>(in), std::get<1>(in));
+				*std::get<3>(in) = LogWord(1, std::get<0>(in), std::get<1>(in));
+				return 0;
+			}
+			else if constexpr (name.substr(0, 11) == "pe32_check_") {
+				return 1;
+			}
+			else {
+				uint64_t seed = (uint64_t)Op;
+				((seed = MixArgument(seed, args)), ...);
+				int out = 0;
+				(FillOut(args, seed, out), ...);
+				if constexpr (!std::is_void_v<R>) {
+					return Value<R>(seed);
+				}
+			}
+		}
+
+	private:
+		template <typename T>
+		static void FillOut(T value, uint64_t seed, int& index) {
+			if constexpr (std::is_same_v<T, int*>) {
+				if (value != nullptr) {
+					*value = Value<int>(Mix(seed, ++index));
+				}
+			}
+		}
+	};
+
+	// Flags parsed by main, false for anything else
+	inline bool ParseOption(const std::string& arg) {
+		if (arg.rfind("--mock-boards=", 0) == 0) {
+			settings.boardCount = std::stoi(arg.substr(14));
+			return true;
+		}
+		if (arg.rfind("--mock-fail=", 0) == 0) {
+			const CommandInfo* command = FindCommand(std::string_view(arg).substr(12));
+			if (command == nullptr) {
+				throw std::invalid_argument("Unknown command in " + arg);
+			}
+			settings.failing[(size_t)command->opcode] = true;
+			return true;
+		}
+		if (arg.rfind("--mock-latency=", 0) != 0) {
+			return false;
+		}
+
+		// --mock-latency=<us> for every command, --mock-latency=<command>:<us> for one
+		std::string value = arg.substr(15);
+		size_t colon = value.find(':');
+		uint64_t ticks = MicrosecondsToTicks(std::stod(value.substr(colon == std::string::npos ? 0 : colon + 1)));
+		if (colon == std::string::npos) {
+			settings.latencyTicks.fill(ticks);
+			return true;
+		}
+		const CommandInfo* command = FindCommand(std::string_view(value).substr(0, colon));
+		if (command == nullptr) {
+			throw std::invalid_argument("Unknown command in " + arg);
+		}
+		settings.latencyTicks[(size_t)command->opcode] = ticks;
+		return true;
+	}
+}
+
+// Vendor entry points with the signatures of PE32Commands.h. Wrapped commands
+// are local functions, only the vendor calls they make are declared below.
+#define PE32_COMMAND(name, signature) inline constexpr MockPE32::Command<Opcode::name, signature> name{};
+#define PE32_COMMAND_EX(name, signature, target)
+#include "PE32Commands.h"
+#undef PE32_COMMAND_EX
+#undef PE32_COMMAND
+
+inline int pe32_user_fram_load(int bdn, int add, char* data, int size) {
+	MockPE32::Delay(Opcode::pe32_user_fram_load);
+	std::lock_guard<std::mutex> guard(MockPE32::memory.lock);
+	for (int i = 0; i < size; i++) {
+		auto found = MockPE32::memory.fram.find(MockPE32::Key(bdn, add + i));
+		data[i] = found != MockPE32::memory.fram.end() ? found->second : (char)0xFF;
+	}
+	return 0;
+}
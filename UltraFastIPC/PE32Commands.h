@@ -0,0 +1,231 @@
+// PE32Commands.h - Declarative list of the PE32 entry points served over IPC
+//
+// Every entry is PE32_COMMAND(name, signature) where signature is the wire
+// signature of the call written as a function type. Opcode ids are assigned
+// in list order, so new commands must only ever be appended.
+//
+// Parameter types map onto the binary protocol as follows:
+//   int, long, short, unsigned long   packed little-endian int32
+//   double                            packed little-endian IEEE 754 double
+//   const char*                       uint32 length + bytes + NUL terminator
+//   int*                              out-parameter, not sent by the client, int32 out-value
+//   OutBytes*                         out-parameter filled by a wrapper, uint32 length + bytes
+//   BulkBuffer*                       out-parameter in the slot's bulk region, uint32 offset + size
+//   const BulkInput*                  in-parameter the client wrote to the slot's bulk region, uint32 offset + size
+//
+// Binary responses carry the return value followed by the out-values in
+// signature order, text responses list them separated by spaces.
+//
+// PE32_COMMAND_EX(name, signature, target) is used where the vendor call can
+// not be forwarded as-is and a local wrapper is invoked instead.
+//
+// This file is included several times with different definitions of the
+// macros, so it deliberately has no include guard.
+
+#ifndef PE32_COMMAND_EX
+#define PE32_COMMAND_EX(name, signature, target) PE32_COMMAND(name, signature)
+#define PE32_COMMAND_EX_DEFAULTED
+#endif
+
+PE32_COMMAND(pe32_init,                  int())
+PE32_COMMAND(pe32_usb,                   int())
+PE32_COMMAND(pe32_readl,                 int(int bdn, int offset, int* buffer))
+PE32_COMMAND(pe32_writel,                void(int bdn, int offset, int buf))
+PE32_COMMAND(pe32_set_sctl,              void(int bdn, int data))
+PE32_COMMAND(pe32_set_sdata,             void(int bdn, int data))
+PE32_COMMAND(pe32_rd_sio,                int(int bdn))
+PE32_COMMAND(pe32_wr_pe,                 void(int bdn, int chip, int port, int data))
+PE32_COMMAND(pe32_rd_pe,                 int(int bdn, int chip, int port))
+PE32_COMMAND(pe32_rst_pe,                void(int bdn))
+PE32_COMMAND(pe32_usleep,                void(int usec))
+
+// Common functions
+PE32_COMMAND(pe32_api,                   int())
+PE32_COMMAND(pe32_reset,                 void(int bdn))
+PE32_COMMAND(pe32_fdiag,                 int(int bdn))
+PE32_COMMAND(pe32_fstart,                void(int bdn, int onoff))
+PE32_COMMAND(pe32_diag_fstart,           void(int bdn, int onoff))
+PE32_COMMAND(pe32_cycle,                 void(int bdn, int onoff))
+PE32_COMMAND(pe32_check_reset,           int(int bdn))
+PE32_COMMAND(pe32_check_fstart,          int(int bdn))
+PE32_COMMAND(pe32_check_cycle,           int(int bdn))
+PE32_COMMAND(pe32_check_tprun,           int(int bdn))
+PE32_COMMAND(pe32_check_sync,            int(int bdn))
+PE32_COMMAND(pe32_check_testbeg,         int(int bdn))
+PE32_COMMAND(pe32_check_tpass,           int(int bdn))
+PE32_COMMAND(pe32_check_ftend,           int(int bdn))
+PE32_COMMAND(pe32_check_lend,            int(int bdn))
+PE32_COMMAND(pe32_set_pxi,               void(int bdn, int data))
+PE32_COMMAND(pe32_pxi_fstart,            void(int bdn, int ch, int onoff))
+PE32_COMMAND(pe32_pxi_cfail,             void(int bdn, int ch, int onoff))
+PE32_COMMAND(pe32_pxi_lmsyn,             void(int bdn, int ch, int onoff))
+PE32_COMMAND(pe32_set_addbeg,            void(int bdn, long add))
+PE32_COMMAND(pe32_set_addend,            void(int bdn, long cnt))
+PE32_COMMAND(pe32_set_ftcnt,             void(int bdn, long cnt))
+PE32_COMMAND(pe32_set_addsyn,            void(int bdn, long add))
+PE32_COMMAND(pe32_set_addif,             void(int bdn, long add))
+PE32_COMMAND(pe32_set_logadd,            void(int bdn, long add))
+PE32_COMMAND(pe32_set_seq,               void(int bdn, long data))
+PE32_COMMAND(pe32_set_lmf,               void(int bdn, long data))
+PE32_COMMAND(pe32_set_mmsk,              void(int bdn, long data))
+PE32_COMMAND(pe32_set_tp,                void(int bdn, int ts, long data))
+PE32_COMMAND(pe32_set_tstrob,            void(int bdn, int pno, int ts, long data))
+PE32_COMMAND(pe32_set_tstart,            void(int bdn, int pno, int ts, long data))
+PE32_COMMAND(pe32_set_tstop,             void(int bdn, int pno, int ts, long data))
+PE32_COMMAND(pe32_set_rz,                void(int bdn, int fs, long data))
+PE32_COMMAND(pe32_set_ro,                void(int bdn, int ts, long data))
+PE32_COMMAND(pe32_set_io,                void(int bdn, int ts, long data))
+PE32_COMMAND(pe32_set_mk,                void(int bdn, int ts, long data))
+PE32_COMMAND(pe32_set_dstrob,            void(int bdn, int pno, int ts, long data1, long data2))
+PE32_COMMAND(pe32_rd_actseq,             void(int bdn))
+PE32_COMMAND(pe32_rd_actlmf,             long(int bdn))
+PE32_COMMAND(pe32_rd_actlmd,             long(int bdn))
+PE32_COMMAND(pe32_rd_actlmm,             long(int bdn))
+PE32_COMMAND(pe32_rd_actlmadd,           long(int bdn))
+PE32_COMMAND(pe32_rd_pxibus,             int(int bdn))
+PE32_COMMAND(pe32_rd_id,                 int(int bdn))
+PE32_COMMAND(pe32_rd_vc,                 int(int bdn))
+PE32_COMMAND(pe32_rd_seq,                long(int bdn))
+PE32_COMMAND(pe32_rd_lmf,                long(int bdn))
+PE32_COMMAND(pe32_rd_lmd,                long(int bdn))
+PE32_COMMAND(pe32_rd_lmm,                long(int bdn))
+PE32_COMMAND(pe32_rd_lmadd,              long(int bdn))
+PE32_COMMAND(pe32_lmload,                int(int begbdno, int boardwidth, long begadd, const char* patternfile))
+PE32_COMMAND(pe32_lmsave,                int(int begbdno, int boardwidth, long begadd, long endadd, const char* patternfile))
+PE32_COMMAND(pe32_rd_cmph,               long(int bdn))
+PE32_COMMAND(pe32_rd_cmpl,               long(int bdn))
+PE32_COMMAND(pe32_rd_creg,               long(int bdn))
+PE32_COMMAND(pe32_rd_ftcnt,              unsigned long(int bdn))
+PE32_COMMAND(pe32_rd_fccnt,              unsigned long(int bdn))
+PE32_COMMAND(pe32_rd_flcnt,              unsigned long(int bdn))
+PE32_COMMAND(pe32_rd_clog,               int(int bdn, int addr))
+PE32_COMMAND(pe32_rd_alog,               int(int bdn, int addr))
+PE32_COMMAND(pe32_rd_logadd,             int(int bdn))
+PE32_COMMAND(pe32_rd_alogclog,           int(int bdn, int addr, int* alog, int* clog))
+PE32_COMMAND(pe32_dump_alogclog,         int(int bdn, int ksize, int* alog, int* clog))
+PE32_COMMAND(pe32_set_dumpmode,          void(int bdn, int onoff))
+PE32_COMMAND(pe32_dump_getclog,          int(int bdn, int addr))
+PE32_COMMAND(pe32_dump_getalog,          int(int bdn, int addr))
+PE32_COMMAND(pe32_dump_getalogclog,      int(int bdn, int add, int* alog, int* clog))
+PE32_COMMAND(pe32_check_dataready,       int(int bdn))
+PE32_COMMAND(pe32_check_checkmode,       int(int bdn))
+PE32_COMMAND(pe32_check_logmode,         int(int bdn))
+PE32_COMMAND(pe32_check_trigmode,        int(int bdn))
+PE32_COMMAND(pe32_check_dualmode,        int(int bdn))
+PE32_COMMAND(pe32_set_trigmode,          void(int bdn, int onoff))
+PE32_COMMAND(pe32_set_logmode,           void(int bdn, int onoff))
+PE32_COMMAND(pe32_check_ucnt,            int(int bdn))
+PE32_COMMAND(pe32_set_checkmode,         void(int bdn, int onoff))
+PE32_COMMAND(pe32_set_vih,               void(int bdn, int pno, double rv))
+PE32_COMMAND(pe32_set_vil,               void(int bdn, int pno, double rv))
+PE32_COMMAND(pe32_set_voh,               void(int bdn, int pno, double rv))
+PE32_COMMAND(pe32_set_vol,               void(int bdn, int pno, double rv))
+PE32_COMMAND(pe32_set_driver,            void(int bdn, int pno, int onoff))
+PE32_COMMAND(pe32_cpu_df,                void(int bdn, int pno, int donoff, int fonoff))
+PE32_COMMAND(pe32_pmufv,                 void(int bdn, int chip, double rv, double clamp))
+PE32_COMMAND(pe32_pmufi,                 void(int bdn, int chip, double ri, double cvh, double cvl))
+PE32_COMMAND(pe32_pmufir,                void(int bdn, int chip, double ri, double cvh, double cvl, int rang))
+PE32_COMMAND(pe32_vmeas,                 double(int bdn, int pno))
+PE32_COMMAND(pe32_imeas,                 double(int bdn, int pno))
+PE32_COMMAND(pe32_pmucv,                 void(int bdn, int chip, double cvh, double cvl))
+PE32_COMMAND(pe32_pmuci,                 void(int bdn, int chip, double cih, double cil))
+PE32_COMMAND(pe32_con_pmu,               void(int bdn, int pno, int onoff))
+PE32_COMMAND(pe32_con_pmus,              void(int bdn, int pno, int onoff))
+PE32_COMMAND(pe32_con_receiver,          void(int bdn, int pno, int onoff))
+PE32_COMMAND(pe32_check_pmu,             int(int bdn, int chip))
+PE32_COMMAND(pe32_pmuch,                 int(int bdn, int chip))
+PE32_COMMAND(pe32_pmucl,                 int(int bdn, int chip))
+PE32_COMMAND(pe32_cal_load,              int(int bdn, const char* calfile))
+PE32_COMMAND(pe32_cal_save,              int(int bdn, const char* calfile))
+PE32_COMMAND(pe32_cal_load_auto,         int(int bdn, const char* calfile))
+PE32_COMMAND(pe32_cal_save_auto,         int(int bdn, const char* calfile))
+PE32_COMMAND(pe32_cal_reset,             void(int bdn))
+PE32_COMMAND(pe32_con_esense,            void(int bdn, int pno, int onoff))
+PE32_COMMAND(pe32_con_eforce,            void(int bdn, int pno, int onoff))
+PE32_COMMAND(pe32_con_ext,               void(int bdn, int pno, int onoff))
+PE32_COMMAND(pe32_set_deskew,            void(int bdn, int pno, int rt))
+PE32_COMMAND(pe32_set_fallingskew,       void(int bdn, int pno, int rt))
+PE32_COMMAND(pe32_set_rcvskew,           void(int bdn, int pno, int rt))
+PE32_COMMAND(pe32_set_rcvfallingskew,    void(int bdn, int pno, int rt))
+PE32_COMMAND(pe32_getch,                 int(int bdn, int pno))
+PE32_COMMAND(pe32_getcl,                 int(int bdn, int pno))
+PE32_COMMAND(pemu32_rst_pe,              void(int bdn))
+PE32_COMMAND(pemu32_set_driver,          void(int bdn, int pno, int onoff))
+PE32_COMMAND(pe32_counter_ctp,           void(int bdn, long data))
+PE32_COMMAND(pe32_counter_start,         void(int bdn, int onoff))
+PE32_COMMAND(pe32_counter_select_ch,     void(int bdn, int ch))
+PE32_COMMAND(pe32_counter_rd,            long(int bdn))
+PE32_COMMAND(pe32_counter_rdfrq,         double(int bdn))
+PE32_COMMAND(pe32_counter_tmmode,        void(int bdn, int onoff))
+PE32_COMMAND(pe32_tmu_cstart_inv,        void(int bdn, int onoff))
+PE32_COMMAND(pe32_tmu_cstop_inv,         void(int bdn, int onoff))
+PE32_COMMAND(pe32_tmu_select_cstart,     void(int bdn, int ch))
+PE32_COMMAND(pe32_tmu_select_cstop,      void(int bdn, int ch))
+PE32_COMMAND(pe32_rd_pesno,              int(int bdn))
+PE32_COMMAND(pe32_get_temp,              double(int bdn, int cno))
+PE32_COMMAND(pe32_set_srdmode,           void(int bdn, int onoff))
+PE32_COMMAND(pe32_srd_select_ch,         void(int bdn, int ch))
+PE32_COMMAND(pe32_srd_getword,           int(int bdn))
+PE32_COMMAND(pe32_srd_getword2,          int(int bdn))
+PE32_COMMAND(pe32_srd_getsrword,         int(int bdn, int ch))
+PE32_COMMAND(pe32_srd_rdblock32,         void(int bdn, long add, int* rdblock32))
+PE32_COMMAND(pe32_setReg,                void(int bdn, int pno, int dacno, int rv))
+PE32_COMMAND(pe32_dc_range,              void(int bdn, int range))
+PE32_COMMAND(pe32_set_lmsyn_active_high, void(int bdn, int onoff))
+PE32_COMMAND(pe32_set_lmsyn_ch,          void(int bdn, int ch))
+PE32_COMMAND(pe32_rd_logcnt,             int(int bdn))
+PE32_COMMAND(pe32_reset_lmiomk,          void(int bdn))
+PE32_COMMAND(pe32_con_2k2vtt,            void(int bdn, int pno, int onoff, double vtt))
+PE32_COMMAND(pe32_get_msg,               const char*())
+PE32_COMMAND(pe32_set_rffemode,          void(int bdn, int port, int onoff))
+PE32_COMMAND(pe32_rffe_ftp,              void(int bdn, int wtp, int rtp))
+PE32_COMMAND(pe32_rffe_pclk,             void(int bdn, int pclk))
+PE32_COMMAND(pe32_rffe_wr,               void(int bdn, int port, int sadd, int add, short data))
+PE32_COMMAND(pe32_rffe_rd,               int(int bdn, int port, int sadd, int add))
+PE32_COMMAND(pe32_rffe_ewr,              void(int bdn, int port, int sadd, int add, short data, int bcnt))
+PE32_COMMAND(pe32_rffe_erd,              int(int bdn, int port, int sadd, int add, int bcnt))
+PE32_COMMAND(pe32_rffe_getword,          int(int bdn, int port))
+PE32_COMMAND(pe32_rffe_wr0,              void(int bdn, int port, int sadd, short data))
+PE32_COMMAND(pe32_rffe_elwr,             void(int bdn, int port, int sadd, int add, int data, int bcnt))
+PE32_COMMAND(pe32_rffe_elrd,             int(int bdn, int port, int sadd, int add, int bcnt))
+PE32_COMMAND(pe32_rffe_cmdwr,            void(int bdn, int port, int sadd, int cmd, int add, int data, int bcnt))
+PE32_COMMAND(pe32_rffe_cmdrd,            void(int bdn, int port, int sadd, int cmd, int add, int data, int bcnt))
+PE32_COMMAND(pe32_set_qmode,             void(int bdn, int onoff))
+PE32_COMMAND(pe32_check_qfail,           int(int bdn, int cno))
+PE32_COMMAND(pe32_set_rodvhdvl,          void(int bdn, int pno, int rodvh, int rodvl))
+PE32_COMMAND(pe32_rd_PciRevId,           int(int bdn))
+PE32_COMMAND(pe32_rd_PciDevId,           int(int bdn))
+PE32_COMMAND(pe32_rd_PciSubId,           int(int bdn))
+PE32_COMMAND(pe32_trig_mv,               void(int bdn, int pno, int pxitrg))
+PE32_COMMAND(pe32_trig_mi,               void(int bdn, int pno, int pxitrg))
+PE32_COMMAND(pe32_trig_imeas,            double(int bdn, int pno))
+PE32_COMMAND(pe32_trig_vmeas,            double(int bdn, int pno))
+PE32_COMMAND(pe32_user_fram_save,        void(int bdn, int add, const char* data, int size))
+PE32_COMMAND_EX(pe32_user_fram_load,     int(int bdn, int add, int size, OutBytes* data), UserFramLoad)
+
+// Bulk reads: one request fills the slot's bulk region instead of one round trip per value
+PE32_COMMAND_EX(pe32_bulk_dump_getalog,  void(int bdn, int addr, int count, BulkBuffer* alog), BulkDumpGetAlog)
+PE32_COMMAND_EX(pe32_bulk_dump_getclog,  void(int bdn, int addr, int count, BulkBuffer* clog), BulkDumpGetClog)
+PE32_COMMAND_EX(pe32_bulk_srd_getword,   void(int bdn, int count, BulkBuffer* words), BulkSrdGetWord)
+
+// Range reads: the loop over [begin, end) runs next to the vendor DLL and packs int32 values per item
+PE32_COMMAND_EX(pe32_bulk_dump_getalogclog, void(int bdn, int begin, int end, BulkBuffer* alogclog), BulkDumpGetAlogClog)  // alog, clog per address
+PE32_COMMAND_EX(pe32_bulk_srd_rdblock32,    void(int bdn, int begin, int end, BulkBuffer* blocks), BulkSrdRdBlock32)       // One value per block
+PE32_COMMAND_EX(pe32_bulk_rd_lm,            void(int begin, int end, BulkBuffer* lm), BulkRdLm)                             // lmf, lmd, lmm per board
+
+// Loopback commands, they never enter the vendor DLL and measure the IPC path alone.
+// bdn only selects the channel.
+PE32_COMMAND_EX(ipc_nop,        void(int bdn), IpcNop)
+PE32_COMMAND_EX(ipc_echo,       int(int bdn, int value), IpcEcho)
+PE32_COMMAND_EX(ipc_echo_bytes, int(int bdn, int size, OutBytes* data), IpcEchoBytes)      // size bytes in the response
+PE32_COMMAND_EX(ipc_echo_bulk,  void(int bdn, int size, BulkBuffer* data), IpcEchoBulk)    // size bytes in the bulk region
+
+// Pattern cache, see PatternCache.h: a pattern goes through the bulk region once and is loaded by content hash.
+// pe32_pattern_store returns the bytes still missing, pe32_pattern_lmload returns PATTERN_NOT_CACHED for unknown hashes.
+PE32_COMMAND_EX(pe32_pattern_store,  int(int hashlo, int hashhi, int offset, int total, const BulkInput* chunk), PatternStore)
+PE32_COMMAND_EX(pe32_pattern_lmload, int(int begbdno, int boardwidth, long begadd, int hashlo, int hashhi), PatternLmLoad)
+
+#ifdef PE32_COMMAND_EX_DEFAULTED
+#undef PE32_COMMAND_EX
+#undef PE32_COMMAND_EX_DEFAULTED
+#endif
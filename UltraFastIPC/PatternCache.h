@@ -0,0 +1,210 @@
+// PatternCache.h - Pattern files kept by content hash for pe32_lmload
+//
+// The vendor DLL loads local memory only from a file. pe32_pattern_store
+// streams a pattern through the bulk region into <dir>\<hash>.pat, once per
+// content, and pe32_pattern_lmload hands that file to pe32_lmload. The files
+// outlive the bridge, so later lots and later bridges find them as well.
+// A complete pattern is hashed again before it gets its name, so a client
+// sending the wrong hash can not leave a wrong pattern under it.
+#pragma once
+
+#include <windows.h>
+#include <bcrypt.h>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "CommandRegistry.h"
+#include "DispatchPolicy.h"
+#include "ShadowRegisters.h"
+
+// Returned by pe32_pattern_lmload when no pattern with the hash has been stored yet
+constexpr int32_t PATTERN_NOT_CACHED = INT32_MIN;
+
+class PatternCache {
+public:
+	// Set by --pattern-cache=<dir>, defaults to UltraFastIPC\Patterns in the temp directory
+	static inline std::filesystem::path directory;
+
+	// Appends size bytes at offset of the pattern, chunks arrive in order. Returns the
+	// number of bytes still missing, 0 once the pattern is complete or was stored before.
+	static int Store(uint64_t hash, uint32_t offset, uint32_t total, const char* data, uint32_t size) {
+		std::lock_guard<std::mutex> guard(lock);
+		std::filesystem::path path = PatternPath(hash);
+		if (std::filesystem::exists(path)) {
+			partial.erase(hash);
+			return 0;
+		}
+
+		// A chunk at offset 0 starts over, e.g. after a client gave up half way
+		auto found = partial.find(hash);
+		if (offset == 0 && found != partial.end()) {
+			partial.erase(found);
+			found = partial.end();
+		}
+		if (found == partial.end()) {
+			if (offset != 0) {
+				throw std::invalid_argument("pe32_pattern_store chunk does not follow the stored part");
+			}
+			std::filesystem::create_directories(directory);
+			PartialPattern started;
+			started.file.open(PartPath(hash), std::ios::binary | std::ios::trunc);
+			started.total = total;
+			found = partial.emplace(hash, std::move(started)).first;
+		}
+
+		PartialPattern& pattern = found->second;
+		if (offset != pattern.received || total != pattern.total || (uint64_t)offset + size > total) {
+			partial.erase(found);
+			throw std::invalid_argument("pe32_pattern_store chunk does not follow the stored part");
+		}
+		pattern.file.write(data, size);
+		pattern.received += size;
+		if (!pattern.file) {
+			partial.erase(found);
+			throw std::runtime_error("Writing the pattern cache failed");
+		}
+		if (pattern.received < pattern.total) {
+			return (int)(pattern.total - pattern.received);
+		}
+
+		// Renamed only when complete and verified, so a pattern file is never seen half written or wrong
+		pattern.file.close();
+		partial.erase(found);
+		std::filesystem::path part = PartPath(hash);
+		if (ContentHash(part) != hash) {
+			std::filesystem::remove(part);
+			throw std::invalid_argument("pe32_pattern_store content does not match its hash");
+		}
+		std::filesystem::rename(part, path);
+		return 0;
+	}
+
+	// Path of a stored pattern, empty if there is none
+	static std::string Find(uint64_t hash) {
+		std::lock_guard<std::mutex> guard(lock);
+		std::filesystem::path path = PatternPath(hash);
+		return std::filesystem::exists(path) ? path.string() : std::string();
+	}
+
+	// With --shadow-writes, boards remember which pattern they hold. A load of
+	// the same hash to the same place is then skipped like a shadowed write.
+	static bool IsResident(int begbdno, int boardwidth, long begadd, uint64_t hash) {
+		if (!ShadowRegisters::enabled || boardwidth <= 0) {
+			return false;
+		}
+		std::lock_guard<std::mutex> guard(lock);
+		for (int bdn = begbdno; bdn < begbdno + boardwidth; bdn++) {
+			auto found = resident.find(bdn);
+			if (found == resident.end() || found->second.begbdno != begbdno || found->second.boardwidth != boardwidth
+				|| found->second.begadd != begadd || found->second.hash != hash) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Only a load that returned 0 is known to have succeeded
+	static void Loaded(int begbdno, int boardwidth, long begadd, uint64_t hash, int result) {
+		if (!ShadowRegisters::enabled) {
+			return;
+		}
+		std::lock_guard<std::mutex> guard(lock);
+		for (int bdn = begbdno; bdn < begbdno + boardwidth; bdn++) {
+			if (result == 0) {
+				resident[bdn] = { begbdno, boardwidth, begadd, hash };
+			}
+			else {
+				resident.erase(bdn);
+			}
+		}
+	}
+
+	// Called for every command before the DLL, next to ShadowRegisters::Check. The commands
+	// clearing the shadow and plain pe32_lmload calls also forget the resident patterns.
+	template <typename... A>
+	static void Observe(Opcode opcode, A... args) {
+		if (!ShadowRegisters::enabled) {
+			return;
+		}
+		bool clears = kShadowRoles[(size_t)opcode] == ShadowRole::Clear;
+		if (!clears && opcode != Opcode::pe32_lmload) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> guard(lock);
+		if constexpr (sizeof...(A) > 0) {
+			if (clears && kDispatchPolicies[(size_t)opcode] != DispatchPolicy::GlobalExclusive) {
+				int bdn = (int)std::get<0>(std::make_tuple(args...));
+				resident.erase(bdn);
+				return;
+			}
+		}
+		resident.clear();
+	}
+
+private:
+	struct PartialPattern {
+		std::ofstream file;
+		uint32_t received = 0;
+		uint32_t total = 0;
+	};
+
+	struct ResidentPattern {
+		int begbdno;
+		int boardwidth;
+		long begadd;
+		uint64_t hash;
+	};
+
+	static std::filesystem::path PatternPath(uint64_t hash) {
+		return directory / (HashName(hash) + ".pat");
+	}
+
+	static std::filesystem::path PartPath(uint64_t hash) {
+		return directory / (HashName(hash) + ".part");
+	}
+
+	// First 64 bits of the SHA-256 of the file, like PE32Proxy.PatternHash
+	static uint64_t ContentHash(const std::filesystem::path& path) {
+		BCRYPT_HASH_HANDLE digest = nullptr;
+		if (!BCRYPT_SUCCESS(BCryptCreateHash(BCRYPT_SHA256_ALG_HANDLE, &digest, nullptr, 0, nullptr, 0, 0))) {
+			throw std::runtime_error("Hashing the pattern failed");
+		}
+		std::ifstream file(path, std::ios::binary);
+		std::vector<char> buffer(1 << 16);
+		bool hashed = (bool)file;
+		while (hashed && file) {
+			file.read(buffer.data(), buffer.size());
+			ULONG count = (ULONG)file.gcount();
+			hashed = count == 0 || BCRYPT_SUCCESS(BCryptHashData(digest, (PUCHAR)buffer.data(), count, 0));
+		}
+		UCHAR value[32];
+		hashed = hashed && file.eof() && BCRYPT_SUCCESS(BCryptFinishHash(digest, value, sizeof(value), 0));
+		BCryptDestroyHash(digest);
+		if (!hashed) {
+			throw std::runtime_error("Hashing the pattern failed");
+		}
+		uint64_t hash;
+		memcpy(&hash, value, sizeof(hash));
+		return hash;
+	}
+
+	static std::string HashName(uint64_t hash) {
+		char name[17];
+		snprintf(name, sizeof(name), "%016llx", (unsigned long long)hash);
+		return name;
+	}
+
+	static inline std::mutex lock;
+	static inline std::unordered_map<uint64_t, PartialPattern> partial;
+	static inline std::unordered_map<int, ResidentPattern> resident;
+};
@@ -0,0 +1,193 @@
+// ShadowRegisters.h - Skips level and timing writes that change nothing
+//
+// With --shadow-writes the bridge remembers the last value of every shadowed
+// write, addressed by its opcode and all arguments but the last one. Writing
+// the value the board already holds returns without entering the DLL. Resets,
+// calibration and pe32_init forget what the boards hold.
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include "CommandRegistry.h"
+#include "DispatchPolicy.h"
+
+// The last argument is the value, the others address it
+inline constexpr std::string_view kShadowedCommands[] = {
+	"pe32_set_vih",
+	"pe32_set_vil",
+	"pe32_set_voh",
+	"pe32_set_vol",
+	"pe32_set_tp",
+	"pe32_set_tstrob",
+	"pe32_set_tstart",
+	"pe32_set_tstop",
+	"pe32_set_rz",
+	"pe32_set_ro",
+	"pe32_set_io",
+	"pe32_set_mk",
+	"pe32_set_driver",
+};
+
+// pe32_cal_* clear as well
+inline constexpr std::string_view kShadowClearingCommands[] = {
+	"pe32_init",
+	"pe32_reset",
+	"pe32_rst_pe",
+	"pemu32_rst_pe",
+};
+
+enum class ShadowRole : uint8_t {
+	None,
+	Write,      // Skipped when the shadow already holds its value
+	Clear,      // Forgets the shadow of its board, or of all boards when global
+};
+
+constexpr ShadowRole CommandShadowRole(const CommandInfo& command) {
+	if (ListContains(kShadowedCommands, std::size(kShadowedCommands), command.name)) {
+		return ShadowRole::Write;
+	}
+	if (command.name.substr(0, 9) == "pe32_cal_"
+		|| ListContains(kShadowClearingCommands, std::size(kShadowClearingCommands), command.name)) {
+		return ShadowRole::Clear;
+	}
+	return ShadowRole::None;
+}
+
+// Indexed by opcode
+inline constexpr auto kShadowRoles = [] {
+	std::array<ShadowRole, std::size(kCommands)> roles{};
+	for (size_t i = 0; i < std::size(kCommands); i++) {
+		roles[i] = CommandShadowRole(kCommands[i]);
+	}
+	return roles;
+}();
+
+// A board's shadow is only touched under its DispatchLock, so shadowed writes
+// must lock their board and must not return anything the skip would lose
+constexpr bool ShadowedCommandsFit() {
+	for (size_t i = 0; i < std::size(kCommands); i++) {
+		const CommandInfo& command = kCommands[i];
+		if (kShadowRoles[i] != ShadowRole::Write) {
+			continue;
+		}
+		if (kDispatchPolicies[i] != DispatchPolicy::BoardExclusive || command.returnType != WireType::Void
+			|| command.outCount != 0 || command.argCount < 2 || command.argCount > 4) {
+			return false;
+		}
+		for (size_t k = 0; k < command.argCount; k++) {
+			if (command.argTypes[k] == WireType::String) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+static_assert(ShadowedCommandsFit(), "Shadowed commands must be void(int bdn, ..., value) and lock only their board");
+
+enum class ShadowOutcome : uint8_t {
+	Untracked,      // Not shadowed, or --shadow-writes is off
+	Issued,         // New value, the DLL must be called
+	Skipped,        // The board already holds the value
+};
+
+class ShadowRegisters {
+public:
+	// Set by --shadow-writes
+	static inline bool enabled = false;
+
+	// Called with the command's DispatchLock held, right before the DLL call
+	template <typename... A>
+	static ShadowOutcome Check(Opcode opcode, A... args) {
+		ShadowRole role = kShadowRoles[(size_t)opcode];
+		if (!enabled || role == ShadowRole::None) {
+			return ShadowOutcome::Untracked;
+		}
+
+		if (role == ShadowRole::Clear) {
+			Clear(opcode, args...);
+			return ShadowOutcome::Untracked;
+		}
+
+		if constexpr (sizeof...(A) >= 2) {
+			uint64_t fields[] = { Bits(args)... };
+			constexpr size_t addressCount = sizeof...(A) - 1;
+			uint64_t key;
+			if (!Key(opcode, fields, addressCount, key)) {
+				return ShadowOutcome::Issued;
+			}
+
+			auto& stripe = stripes[(uint32_t)fields[0] % DispatchLock::MAX_BOARD_LOCKS];
+			auto [entry, inserted] = stripe.try_emplace(key, fields[addressCount]);
+			if (!inserted && entry->second == fields[addressCount]) {
+				return ShadowOutcome::Skipped;
+			}
+			entry->second = fields[addressCount];
+		}
+		return ShadowOutcome::Issued;
+	}
+
+	// Called with the DispatchLock still held when the DLL call after Issued threw. The board
+	// may hold the old value, the new one or neither, so the next write must go through.
+	template <typename... A>
+	static void Forget(Opcode opcode, A... args) {
+		if constexpr (sizeof...(A) >= 2) {
+			if (!enabled || kShadowRoles[(size_t)opcode] != ShadowRole::Write) {
+				return;
+			}
+			uint64_t fields[] = { Bits(args)... };
+			uint64_t key;
+			if (Key(opcode, fields, sizeof...(A) - 1, key)) {
+				stripes[(uint32_t)fields[0] % DispatchLock::MAX_BOARD_LOCKS].erase(key);
+			}
+		}
+	}
+
+private:
+	// Opcode and up to three 16 bit address fields, false for larger addresses, which are not shadowed
+	static bool Key(Opcode opcode, const uint64_t* fields, size_t addressCount, uint64_t& key) {
+		key = (uint64_t)opcode;
+		for (size_t i = 0; i < addressCount; i++) {
+			if (fields[i] > 0xFFFF) {
+				return false;
+			}
+			key |= fields[i] << (16 * (i + 1));
+		}
+		return true;
+	}
+
+	template <typename T>
+	static uint64_t Bits(T value) {
+		if constexpr (std::is_floating_point_v<T>) {
+			return std::bit_cast<uint64_t>((double)value);
+		}
+		else if constexpr (std::is_integral_v<T>) {
+			return (uint64_t)(uint32_t)value;
+		}
+		else {
+			return UINT64_MAX;  // Pointers, the commands taking them are never shadowed
+		}
+	}
+
+	// Global commands hold the DLL alone and may clear every stripe, board commands only their own
+	template <typename... A>
+	static void Clear(Opcode opcode, A... args) {
+		if constexpr (sizeof...(A) > 0) {
+			if (!DispatchLock::serialized && kDispatchPolicies[(size_t)opcode] != DispatchPolicy::GlobalExclusive) {
+				uint64_t fields[] = { Bits(args)... };
+				stripes[(uint32_t)fields[0] % DispatchLock::MAX_BOARD_LOCKS].clear();
+				return;
+			}
+		}
+		for (auto& stripe : stripes) {
+			stripe.clear();
+		}
+	}
+
+	// Striped like the board locks of DispatchLock, which guard them
+	static inline std::array<std::unordered_map<uint64_t, uint64_t>, DispatchLock::MAX_BOARD_LOCKS> stripes;
+};
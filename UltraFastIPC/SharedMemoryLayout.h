@@ -0,0 +1,106 @@
+// SharedMemoryLayout.h - Shared memory mapping between the bridge and the C# client
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "BinaryProtocol.h"
+
+// Shared memory layout version, the client refuses to talk to a different one
+// 1 = a single request/response pair with a request_flag/response_flag handshake
+// 2 = ring of RING_SLOT_COUNT slots with per-slot sequence numbers
+// 3 = adds the sticky error word for fire-and-forget requests
+// 4 = adds the server_waiting/client_waiting words of the hybrid wait
+// 5 = client written, server written and payload regions on separate cache lines
+// 6 = adds bulk_slot_size of the <name>_Bulk mapping
+// 7 = per-slot submit, pickup, DLL enter/exit and publish timestamps
+// 8 = adds the server_cpu/client_cpu placement of the channel threads
+constexpr uint32_t SHARED_MEMORY_LAYOUT_VERSION = 8;
+constexpr uint32_t RING_SLOT_COUNT = 16;
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// The bulk mapping is split evenly between the slots, so a bulk payload stays
+// readable exactly as long as the response that refers to it
+constexpr uint32_t DEFAULT_BULK_SIZE = 16 * 1024 * 1024;
+
+// One request/response slot of the ring. Request number n (counting from 1) uses
+// slot (n - 1) % RING_SLOT_COUNT. The client publishes it by storing n into
+// request_sequence, the server completes it by storing n into response_sequence.
+struct RingSlot {
+	// Written by the client
+	alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> request_sequence{ 0 };  // Sequence of the request in this slot
+	uint32_t protocol_version;                  // Wire format of the request, see ProtocolVersion
+	uint32_t request_size;                      // Length of request data
+	uint64_t submit_time;                       // Client post, QueryPerformanceCounter ticks like every time below
+
+	// Written by the server
+	alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> response_sequence{ 0 }; // Sequence of the response in this slot
+	uint32_t response_size;                     // Length of response data
+	uint64_t pickup_time;                       // Server read the request
+	uint64_t dll_enter_time;                    // First vendor DLL call started, 0 if the request made none
+	uint64_t dll_exit_time;                     // Last vendor DLL call returned
+	uint64_t publish_time;                      // Response published
+
+	alignas(CACHE_LINE_SIZE) char request_data[MESSAGE_BUFFER_SIZE];   // Request data buffer
+	alignas(CACHE_LINE_SIZE) char response_data[MESSAGE_BUFFER_SIZE];  // Response data buffer
+};
+
+// Shared memory layout - This is the "common language" between two processes
+struct SharedMemoryLayout {
+	// Written once by the server before the client connects
+	alignas(CACHE_LINE_SIZE) uint32_t layout_version;   // SHARED_MEMORY_LAYOUT_VERSION
+	uint32_t layout_size;                       // sizeof(SharedMemoryLayout), checked by the client
+	uint32_t slot_count;                        // RING_SLOT_COUNT
+	uint32_t bulk_slot_size;                    // Bytes of <name>_Bulk owned by each slot, slot i starts at i * bulk_slot_size
+	int32_t server_cpu;                         // CPU the channel thread is pinned to, -1 if it is not pinned
+	int32_t client_cpu;                         // CPU sharing a cache with server_cpu for the client thread, -1 for none
+
+	// Written by the server
+	// First failure of a BINARY_FLAG_NO_REPLY request, cleared by the client once reported
+	alignas(CACHE_LINE_SIZE) std::atomic<int32_t> sticky_error{ 0 };  // BinaryStatus, 0 = no error latched
+	uint32_t sticky_error_opcode;               // Opcode of the failed request
+	uint32_t sticky_error_sequence;             // Sequence of the failed request
+	std::atomic<uint32_t> server_waiting{ 0 };  // Set while the server waits on <name>_RequestEvent
+
+	// Performance statistics - For monitoring and optimization, the full counters are in <name>_Stats
+	uint64_t last_request_time;                // Pickup of the last request (QueryPerformanceCounter ticks)
+	uint64_t last_response_time;               // Response publish of the last request (QueryPerformanceCounter ticks)
+
+	// Written by the client
+	alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> client_waiting{ 0 };  // Set while the client waits on <name>_ResponseEvent
+
+	// Single producer (client) / single consumer (server) request ring
+	RingSlot slots[RING_SLOT_COUNT];
+};
+
+// The C# client hard-codes these offsets (FieldOffset in PE32Proxy/UltraFastIPCClient.cs),
+// change both sides together and bump SHARED_MEMORY_LAYOUT_VERSION
+static_assert(offsetof(RingSlot, request_sequence) == 0, "RingSlot layout changed");
+static_assert(offsetof(RingSlot, protocol_version) == 4, "RingSlot layout changed");
+static_assert(offsetof(RingSlot, request_size) == 8, "RingSlot layout changed");
+static_assert(offsetof(RingSlot, submit_time) == 16, "RingSlot layout changed");
+static_assert(offsetof(RingSlot, response_sequence) == 64, "RingSlot layout changed");
+static_assert(offsetof(RingSlot, response_size) == 68, "RingSlot layout changed");
+static_assert(offsetof(RingSlot, pickup_time) == 72, "RingSlot layout changed");
+static_assert(offsetof(RingSlot, dll_enter_time) == 80, "RingSlot layout changed");
+static_assert(offsetof(RingSlot, dll_exit_time) == 88, "RingSlot layout changed");
+static_assert(offsetof(RingSlot, publish_time) == 96, "RingSlot layout changed");
+static_assert(offsetof(RingSlot, request_data) == 128, "RingSlot layout changed");
+static_assert(offsetof(RingSlot, response_data) == 4224, "RingSlot layout changed");
+static_assert(sizeof(RingSlot) == 8320, "RingSlot layout changed");
+
+static_assert(offsetof(SharedMemoryLayout, layout_version) == 0, "SharedMemoryLayout changed");
+static_assert(offsetof(SharedMemoryLayout, layout_size) == 4, "SharedMemoryLayout changed");
+static_assert(offsetof(SharedMemoryLayout, slot_count) == 8, "SharedMemoryLayout changed");
+static_assert(offsetof(SharedMemoryLayout, bulk_slot_size) == 12, "SharedMemoryLayout changed");
+static_assert(offsetof(SharedMemoryLayout, server_cpu) == 16, "SharedMemoryLayout changed");
+static_assert(offsetof(SharedMemoryLayout, client_cpu) == 20, "SharedMemoryLayout changed");
+static_assert(offsetof(SharedMemoryLayout, sticky_error) == 64, "SharedMemoryLayout changed");
+static_assert(offsetof(SharedMemoryLayout, sticky_error_opcode) == 68, "SharedMemoryLayout changed");
+static_assert(offsetof(SharedMemoryLayout, sticky_error_sequence) == 72, "SharedMemoryLayout changed");
+static_assert(offsetof(SharedMemoryLayout, server_waiting) == 76, "SharedMemoryLayout changed");
+static_assert(offsetof(SharedMemoryLayout, last_request_time) == 80, "SharedMemoryLayout changed");
+static_assert(offsetof(SharedMemoryLayout, last_response_time) == 88, "SharedMemoryLayout changed");
+static_assert(offsetof(SharedMemoryLayout, client_waiting) == 128, "SharedMemoryLayout changed");
+static_assert(offsetof(SharedMemoryLayout, slots) == 192, "SharedMemoryLayout changed");
+static_assert(sizeof(SharedMemoryLayout) == 192 + RING_SLOT_COUNT * sizeof(RingSlot), "SharedMemoryLayout changed");
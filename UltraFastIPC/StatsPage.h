@@ -0,0 +1,96 @@
+// StatsPage.h - Always-on per-command timing, published in <name>_Stats
+//
+// Only the channel's worker thread writes its page, so every update is a
+// relaxed load and store without locked instructions. The C# client maps the
+// page read-only and takes snapshots while the channel keeps running.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "BinaryProtocol.h"
+#include "SharedMemoryLayout.h"
+
+// 1 = count, total, min, max and a log-bucket histogram per opcode
+// 2 = shadow write counters, per opcode and in total
+// 3 = writes --reduce-batches coalesced
+constexpr uint32_t STATS_LAYOUT_VERSION = 3;
+
+// Log-linear buckets like HDR histograms: 2^STATS_SUB_BUCKET_BITS buckets per power of two.
+// Bucket i < 4 holds exactly i ticks, the last one also takes everything above 2^32 ticks.
+constexpr uint32_t STATS_SUB_BUCKET_BITS = 2;
+constexpr uint32_t STATS_BUCKET_COUNT = 128;
+
+constexpr uint32_t StatsBucket(uint64_t ticks) {
+	constexpr uint64_t subBuckets = 1ull << STATS_SUB_BUCKET_BITS;
+	if (ticks < subBuckets) {
+		return (uint32_t)ticks;
+	}
+	uint32_t msb = 63;
+	while ((ticks >> msb) == 0) {
+		msb--;
+	}
+	uint64_t sub = (ticks >> (msb - STATS_SUB_BUCKET_BITS)) & (subBuckets - 1);
+	uint64_t bucket = (msb - STATS_SUB_BUCKET_BITS + 1) * subBuckets + sub;
+	return bucket < STATS_BUCKET_COUNT ? (uint32_t)bucket : STATS_BUCKET_COUNT - 1;
+}
+static_assert(StatsBucket(3) == 3 && StatsBucket(4) == 4 && StatsBucket(7) == 7 && StatsBucket(8) == 8, "Bucket edges changed");
+
+// Single writer increment, see CommandStats::Record
+inline void StatsIncrement(std::atomic<uint64_t>& counter) {
+	counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// Timing of one opcode, in QueryPerformanceCounter ticks
+struct alignas(CACHE_LINE_SIZE) CommandStats {
+	std::atomic<uint64_t> count{ 0 };
+	std::atomic<uint64_t> total_ticks{ 0 };
+	std::atomic<uint64_t> min_ticks{ UINT64_MAX };    // UINT64_MAX until the first sample
+	std::atomic<uint64_t> max_ticks{ 0 };
+	std::atomic<uint32_t> buckets[STATS_BUCKET_COUNT] = {};
+	std::atomic<uint64_t> skipped{ 0 };             // Writes --shadow-writes or --reduce-batches kept from the DLL, not in count
+
+	// Single writer, so plain stores are enough. A snapshot may catch the
+	// fields one sample apart, but never a torn value.
+	void Record(uint64_t ticks) {
+		StatsIncrement(count);
+		total_ticks.store(total_ticks.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+		if (ticks < min_ticks.load(std::memory_order_relaxed)) {
+			min_ticks.store(ticks, std::memory_order_relaxed);
+		}
+		if (ticks > max_ticks.load(std::memory_order_relaxed)) {
+			max_ticks.store(ticks, std::memory_order_relaxed);
+		}
+		std::atomic<uint32_t>& bucket = buckets[StatsBucket(ticks)];
+		bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+};
+
+struct StatsPage {
+	alignas(CACHE_LINE_SIZE) uint32_t layout_version;   // STATS_LAYOUT_VERSION
+	uint32_t command_count;                     // Entries in commands, Opcode::Count
+	uint32_t command_stats_size;                // sizeof(CommandStats), the stride of commands
+	uint32_t bucket_count;                      // STATS_BUCKET_COUNT
+	uint32_t sub_bucket_bits;                   // STATS_SUB_BUCKET_BITS
+	int64_t ticks_per_second;                   // QueryPerformanceFrequency, read once at startup
+	std::atomic<uint64_t> shadow_issued{ 0 };   // Shadowed writes that reached the DLL
+	std::atomic<uint64_t> shadow_skipped{ 0 };  // Shadowed writes of a value the board already held
+	std::atomic<uint64_t> batch_coalesced{ 0 }; // Shadowed writes a later write in their batch overwrote
+
+	// Pickup to response publish of every request, a batch counts once
+	CommandStats requests;
+
+	// Time spent in the vendor DLL, per opcode, lock waits excluded
+	CommandStats commands[(size_t)Opcode::Count];
+};
+
+// The C# client reads these offsets (PE32Proxy/PE32Stats.cs)
+static_assert(sizeof(CommandStats) == 576, "CommandStats layout changed");
+static_assert(offsetof(CommandStats, buckets) == 32, "CommandStats layout changed");
+static_assert(offsetof(CommandStats, skipped) == 544, "CommandStats layout changed");
+static_assert(offsetof(StatsPage, ticks_per_second) == 24, "StatsPage layout changed");
+static_assert(offsetof(StatsPage, shadow_issued) == 32, "StatsPage layout changed");
+static_assert(offsetof(StatsPage, shadow_skipped) == 40, "StatsPage layout changed");
+static_assert(offsetof(StatsPage, batch_coalesced) == 48, "StatsPage layout changed");
+static_assert(offsetof(StatsPage, requests) == 64, "StatsPage layout changed");
+static_assert(offsetof(StatsPage, commands) == 640, "StatsPage layout changed");
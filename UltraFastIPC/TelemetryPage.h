@@ -0,0 +1,249 @@
+// TelemetryPage.h - Background sampling of telemetry, published in <name>_Telemetry
+//
+// With --telemetry the bridge runs a sampler thread that calls a fixed set of
+// temperature, counter and measurement reads every --telemetry-period and
+// publishes the latest result of each. Every entry is a seqlock: its sequence
+// is odd while the sampler writes it, so monitors map the page read-only and
+// read again when the sequence changed underneath them. Monitors then never
+// send a request, and the channels stay with the test flow.
+#pragma once
+
+#include <windows.h>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BinaryProtocol.h"
+#include "CommandRegistry.h"
+#include "SharedMemoryLayout.h"
+
+constexpr uint32_t TELEMETRY_LAYOUT_VERSION = 1;
+
+// The page is one 4 KB page: a header line and one line per entry
+constexpr uint32_t MAX_TELEMETRY_ENTRIES = 63;
+constexpr uint32_t TELEMETRY_LABEL_SIZE = 32;
+constexpr uint32_t DEFAULT_TELEMETRY_PERIOD_MS = 100;
+
+// Reads without side effects that monitors poll, each must return one int or double
+inline constexpr std::string_view kTelemetryCommands[] = {
+	"pe32_get_temp",
+	"pe32_counter_rd",
+	"pe32_counter_rdfrq",
+	"pe32_vmeas",
+	"pe32_imeas",
+};
+
+constexpr bool TelemetryCommandsFit() {
+	for (const CommandInfo& command : kCommands) {
+		if (ListContains(kTelemetryCommands, std::size(kTelemetryCommands), command.name)
+			&& (command.outCount != 0 || (command.returnType != WireType::Int32 && command.returnType != WireType::UInt32
+				&& command.returnType != WireType::Double))) {
+			return false;
+		}
+	}
+	return true;
+}
+static_assert(TelemetryCommandsFit(), "Telemetry commands must return a single int, uint or double");
+
+// One sampled command. The sampler is the only writer.
+struct alignas(CACHE_LINE_SIZE) TelemetryEntry {
+	std::atomic<uint32_t> sequence{ 0 };        // Odd while the sampler writes the entry
+	std::atomic<int32_t> status{ 0 };           // BinaryStatus of the last sample
+	std::atomic<uint64_t> value{ 0 };           // Bits of the result as a double, ints converted
+	std::atomic<uint64_t> sample_time{ 0 };     // QueryPerformanceCounter ticks of the last sample
+	std::atomic<uint64_t> samples{ 0 };         // 0 until sampling starts
+	char label[TELEMETRY_LABEL_SIZE];           // The command as configured, "pe32_get_temp 1 0"
+};
+
+struct TelemetryPage {
+	alignas(CACHE_LINE_SIZE) uint32_t layout_version;   // TELEMETRY_LAYOUT_VERSION
+	uint32_t entry_count;
+	uint32_t entry_size;                        // sizeof(TelemetryEntry), the stride of entries
+	uint32_t period_us;
+	int64_t ticks_per_second;                   // QueryPerformanceFrequency, read once at startup
+	std::atomic<uint64_t> rounds{ 0 };          // Completed passes over all entries
+
+	TelemetryEntry entries[MAX_TELEMETRY_ENTRIES];
+};
+
+// The C# client reads these offsets (PE32Proxy/PE32Telemetry.cs)
+static_assert(sizeof(TelemetryEntry) == 64, "TelemetryEntry layout changed");
+static_assert(offsetof(TelemetryEntry, value) == 8, "TelemetryEntry layout changed");
+static_assert(offsetof(TelemetryEntry, label) == 32, "TelemetryEntry layout changed");
+static_assert(offsetof(TelemetryPage, ticks_per_second) == 16, "TelemetryPage layout changed");
+static_assert(offsetof(TelemetryPage, rounds) == 24, "TelemetryPage layout changed");
+static_assert(offsetof(TelemetryPage, entries) == 64, "TelemetryPage layout changed");
+static_assert(sizeof(TelemetryPage) == 4096, "TelemetryPage must stay one page");
+
+class TelemetrySampler {
+public:
+	// Runs one complete binary request, see UltraFastIPCServer::DispatchRequest
+	using Dispatch = BinaryStatus (*)(const char* request, uint32_t size, BinaryWriter& out);
+
+	// Nothing is sampled before pe32_init found boards, a standby bridge stays off them
+	static inline std::atomic<bool> boardsReady{ false };
+
+	// Called after pe32_init returned, with the number of boards it reports
+	static void Initialized(int boards) {
+		if (boards > 0 && !boardsReady.load(std::memory_order_relaxed)) {
+			boardsReady.store(true, std::memory_order_release);
+		}
+	}
+
+	// Parses --telemetry, text protocol commands separated by ';' such as
+	// "pe32_get_temp 1 0;pe32_counter_rdfrq 1". False with the reason in error.
+	bool Configure(const std::string& spec, std::string& error) {
+		std::stringstream entries(spec);
+		std::string entry;
+		while (std::getline(entries, entry, ';')) {
+			std::vector<std::string> tokens;
+			std::stringstream words(entry);
+			for (std::string word; words >> word;) {
+				tokens.push_back(word);
+			}
+			if (tokens.empty()) {
+				continue;
+			}
+
+			const CommandInfo* command = FindCommand(tokens[0]);
+			if (command == nullptr || !ListContains(kTelemetryCommands, std::size(kTelemetryCommands), command->name)) {
+				error = "not a telemetry command: " + tokens[0];
+				return false;
+			}
+			if (requests.size() == MAX_TELEMETRY_ENTRIES) {
+				error = "more than " + std::to_string(MAX_TELEMETRY_ENTRIES) + " commands";
+				return false;
+			}
+			Request request{};
+			BinaryWriter out(request.data, sizeof(request.data));
+			bool encoded = false;
+			try {
+				encoded = EncodeTextRequest(*command, tokens, out);
+			}
+			catch (...) {
+			}
+			if (!encoded) {
+				error = "bad arguments: " + entry;
+				return false;
+			}
+			request.size = out.Size();
+			request.returnType = command->returnType;
+			request.label = entry.substr(entry.find_first_not_of(' '), TELEMETRY_LABEL_SIZE - 1);
+			requests.push_back(request);
+		}
+		return true;
+	}
+
+	bool Empty() const { return requests.empty(); }
+
+	// Creates <name>_Telemetry and starts sampling every periodMs once the boards are ready
+	bool Start(const std::string& name, uint32_t periodMs, Dispatch dispatch) {
+		hMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, sizeof(TelemetryPage),
+			(name + "_Telemetry").c_str());
+		page = hMapping != NULL ? (TelemetryPage*)MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(TelemetryPage)) : nullptr;
+		if (page == nullptr) {
+			return false;
+		}
+
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		new (page) TelemetryPage();
+		page->layout_version = TELEMETRY_LAYOUT_VERSION;
+		page->entry_count = (uint32_t)requests.size();
+		page->entry_size = sizeof(TelemetryEntry);
+		page->period_us = periodMs * 1000;
+		page->ticks_per_second = frequency.QuadPart;
+		for (size_t i = 0; i < requests.size(); i++) {
+			memcpy(page->entries[i].label, requests[i].label.c_str(), requests[i].label.size() + 1);
+		}
+
+		running = true;
+		sampler = std::thread([this, periodMs, dispatch, frequency] {
+			uint64_t period = (uint64_t)periodMs * frequency.QuadPart / 1000;
+			uint64_t next = Now();
+			while (running.load(std::memory_order_relaxed)) {
+				if (boardsReady.load(std::memory_order_acquire)) {
+					SampleAll(dispatch);
+				}
+				// Skips the rounds a slow vendor call overran instead of catching up
+				next += period;
+				uint64_t now = Now();
+				if (next < now) {
+					next = now;
+				}
+				Sleep((DWORD)((next - now) * 1000 / frequency.QuadPart));
+			}
+		});
+		return true;
+	}
+
+	~TelemetrySampler() {
+		if (sampler.joinable()) {
+			running = false;
+			sampler.join();
+		}
+		if (page != nullptr) {
+			UnmapViewOfFile(page);
+		}
+		if (hMapping != nullptr) {
+			CloseHandle(hMapping);
+		}
+	}
+
+private:
+	struct Request {
+		char data[64];
+		uint32_t size;
+		WireType returnType;
+		std::string label;
+	};
+
+	static uint64_t Now() {
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		return (uint64_t)now.QuadPart;
+	}
+
+	void SampleAll(Dispatch dispatch) {
+		for (size_t i = 0; i < requests.size(); i++) {
+			const Request& request = requests[i];
+			char result[64];
+			BinaryWriter out(result, sizeof(result));
+			BinaryStatus status = dispatch(request.data, request.size, out);
+
+			double value = 0;
+			if (status == BinaryStatus::Ok) {
+				BinaryReader in(result, out.Size());
+				value = request.returnType == WireType::Double ? in.Read<double>()
+					: request.returnType == WireType::UInt32 ? (double)in.Read<uint32_t>()
+					: (double)in.Read<int32_t>();
+			}
+			Publish(page->entries[i], status, value);
+		}
+		page->rounds.store(page->rounds.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	// Seqlock write: odd sequence, fields, even sequence
+	static void Publish(TelemetryEntry& entry, BinaryStatus status, double value) {
+		uint32_t sequence = entry.sequence.load(std::memory_order_relaxed);
+		entry.sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		entry.status.store((int32_t)status, std::memory_order_relaxed);
+		entry.value.store(std::bit_cast<uint64_t>(value), std::memory_order_relaxed);
+		entry.sample_time.store(Now(), std::memory_order_relaxed);
+		entry.samples.store(entry.samples.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		entry.sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	std::vector<Request> requests;
+	HANDLE hMapping = nullptr;
+	TelemetryPage* page = nullptr;
+	std::atomic<bool> running{ false };
+	std::thread sampler;
+};
@@ -0,0 +1,157 @@
+// ThreadPlacement.h - Core pinning, priorities and MMCSS for the channel threads
+//
+// The handshake cost depends on where the two spinning threads run: on cores
+// sharing a cache a ring write is seen within tens of nanoseconds, across
+// sockets it takes far longer and migrations add outliers to p99.
+#pragma once
+
+#include <windows.h>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// SetThreadAffinityMask addresses one processor group, and only group 0 is used.
+// Machines with more than 64 logical processors (32 for this 32-bit bridge)
+// would need SetThreadGroupAffinity, which is out of scope.
+constexpr int MAX_AFFINITY_CPUS = (int)(sizeof(DWORD_PTR) * 8);
+
+struct PlacementOptions {
+	std::vector<int> cpus;              // --cpu=2,4: channel k runs on cpus[k % size]
+	bool autoCpu = false;               // --cpu=auto: channel k and its client share a cache, see CacheSharingPairs()
+	DWORD priorityClass = 0;            // --priority=<class>, 0 keeps the class the bridge was started with
+	bool highThreadPriority = false;    // --thread-priority=high
+	std::string mmcssTask;              // --mmcss=<task>, e.g. "Pro Audio"
+};
+
+// What a channel thread applies to itself before it starts serving
+struct ChannelPlacement {
+	int serverCpu = -1;                 // -1 leaves the thread to the scheduler
+	int clientCpu = -1;                 // Published in the layout as the suggested core of the client thread
+	int threadPriority = THREAD_PRIORITY_NORMAL;
+	std::string mmcssTask;
+};
+
+// Pairs of logical processors sharing an L2 cache, or an L3 cache if no L2 is
+// shared. Caches that contain CPU 0, which takes most interrupts, come last.
+// Only processor group 0 is considered.
+inline std::vector<std::pair<int, int>> CacheSharingPairs() {
+	DWORD length = 0;
+	GetLogicalProcessorInformationEx(RelationCache, nullptr, &length);
+	std::vector<char> buffer(length);
+	if (length == 0 || !GetLogicalProcessorInformationEx(RelationCache,
+		(PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer.data(), &length)) {
+		return {};
+	}
+
+	for (BYTE level : { (BYTE)2, (BYTE)3 }) {
+		std::vector<std::pair<int, int>> pairs;
+		std::vector<std::pair<int, int>> interruptPairs;
+		for (DWORD offset = 0; offset < length;) {
+			auto* info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer.data() + offset);
+			offset += info->Size;
+			const CACHE_RELATIONSHIP& cache = info->Cache;
+			if (cache.Level != level || cache.Type == CacheInstruction || cache.GroupMask.Group != 0) {
+				continue;
+			}
+
+			std::vector<int> cpus;
+			for (int cpu = 0; cpu < (int)(sizeof(KAFFINITY) * 8); cpu++) {
+				if (cache.GroupMask.Mask & ((KAFFINITY)1 << cpu)) {
+					cpus.push_back(cpu);
+				}
+			}
+			auto& target = (cache.GroupMask.Mask & 1) ? interruptPairs : pairs;
+			for (size_t i = 0; i + 1 < cpus.size(); i += 2) {
+				target.push_back({ cpus[i], cpus[i + 1] });
+			}
+		}
+		pairs.insert(pairs.end(), interruptPairs.begin(), interruptPairs.end());
+		if (!pairs.empty()) {
+			return pairs;
+		}
+	}
+	return {};
+}
+
+inline ChannelPlacement PlaceChannel(const PlacementOptions& options, uint32_t channel,
+	const std::vector<std::pair<int, int>>& pairs) {
+	ChannelPlacement placement;
+	if (!options.cpus.empty()) {
+		placement.serverCpu = options.cpus[channel % options.cpus.size()];
+	}
+	else if (options.autoCpu && !pairs.empty()) {
+		placement.serverCpu = pairs[channel % pairs.size()].first;
+		placement.clientCpu = pairs[channel % pairs.size()].second;
+	}
+	if (options.highThreadPriority) {
+		placement.threadPriority = options.priorityClass == REALTIME_PRIORITY_CLASS ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_HIGHEST;
+	}
+	placement.mmcssTask = options.mmcssTask;
+	return placement;
+}
+
+// Runs on the channel thread. Failures are reported and the thread keeps serving unpinned.
+inline void ApplyThreadPlacement(const ChannelPlacement& placement) {
+	HANDLE thread = GetCurrentThread();
+	if (placement.serverCpu >= 0 && SetThreadAffinityMask(thread, (DWORD_PTR)1 << placement.serverCpu) == 0) {
+		std::cerr << "Pinning to CPU " << placement.serverCpu << " failed: " << GetLastError() << std::endl;
+	}
+	if (placement.threadPriority != THREAD_PRIORITY_NORMAL && !SetThreadPriority(thread, placement.threadPriority)) {
+		std::cerr << "Raising the thread priority failed: " << GetLastError() << std::endl;
+	}
+
+	// avrt.dll is loaded on demand, so the bridge still starts where MMCSS is unavailable
+	if (!placement.mmcssTask.empty()) {
+		using AvSetMmThreadCharacteristicsFn = HANDLE(WINAPI*)(LPCSTR, LPDWORD);
+		HMODULE avrt = LoadLibraryA("avrt.dll");
+		auto avSetMmThreadCharacteristics = avrt != nullptr
+			? (AvSetMmThreadCharacteristicsFn)GetProcAddress(avrt, "AvSetMmThreadCharacteristicsA") : nullptr;
+		DWORD taskIndex = 0;
+		if (avSetMmThreadCharacteristics == nullptr || avSetMmThreadCharacteristics(placement.mmcssTask.c_str(), &taskIndex) == nullptr) {
+			std::cerr << "MMCSS registration as \"" << placement.mmcssTask << "\" failed: " << GetLastError() << std::endl;
+		}
+	}
+}
+
+// Consumes the placement flags of the bridge command line, false for anything else.
+// Throws for CPU numbers an affinity mask cannot hold.
+inline bool ParsePlacementOption(const std::string& arg, PlacementOptions& options) {
+	if (arg == "--cpu=auto") {
+		options.autoCpu = true;
+	}
+	else if (arg.rfind("--cpu=", 0) == 0) {
+		size_t start = 6;
+		while (start < arg.size()) {
+			size_t comma = arg.find(',', start);
+			int cpu = std::stoi(arg.substr(start, comma - start));
+			if (cpu < 0 || cpu >= MAX_AFFINITY_CPUS) {
+				throw std::out_of_range(arg + ": CPUs must be 0 to " + std::to_string(MAX_AFFINITY_CPUS - 1)
+					+ " of processor group 0");
+			}
+			options.cpus.push_back(cpu);
+			start = comma == std::string::npos ? arg.size() : comma + 1;
+		}
+	}
+	else if (arg.rfind("--priority=", 0) == 0) {
+		std::string value = arg.substr(11);
+		options.priorityClass = value == "idle" ? IDLE_PRIORITY_CLASS
+			: value == "below_normal" ? BELOW_NORMAL_PRIORITY_CLASS
+			: value == "above_normal" ? ABOVE_NORMAL_PRIORITY_CLASS
+			: value == "high" ? HIGH_PRIORITY_CLASS
+			: value == "realtime" ? REALTIME_PRIORITY_CLASS
+			: NORMAL_PRIORITY_CLASS;
+	}
+	else if (arg == "--thread-priority=high") {
+		options.highThreadPriority = true;
+	}
+	else if (arg.rfind("--mmcss=", 0) == 0) {
+		options.mmcssTask = arg.substr(8);
+	}
+	else {
+		return false;
+	}
+	return true;
+}
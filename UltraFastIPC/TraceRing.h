@@ -0,0 +1,415 @@
+// TraceRing.h - Binary trace of the requests a bridge serves, see --trace
+//
+// Each channel thread appends one record per request to a ring in process
+// memory, without locks, system calls or formatting. A flusher thread copies
+// whole records from the rings into a memory-mapped trace file. --dump-trace
+// decodes a file offline, and TraceReplay sends its requests through another
+// bridge, usually one built with the mock backend.
+#pragma once
+
+#include <windows.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BinaryProtocol.h"
+#include "CommandRegistry.h"
+#include "SharedMemoryLayout.h"
+#include "StatsPage.h"
+
+constexpr uint32_t TRACE_MAGIC = 0x52544655;                // "UFTR"
+constexpr uint32_t TRACE_LAYOUT_VERSION = 1;
+constexpr uint32_t TRACE_RING_SIZE = 4u << 20;              // Per channel, a power of two
+constexpr uint64_t DEFAULT_TRACE_FILE_SIZE = 64ull << 20;   // The view has to fit the 32-bit bridge
+constexpr uint32_t TRACE_MAX_RESPONSE = 256;                // Response bytes kept per record
+
+// TraceRecord flags
+constexpr uint8_t TRACE_BULK_INPUT = 0x01;  // The request read a bulk input, which is not recorded
+
+// Start of every trace file, the records follow at header_size
+struct TraceFileHeader {
+	uint32_t magic;             // TRACE_MAGIC
+	uint32_t layout_version;    // TRACE_LAYOUT_VERSION
+	uint32_t header_size;       // sizeof(TraceFileHeader)
+	uint32_t channel_count;
+	int64_t ticks_per_second;   // QueryPerformanceFrequency of the bridge
+	uint32_t command_hash;      // TraceCommandHash() of the bridge, opcodes are only valid with the same one
+	uint32_t max_response;      // TRACE_MAX_RESPONSE
+	uint64_t used;              // Bytes of whole records, stored after the records themselves
+	uint64_t dropped;           // Records lost to a full ring or a full file
+	uint64_t start_time;        // QueryPerformanceCounter when the trace was opened
+};
+
+// One request, followed by request_size request bytes, then the first
+// min(response_size, max_response) response bytes, padded to 8 bytes
+struct TraceRecord {
+	uint32_t size;              // Whole record
+	uint32_t sequence;
+	uint16_t channel;
+	uint8_t protocol;           // ProtocolVersion
+	uint8_t flags;              // TRACE_BULK_INPUT
+	int32_t status;             // BinaryStatus of a binary request, 0 for text
+	uint64_t pickup_time;       // QueryPerformanceCounter ticks, as in the ring slot
+	uint64_t dll_enter_time;    // 0 if no command reached the DLL
+	uint64_t dll_exit_time;
+	uint64_t publish_time;
+	uint32_t request_size;
+	uint32_t response_size;     // 0 for a fire-and-forget request, which has no response
+};
+
+// TraceReplay reads these offsets (TraceReplay/TraceFile.cs)
+static_assert(sizeof(TraceFileHeader) == 56, "TraceFileHeader layout changed");
+static_assert(offsetof(TraceFileHeader, used) == 32, "TraceFileHeader layout changed");
+static_assert(sizeof(TraceRecord) == 56, "TraceRecord layout changed");
+static_assert(offsetof(TraceRecord, pickup_time) == 16, "TraceRecord layout changed");
+static_assert(offsetof(TraceRecord, request_size) == 48, "TraceRecord layout changed");
+
+// FNV-1a over the command names in opcode order, PE32Proxy.CommandHash computes the same
+constexpr uint32_t TraceCommandHash() {
+	uint32_t hash = 2166136261u;
+	for (const CommandInfo& command : kCommands) {
+		for (char c : command.name) {
+			hash ^= (uint8_t)c;
+			hash *= 16777619u;
+		}
+		hash ^= (uint8_t)'\n';
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+constexpr bool TakesBulkInput(const CommandInfo& command) {
+	for (size_t i = 0; i < command.argCount; i++) {
+		if (command.argTypes[i] == WireType::Bulk) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Single producer, single consumer ring of records. The channel thread appends at head,
+// the flusher takes whole records at tail. Neither side ever waits for the other.
+class TraceRing {
+public:
+	explicit TraceRing(uint16_t channel) : data(new char[TRACE_RING_SIZE]), channel(channel) {
+	}
+
+	// Called before the response is published, the slot belongs to the client after that.
+	// A full ring drops the record and counts it.
+	void Append(const RingSlot& slot, uint32_t sequence, BinaryStatus status) {
+		TraceRecord record{};
+		record.sequence = sequence;
+		record.channel = channel;
+		record.protocol = (uint8_t)slot.protocol_version;
+		record.status = (int32_t)status;
+		record.pickup_time = slot.pickup_time;
+		record.dll_enter_time = slot.dll_enter_time;
+		record.dll_exit_time = slot.dll_exit_time;
+		record.publish_time = slot.publish_time;
+		record.request_size = std::min<uint32_t>(slot.request_size, sizeof(slot.request_data));
+		record.response_size = std::min<uint32_t>(slot.response_size, sizeof(slot.response_data));
+
+		if (slot.protocol_version == PROTOCOL_BINARY && record.request_size >= sizeof(BinaryRequestHeader)) {
+			BinaryRequestHeader header;
+			memcpy(&header, slot.request_data, sizeof(header));
+			if (header.flags & BINARY_FLAG_NO_REPLY) {
+				record.response_size = 0;
+			}
+			if (header.opcode < (uint16_t)Opcode::Count && TakesBulkInput(kCommands[header.opcode])) {
+				record.flags |= TRACE_BULK_INPUT;
+			}
+		}
+
+		uint32_t responseBytes = std::min(record.response_size, TRACE_MAX_RESPONSE);
+		record.size = (sizeof(TraceRecord) + record.request_size + responseBytes + 7) & ~7u;
+		uint64_t position = head.load(std::memory_order_relaxed);
+		if (position + record.size - tail.load(std::memory_order_acquire) > TRACE_RING_SIZE) {
+			StatsIncrement(dropped);
+			return;
+		}
+		CopyIn(position, &record, sizeof(record));
+		CopyIn(position + sizeof(record), slot.request_data, record.request_size);
+		CopyIn(position + sizeof(record) + record.request_size, slot.response_data, responseBytes);
+		head.store(position + record.size, std::memory_order_release);
+	}
+
+	// Flusher side: hands each whole record appended so far to write, which copies it out
+	// or drops it. Returns the number of records the ring itself has dropped.
+	template <typename Write>
+	uint64_t Drain(Write write) {
+		uint64_t position = tail.load(std::memory_order_relaxed);
+		uint64_t end = head.load(std::memory_order_acquire);
+		while (position < end) {
+			uint32_t size;
+			CopyOut(position, &size, sizeof(size));
+			write(*this, position, size);
+			position += size;
+		}
+		tail.store(position, std::memory_order_release);
+		return dropped.load(std::memory_order_relaxed);
+	}
+
+	// Records are 8 byte aligned, so only their payload can wrap around the end
+	void CopyOut(uint64_t position, void* destination, uint32_t size) const {
+		uint32_t offset = (uint32_t)(position & (TRACE_RING_SIZE - 1));
+		uint32_t first = std::min(size, TRACE_RING_SIZE - offset);
+		memcpy(destination, data.get() + offset, first);
+		memcpy((char*)destination + first, data.get(), size - first);
+	}
+
+private:
+	void CopyIn(uint64_t position, const void* source, uint32_t size) {
+		uint32_t offset = (uint32_t)(position & (TRACE_RING_SIZE - 1));
+		uint32_t first = std::min(size, TRACE_RING_SIZE - offset);
+		memcpy(data.get() + offset, source, first);
+		memcpy(data.get(), (const char*)source + first, size - first);
+	}
+
+	std::unique_ptr<char[]> data;
+	uint16_t channel;
+	alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head{ 0 };      // Written by the channel thread
+	std::atomic<uint64_t> dropped{ 0 };
+	alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail{ 0 };      // Written by the flusher
+};
+
+// The trace file of a bridge and the thread that fills it from the channel rings
+class TraceFile {
+public:
+	// Creates path with room for size bytes, the file is cut to what was used when the bridge stops
+	bool Open(const std::string& path, uint64_t size, uint32_t channelCount) {
+		capacity = std::max<uint64_t>(size, sizeof(TraceFileHeader)) - sizeof(TraceFileHeader);
+		hFile = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS,
+			FILE_ATTRIBUTE_NORMAL, NULL);
+		if (hFile == INVALID_HANDLE_VALUE) {
+			hFile = nullptr;
+			return false;
+		}
+		uint64_t mapped = sizeof(TraceFileHeader) + capacity;
+		hMapping = CreateFileMappingA(hFile, NULL, PAGE_READWRITE, (DWORD)(mapped >> 32), (DWORD)mapped, NULL);
+		header = hMapping != NULL ? (TraceFileHeader*)MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)mapped) : nullptr;
+		if (header == nullptr) {
+			return false;
+		}
+
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		header->magic = TRACE_MAGIC;
+		header->layout_version = TRACE_LAYOUT_VERSION;
+		header->header_size = sizeof(TraceFileHeader);
+		header->channel_count = channelCount;
+		header->ticks_per_second = frequency.QuadPart;
+		header->command_hash = TraceCommandHash();
+		header->max_response = TRACE_MAX_RESPONSE;
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		header->start_time = (uint64_t)now.QuadPart;
+
+		for (uint32_t k = 0; k < channelCount; k++) {
+			rings.push_back(std::make_unique<TraceRing>((uint16_t)k));
+		}
+		running = true;
+		flusher = std::thread([this] {
+			// Sleep(1) rounds up to the timer period, a ring holds far more than that at full rate
+			while (running.load(std::memory_order_relaxed)) {
+				Flush();
+				Sleep(1);
+			}
+		});
+		return true;
+	}
+
+	TraceRing* Ring(uint32_t channel) {
+		return channel < rings.size() ? rings[channel].get() : nullptr;
+	}
+
+	~TraceFile() {
+		if (flusher.joinable()) {
+			running = false;
+			flusher.join();
+			Flush();
+		}
+		if (header != nullptr) {
+			uint64_t used = sizeof(TraceFileHeader) + header->used;
+			FlushViewOfFile(header, 0);
+			UnmapViewOfFile(header);
+
+			LARGE_INTEGER end;
+			end.QuadPart = (LONGLONG)used;
+			if (hMapping != nullptr) {
+				CloseHandle(hMapping);
+				hMapping = nullptr;
+			}
+			SetFilePointerEx(hFile, end, NULL, FILE_BEGIN);
+			SetEndOfFile(hFile);
+		}
+		if (hMapping != nullptr) {
+			CloseHandle(hMapping);
+		}
+		if (hFile != nullptr) {
+			CloseHandle(hFile);
+		}
+	}
+
+private:
+	// Only the flusher thread, and the destructor after it, write the file
+	void Flush() {
+		char* records = (char*)header + sizeof(TraceFileHeader);
+		uint64_t used = header->used;
+		uint64_t ringDropped = 0;
+		for (auto& ring : rings) {
+			ringDropped += ring->Drain([&](const TraceRing& from, uint64_t position, uint32_t size) {
+				if (used + size > capacity) {
+					fileDropped++;
+					return;
+				}
+				from.CopyOut(position, records + used, size);
+				used += size;
+			});
+		}
+
+		// A reader of the live file sees used only after the records it covers
+		std::atomic_ref<uint64_t>(header->dropped).store(fileDropped + ringDropped, std::memory_order_relaxed);
+		std::atomic_ref<uint64_t>(header->used).store(used, std::memory_order_release);
+	}
+
+	HANDLE hFile = nullptr;
+	HANDLE hMapping = nullptr;
+	TraceFileHeader* header = nullptr;
+	uint64_t capacity = 0;
+	uint64_t fileDropped = 0;
+	std::vector<std::unique_ptr<TraceRing>> rings;
+	std::atomic<bool> running{ false };
+	std::thread flusher;
+};
+
+inline const char* BinaryStatusName(int32_t status) {
+	switch ((BinaryStatus)status) {
+	case BinaryStatus::Ok: return "Ok";
+	case BinaryStatus::UnknownOpcode: return "UnknownOpcode";
+	case BinaryStatus::BadArguments: return "BadArguments";
+	case BinaryStatus::Exception: return "Exception";
+	case BinaryStatus::ResponseTooLarge: return "ResponseTooLarge";
+	case BinaryStatus::Timeout: return "Timeout";
+	case BinaryStatus::NotRun: return "NotRun";
+	default: return "Unknown";
+	}
+}
+
+// name(arg, ...) of a binary request, batches and polls with their sub-requests
+inline std::string FormatTraceRequest(const char* data, uint32_t size) {
+	BinaryReader in(data, size);
+	auto header = in.Read<BinaryRequestHeader>();
+	if (!in.Ok()) {
+		return "?";
+	}
+
+	if (header.opcode == BATCH_OPCODE) {
+		uint16_t count = in.Read<uint16_t>();
+		std::string text = "batch{";
+		for (uint16_t i = 0; i < count && in.Ok(); i++) {
+			uint16_t subSize = in.Read<uint16_t>();
+			const char* sub = in.ReadBytes(subSize);
+			text += (i == 0 ? "" : ", ") + (sub != nullptr ? FormatTraceRequest(sub, subSize) : std::string("?"));
+		}
+		return text + "}";
+	}
+	if (header.opcode == POLL_OPCODE) {
+		auto condition = in.Read<BinaryPollCondition>();
+		uint32_t polledSize = in.Remaining();
+		const char* polled = in.ReadBytes(polledSize);
+		if (polled == nullptr) {
+			return "poll(?)";
+		}
+		return FormatTraceRequest(polled, polledSize) + (condition.compare == POLL_EQUAL ? ".Until(" : ".UntilNot(")
+			+ std::to_string(condition.value) + ", mask " + std::to_string(condition.mask) + ", "
+			+ std::to_string(condition.timeout_us) + " us)";
+	}
+	if (header.opcode >= (uint16_t)Opcode::Count) {
+		return "opcode_" + std::to_string(header.opcode) + "(?)";
+	}
+
+	const CommandInfo& command = kCommands[header.opcode];
+	std::string text = std::string(command.name) + "(";
+	for (size_t i = 0; i < command.argCount; i++) {
+		text += i == 0 ? "" : ", ";
+		switch (command.argTypes[i]) {
+		case WireType::String: {
+			const char* value = in.ReadString();
+			text += value != nullptr ? "\"" + std::string(value) + "\"" : std::string("?");
+			break;
+		}
+		case WireType::Bulk:
+			in.Read<uint32_t>();
+			text += "<" + std::to_string(in.Read<uint32_t>()) + " bulk bytes>";
+			break;
+		default:
+			text += FormatTextValue(command.argTypes[i], in);
+			break;
+		}
+	}
+	return text + (in.Ok() ? ")" : ", ?)");
+}
+
+// One line per record: channel, sequence, start since the trace was opened, DLL and total
+// time in microseconds, status, request and result. The records of each channel are in
+// sequence order, those of different channels only roughly in time order.
+// Returns false if in is not a trace file.
+inline bool DumpTrace(std::istream& in, std::ostream& out) {
+	TraceFileHeader header{};
+	in.read((char*)&header, sizeof(header));
+	if (!in || header.magic != TRACE_MAGIC || header.layout_version != TRACE_LAYOUT_VERSION) {
+		return false;
+	}
+	bool sameCommands = header.command_hash == TraceCommandHash();
+	out << "# " << header.channel_count << " channels, " << header.used << " bytes of records, "
+		<< header.dropped << " dropped" << (sameCommands ? "" : ", written by a bridge with other commands") << "\n";
+	out << "channel sequence start_us dll_us total_us status request result\n";
+	in.seekg(header.header_size);
+
+	double usPerTick = 1e6 / (double)header.ticks_per_second;
+	std::vector<char> payload;
+	for (uint64_t position = 0; position + sizeof(TraceRecord) <= header.used;) {
+		TraceRecord record;
+		in.read((char*)&record, sizeof(record));
+		if (!in || record.size < sizeof(record) || position + record.size > header.used) {
+			break;
+		}
+		payload.resize(record.size - sizeof(record));
+		in.read(payload.data(), payload.size());
+		position += record.size;
+
+		const char* request = payload.data();
+		const char* response = request + record.request_size;
+		uint32_t responseBytes = std::min(record.response_size, header.max_response);
+		double dll = record.dll_enter_time != 0 ? (record.dll_exit_time - record.dll_enter_time) * usPerTick : 0.0;
+		char times[96];
+		snprintf(times, sizeof(times), "%.3f %.3f %.3f", ((int64_t)record.pickup_time - (int64_t)header.start_time) * usPerTick,
+			dll, (record.publish_time - record.pickup_time) * usPerTick);
+		out << record.channel << " " << record.sequence << " " << times << " ";
+
+		if (record.protocol != PROTOCOL_BINARY) {
+			out << "Ok \"" << std::string(request, record.request_size) << "\" \""
+				<< std::string(response, responseBytes) << "\"\n";
+			continue;
+		}
+
+		out << BinaryStatusName(record.status) << " "
+			<< (sameCommands ? FormatTraceRequest(request, record.request_size) : std::string("?"));
+		BinaryRequestHeader requestHeader{};
+		memcpy(&requestHeader, request, std::min<uint32_t>(record.request_size, sizeof(requestHeader)));
+		if (sameCommands && record.status == 0 && record.response_size > sizeof(int32_t)
+			&& record.response_size <= header.max_response && requestHeader.opcode < (uint16_t)Opcode::Count) {
+			BinaryReader result(response + sizeof(int32_t), responseBytes - sizeof(int32_t));
+			out << " " << FormatTextResult(kCommands[requestHeader.opcode], result);
+		}
+		out << "\n";
+	}
+	return true;
+}
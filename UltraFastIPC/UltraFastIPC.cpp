@@ -3,54 +3,152 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 #include <windows.h>
+#include <intrin.h>
 #include <iostream>
 #include <atomic>
 #include <memory>
 #include <chrono>
+#ifdef PE32_MOCK
+#include "MockPE32.h"
+#else
 #include <PE32.h>
+#endif
 #include <string>
 #include <vector>
 #include <sstream> 
+#include <stdexcept>
+#include "BinaryProtocol.h"
+#include "SharedMemoryLayout.h"
+#include "CommandRegistry.h"
+#include "CSharpGenerator.h"
+#include "DispatchPolicy.h"
+#include "StatsPage.h"
+#include "ShadowRegisters.h"
+#include "BatchReducer.h"
+#include "PatternCache.h"
+#include "ThreadPlacement.h"
+#include "TraceRing.h"
+#include "TelemetryPage.h"
+#include <fstream>
+#include <thread>
 using namespace std;
 
-// Shared memory layout - This is the "common language" between two processes
-struct SharedMemoryLayout {
-	// Control flags - Use atomic operations to ensure thread safety
-	std::atomic<uint32_t> request_flag{ 0 };      // 0=no request, 1=new request, 2=processing
-	std::atomic<uint32_t> response_flag{ 0 };     // 0=no response, 1=new response
-	std::atomic<uint32_t> sequence_id{ 0 };       // Sequence number, to prevent duplicate processing
-
-	// Data area - Pre-allocated to avoid dynamic memory allocation
-	uint32_t request_size;                      // Length of request data
-	uint32_t response_size;                     // Length of response data
-	char request_data[4096];                    // Request data buffer
-	char response_data[4096];                   // Response data buffer
-
-	// Performance statistics - For monitoring and optimization
-	uint64_t last_request_time;                // Time of last request (microseconds)
-	uint64_t last_response_time;               // Time of last response (microseconds)
+// How the server waits when the ring is empty, the client has the same choice
+enum WaitMode : uint32_t {
+	WAIT_BUSY_SPIN = 0,     // Sleep(0) loop, lowest latency but burns a core while idle
+	WAIT_HYBRID = 1,        // Spin with _mm_pause for spinCount rounds, then block on the request event
+};
+
+constexpr uint32_t DEFAULT_SPIN_COUNT = 20000;
+
+// Command line options of the bridge
+struct ServerOptions {
+	bool debugMode = false;
+	WaitMode waitMode = WAIT_HYBRID;
+	uint32_t spinCount = DEFAULT_SPIN_COUNT;
+	uint32_t bulkSize = DEFAULT_BULK_SIZE;      // Size of the <name>_Bulk mapping, 0 disables bulk commands
+	std::string name = "UltraFastIPC_SharedMem"; // Channel k maps <name>_<k>, unique per client instance
+	uint32_t channelCount = 1;                  // Independent channels, one mapping and worker thread each
+	PlacementOptions placement;                 // --cpu, --priority, --thread-priority and --mmcss
+	std::string tracePath;                      // --trace=<file|dir>, a directory gets <name>.trace
+	uint64_t traceSize = DEFAULT_TRACE_FILE_SIZE;
+	std::string telemetry;                      // --telemetry=<command args;...>, sampled in <name>_Telemetry
+	uint32_t telemetryPeriodMs = DEFAULT_TELEMETRY_PERIOD_MS;
 };
 
 class UltraFastIPCServer {
 private:
 	HANDLE hMapFile;
+	HANDLE hRequestEvent;
+	HANDLE hResponseEvent;
+	HANDLE hParent;
+	HANDLE hParentWait;
 	SharedMemoryLayout* pSharedMemory;
-	bool isRunning;
+	HANDLE hStatsFile;
+	StatsPage* pStats;
+	HANDLE hBulkFile;
+	char* pBulk;
+	uint32_t bulkSize;
+	uint32_t bulkSlotSize;
+
+	// Cleared by the parent watch, the request loop only reads it
+	std::atomic<bool> isRunning;
+	std::atomic<bool> parentExited;
 	int parentPid;
 	std::string sharedMemoryName;
-	bool debugMode;
+	WaitMode waitMode;
+	uint32_t spinCount;
+	ChannelPlacement placement;
+	TraceRing* trace;                           // nullptr unless --trace is set
+
+	// Stats page of the channel running on this thread, and the slot it is serving
+	static inline thread_local StatsPage* threadStats = nullptr;
+	static inline thread_local RingSlot* threadSlot = nullptr;
 
-	// High precision timer - Microsecond-level precision measurement
-	uint64_t GetMicroseconds() {
-		LARGE_INTEGER frequency, counter;
-		QueryPerformanceFrequency(&frequency);
+	// QueryPerformanceCounter ticks, the one clock behind every time the bridge publishes
+	static uint64_t Ticks() {
+		LARGE_INTEGER counter;
 		QueryPerformanceCounter(&counter);
-		return (counter.QuadPart * 1000000LL) / frequency.QuadPart;
+		return (uint64_t)counter.QuadPart;
+	}
+
+	// Fixed at boot, so it is read once rather than on every poll
+	static uint64_t TicksPerSecond() {
+		static const uint64_t frequency = [] {
+			LARGE_INTEGER value;
+			QueryPerformanceFrequency(&value);
+			return (uint64_t)value.QuadPart;
+		}();
+		return frequency;
+	}
+
+	// Records the DLL time of one command, also when it throws. The slot keeps
+	// the enter time of its first command and the exit time of its last one.
+	class CommandTimer {
+	public:
+		explicit CommandTimer(Opcode opcode) : opcode(opcode), start(Ticks()) {
+			if (threadSlot != nullptr && threadSlot->dll_enter_time == 0) {
+				threadSlot->dll_enter_time = start;
+			}
+		}
+
+		~CommandTimer() {
+			uint64_t end = Ticks();
+			if (threadSlot != nullptr) {
+				threadSlot->dll_exit_time = end;
+			}
+			if (threadStats != nullptr) {
+				threadStats->commands[(size_t)opcode].Record(end - start);
+			}
+		}
+
+	private:
+		Opcode opcode;
+		uint64_t start;
+	};
+
+	// False when --shadow-writes finds the value already on the board, counted in the stats page
+	template <typename... A>
+	static bool IssueWrite(Opcode opcode, A... args) {
+		ShadowOutcome outcome = ShadowRegisters::Check(opcode, args...);
+		PatternCache::Observe(opcode, args...);
+		if (threadStats != nullptr && outcome == ShadowOutcome::Issued) {
+			StatsIncrement(threadStats->shadow_issued);
+		}
+		else if (threadStats != nullptr && outcome == ShadowOutcome::Skipped) {
+			StatsIncrement(threadStats->shadow_skipped);
+			StatsIncrement(threadStats->commands[(size_t)opcode].skipped);
+		}
+		return outcome != ShadowOutcome::Skipped;
 	}
 
 public:
-	UltraFastIPCServer(const std::string& name,int id,bool debugMode)
-		: sharedMemoryName(name), parentPid(id), isRunning(false), debugMode(false),hMapFile(nullptr), pSharedMemory(nullptr) {
+	UltraFastIPCServer(const std::string& name, int id, const ServerOptions& options, const ChannelPlacement& placement,
+		TraceRing* trace)
+		: sharedMemoryName(name), parentPid(id), isRunning(false), parentExited(false),
+		  waitMode(options.waitMode), spinCount(options.spinCount), placement(placement), trace(trace),
+		  hMapFile(nullptr), hRequestEvent(nullptr), hResponseEvent(nullptr), hParent(nullptr), hParentWait(nullptr),
+		  pSharedMemory(nullptr), hStatsFile(nullptr), pStats(nullptr), hBulkFile(nullptr), pBulk(nullptr), bulkSize(options.bulkSize), bulkSlotSize(0) {
 	}
 
 	bool Initialize() {
@@ -83,90 +181,155 @@ public:
 			return false;
 		}
 
+		// Read-only for the client, it snapshots the counters without a round trip
+		hStatsFile = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, sizeof(StatsPage),
+			(sharedMemoryName + "_Stats").c_str());
+		pStats = hStatsFile != NULL ? (StatsPage*)MapViewOfFile(hStatsFile, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(StatsPage)) : nullptr;
+		if (pStats == nullptr) {
+			std::cerr << "Create stats shared memory failed: " << GetLastError() << std::endl;
+			return false;
+		}
+		new (pStats) StatsPage();
+		pStats->layout_version = STATS_LAYOUT_VERSION;
+		pStats->command_count = (uint32_t)Opcode::Count;
+		pStats->command_stats_size = sizeof(CommandStats);
+		pStats->bucket_count = STATS_BUCKET_COUNT;
+		pStats->sub_bucket_bits = STATS_SUB_BUCKET_BITS;
+		pStats->ticks_per_second = TicksPerSecond();
+
+		// Bulk side channel, split evenly between the ring slots
+		bulkSlotSize = (bulkSize / RING_SLOT_COUNT) & ~(uint32_t)(CACHE_LINE_SIZE - 1);
+		if (bulkSlotSize != 0) {
+			hBulkFile = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0,
+				bulkSlotSize * RING_SLOT_COUNT, (sharedMemoryName + "_Bulk").c_str());
+			pBulk = hBulkFile != NULL ? (char*)MapViewOfFile(hBulkFile, FILE_MAP_ALL_ACCESS, 0, 0, 0) : nullptr;
+			if (pBulk == nullptr) {
+				std::cerr << "Create bulk shared memory failed: " << GetLastError() << std::endl;
+				return false;
+			}
+		}
+
+		// Auto-reset events for the blocking part of the hybrid wait, one per direction
+		hRequestEvent = CreateEventA(NULL, FALSE, FALSE, (sharedMemoryName + "_RequestEvent").c_str());
+		hResponseEvent = CreateEventA(NULL, FALSE, FALSE, (sharedMemoryName + "_ResponseEvent").c_str());
+		if (hRequestEvent == NULL || hResponseEvent == NULL) {
+			std::cerr << "Create wait events failed: " << GetLastError() << std::endl;
+			return false;
+		}
+
+		// Watch the parent once instead of polling it from the request loop
+		hParent = OpenProcess(SYNCHRONIZE, FALSE, (DWORD)parentPid);
+		if (hParent == NULL) {
+			std::cout << "Parent process not found, exiting: " << GetLastError() << std::endl;
+			return false;
+		}
+		isRunning = true;  // Set before the watch starts, it may fire right away
+		if (!RegisterWaitForSingleObject(&hParentWait, hParent, OnParentExited, this, INFINITE, WT_EXECUTEONLYONCE)) {
+			std::cerr << "Watch parent process failed: " << GetLastError() << std::endl;
+			return false;
+		}
+
 		// Initialize shared memory structure
 		new (pSharedMemory) SharedMemoryLayout();
+		pSharedMemory->layout_version = SHARED_MEMORY_LAYOUT_VERSION;
+		pSharedMemory->layout_size = sizeof(SharedMemoryLayout);
+		pSharedMemory->slot_count = RING_SLOT_COUNT;
+		pSharedMemory->bulk_slot_size = bulkSlotSize;
+		pSharedMemory->server_cpu = placement.serverCpu;
+		pSharedMemory->client_cpu = placement.clientCpu;
 
 		std::cout << "Shared memory IPC server initialization successful" << std::endl;
 		return true;
 	}
 
 	void StartProcessing() {
-		isRunning = true;
-		uint32_t lastProcessedSequence = 0;
+		uint32_t nextSequence = 1;
+		threadStats = pStats;
+		ApplyThreadPlacement(placement);
 		std::cout << "Starting ultra-fast processing loop..." << std::endl;
 
 		while (isRunning) {
-			// Use atomic operations to check for new requests - This is much faster than system calls
-			uint32_t currentSequence = pSharedMemory->sequence_id.load(std::memory_order_acquire);
-			uint32_t requestFlag = pSharedMemory->request_flag.load(std::memory_order_acquire);
-
-			// Only process if there is a new request to avoid unnecessary CPU consumption
-			if (requestFlag == 1 && currentSequence != lastProcessedSequence) {
-
-				//// Record the start processing time
-				//uint64_t startTime = GetMicroseconds();
-				//pSharedMemory->last_request_time = startTime;
+			// Drain every published slot before looking at anything else, requests are
+			// completed strictly in order so the client can pipeline them
+			for (;;) {
+				RingSlot& slot = pSharedMemory->slots[(nextSequence - 1) % RING_SLOT_COUNT];
+				if (slot.request_sequence.load(std::memory_order_acquire) != nextSequence) {
+					break;
+				}
 
-				// Atomically mark as processing
-				pSharedMemory->request_flag.store(2, std::memory_order_release);
+				uint64_t startTime = Ticks();
+				pSharedMemory->last_request_time = startTime;
+				slot.pickup_time = startTime;
+				slot.dll_enter_time = 0;
+				slot.dll_exit_time = 0;
+				threadSlot = &slot;
 
 				// Process request - This is your core business logic
-				ProcessRequestUltraFast();
-
-				//// Record the end processing time
-				//uint64_t endTime = GetMicroseconds();
-				//pSharedMemory->last_response_time = endTime;
-
-				// Mark response as ready
-				pSharedMemory->response_flag.store(1, std::memory_order_release);
-				pSharedMemory->request_flag.store(0, std::memory_order_release);
+				BinaryStatus status = BinaryStatus::Ok;
+				if (slot.protocol_version == PROTOCOL_BINARY) {
+					status = ProcessBinaryRequest(slot);
+				}
+				else {
+					ProcessRequestUltraFast(slot);
+				}
 
-				// Update statistics
-				lastProcessedSequence = currentSequence;
+				threadSlot = nullptr;
+				uint64_t endTime = Ticks();
+				pSharedMemory->last_response_time = endTime;
+				slot.publish_time = endTime;
+				pStats->requests.Record(endTime - startTime);
+				if (trace != nullptr) {
+					trace->Append(slot, nextSequence, status);
+				}
 
-				//// Output performance statistics (optional, may need to be turned off in production)
-				//uint64_t processingTime = endTime - startTime;
-				//if (processingTime > 1000) {  // Only report if processing time is more than 1000 microseconds
-				//	std::cout << "Processing time: " << processingTime << " microseconds" << std::endl;
-				//}
+				// Publish the response, this also hands the slot back to the client.
+				// seq_cst orders the store before the client_waiting check.
+				slot.response_sequence.store(nextSequence, std::memory_order_seq_cst);
+				if (pSharedMemory->client_waiting.load(std::memory_order_seq_cst) != 0) {
+					SetEvent(hResponseEvent);
+				}
+				nextSequence++;
 			}
 
-			HANDLE hParent = OpenProcess(SYNCHRONIZE | PROCESS_QUERY_INFORMATION, FALSE, (DWORD)parentPid);
-
-			if (hParent == NULL) {
-				DWORD err = GetLastError();
-				ExitProcess(0);
-				std::cout << "Parent process not found, exiting: " << err << std::endl;
-				return;
+			if (waitMode == WAIT_BUSY_SPIN) {
+				// Extremely short sleep, yield CPU time slice but keep high responsiveness
+				Sleep(0);  // Yield time slice but immediately reschedule
 			}
 			else {
+				WaitForRequest(nextSequence);
+			}
+		}
 
-				DWORD exitCode = 0;
-
-				if (!GetExitCodeProcess(hParent, &exitCode)) {
-					DWORD err = GetLastError();
-					std::cerr << "GetExitCodeProcess failederror code: " << err << std::endl;
-					if (err == ERROR_ACCESS_DENIED) {
-						std::cerr << "Please try PROCESS_QUERY_LIMITED_INFORMATION" << std::endl;
-					}
-					else if (err == ERROR_INVALID_HANDLE) {
-						std::cerr << "Unvalued handle." << std::endl;
-					}
-				}
-
-				CloseHandle(hParent);
+		if (parentExited) {
+			std::cout << "Parent process has exited, exiting server." << std::endl;
+		}
+	}
 
-				if (exitCode != STILL_ACTIVE) {
-					std::cout << "Parent process has exited, exiting server." << std::endl;
-					isRunning = false;  // Stop processing loop
-				}
+private:
+	// Runs on a thread pool thread when the parent process handle is signaled
+	static void CALLBACK OnParentExited(PVOID context, BOOLEAN) {
+		auto* server = (UltraFastIPCServer*)context;
+		server->parentExited = true;
+		server->isRunning = false;  // Stop processing loop
+		SetEvent(server->hRequestEvent);
+	}
 
+	// Spins for a bounded time, then blocks until the client or the parent watch signals
+	void WaitForRequest(uint32_t sequence) {
+		RingSlot& slot = pSharedMemory->slots[(sequence - 1) % RING_SLOT_COUNT];
+		for (uint32_t i = 0; i < spinCount; i++) {
+			if (slot.request_sequence.load(std::memory_order_acquire) == sequence) {
+				return;
 			}
+			_mm_pause();
+		}
 
-			// Extremely short sleep, yield CPU time slice but keep high responsiveness
-			// In some cases, you may need to completely remove this Sleep to achieve extreme performance
-			Sleep(0);  // Yield time slice but immediately reschedule
+		// Announce first and look again, the client may have published in between
+		pSharedMemory->server_waiting.store(1, std::memory_order_seq_cst);
+		if (slot.request_sequence.load(std::memory_order_seq_cst) != sequence) {
+			WaitForSingleObject(hRequestEvent, INFINITE);
 		}
+		pSharedMemory->server_waiting.store(0, std::memory_order_relaxed);
 	}
 
 private:
@@ -181,1015 +344,516 @@ private:
 	}
 
 private:
-	void ProcessRequestUltraFast() {
-		// Get request data - Note that there is no memory allocation here
-		uint32_t requestSize = pSharedMemory->request_size;
-		const char* requestData = pSharedMemory->request_data;
+	void ProcessRequestUltraFast(RingSlot& slot) {
+		// Get request data - it is length delimited, stale bytes of earlier requests may follow it
+		std::string requestData(slot.request_data, std::min<uint32_t>(slot.request_size, sizeof(slot.request_data)));
 
 		std::string response = "0";
 		auto tokens = Split(requestData, ' ');
-		
-		try {
-			if (tokens[0] == "pe32_init") {
-				response = std::to_string(pe32_init());
-			}
-			else if (tokens[0] == "pe32_usb") {
-				response = std::to_string(pe32_usb());
-			}
-	/*		else if (tokens[0] == "pe32_CSenter") {
-				pe32_CSenter();
-			}
-			else if (tokens[0] == "pe32_CSleave") {
-				pe32_CSleave();
-			}
-			else if (tokens[0] == "pe32_mdelay") {
-				pe32_mdelay(std::stoi(tokens[1]));
-			}*/
-			else if (tokens[0] == "pe32_readl") {
-				int bdn = std::stoi(tokens[1]);
-				int offset = std::stoi(tokens[2]);
-				int buffer = 0;
-				response = std::to_string(pe32_readl(bdn, offset, &buffer));
-			}
-			else if (tokens[0] == "pe32_writel") {
-				int bdn = std::stoi(tokens[1]);
-				int offset = std::stoi(tokens[2]);
-				int buf = std::stoi(tokens[3]);
-				pe32_writel(bdn, offset, buf);
-			}
-			else if (tokens[0] == "pe32_set_sctl") {
-				int bdn = std::stoi(tokens[1]);
-				int data = std::stoi(tokens[2]);
-				pe32_set_sctl(bdn, data);
-			}
-			else if (tokens[0] == "pe32_set_sdata") {
-				int bdn = std::stoi(tokens[1]);
-				int data = std::stoi(tokens[2]);
-				pe32_set_sdata(bdn, data);
-			}
-			else if (tokens[0] == "pe32_rd_sio") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_sio(bdn));
-			}
-			else if (tokens[0] == "pe32_wr_pe") {
-				int bdn = std::stoi(tokens[1]);
-				int chip = std::stoi(tokens[2]);
-				int port = std::stoi(tokens[3]);
-				int data = std::stoi(tokens[4]);
-				pe32_wr_pe(bdn, chip, port, data);
-			}
-			else if (tokens[0] == "pe32_rd_pe") {
-				int bdn = std::stoi(tokens[1]);
-				int chip = std::stoi(tokens[2]);
-				int port = std::stoi(tokens[3]);
-				response = std::to_string(pe32_rd_pe(bdn, chip, port));
-			}
-			else if (tokens[0] == "pe32_rst_pe") {
-				int bdn = std::stoi(tokens[1]);
-				pe32_rst_pe(bdn);
-			}
-			else if (tokens[0] == "pe32_usleep") {
-				int usec = std::stoi(tokens[1]);
-				pe32_usleep(usec);
-			}
-			//Common functions
-			else if (tokens[0] == "pe32_init") {
-				response = std::to_string(pe32_init());
-			}
-			else if (tokens[0] == "pe32_api") {
-				response = std::to_string(pe32_api());
-			}
-			else if (tokens[0] == "pe32_reset") {
-				int bdn = std::stoi(tokens[1]);
-				pe32_reset(bdn);
-			}
-			else if (tokens[0] == "pe32_fdiag") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_fdiag(bdn));
-			}
-			else if (tokens[0] == "pe32_fstart") {
-				int bdn = std::stoi(tokens[1]);
-				int onoff = std::stoi(tokens[2]);
-				pe32_fstart(bdn, onoff);
-			}
-			else if (tokens[0] == "pe32_diag_fstart") {
-				int bdn = std::stoi(tokens[1]);
-				int onoff = std::stoi(tokens[2]);
-				pe32_diag_fstart(bdn, onoff);
-			}
-			else if (tokens[0] == "pe32_cycle") {
-				int bdn = std::stoi(tokens[1]);
-				int onoff = std::stoi(tokens[2]);
-				pe32_cycle(bdn, onoff);
-			}
-			else if (tokens[0] == "pe32_check_reset") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_reset(bdn));
-			}
-			else if (tokens[0] == "pe32_check_fstart") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_fstart(bdn));
-			}
-			else if (tokens[0] == "pe32_check_cycle") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_cycle(bdn));
-			}
-			else if (tokens[0] == "pe32_check_tprun") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_tprun(bdn));
-			}
-			else if (tokens[0] == "pe32_check_sync") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_sync(bdn));
-			}
-			else if (tokens[0] == "pe32_check_testbeg") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_testbeg(bdn));
-			}
-			else if (tokens[0] == "pe32_check_tpass") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_tpass(bdn));
-			}
-			else if (tokens[0] == "pe32_check_ftend") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_ftend(bdn));
-			}
-			else if (tokens[0] == "pe32_check_lend") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_lend(bdn));
-			}
-			else if (tokens[0] == "pe32_set_pxi") {
-				int bdn = std::stoi(tokens[1]);
-				int data = std::stoi(tokens[2]);
-				pe32_set_pxi(bdn, data);
-			}
-			else if (tokens[0] == "pe32_pxi_fstart") {
-				int bdn = std::stoi(tokens[1]);
-				int ch = std::stoi(tokens[2]);
-				int onoff = std::stoi(tokens[3]);
-				pe32_pxi_fstart(bdn, ch, onoff);
-			}
-			else if (tokens[0] == "pe32_pxi_cfail") {
-				int bdn = std::stoi(tokens[1]);
-				int ch = std::stoi(tokens[2]);
-				int onoff = std::stoi(tokens[3]);
-				pe32_pxi_cfail(bdn, ch, onoff);
-			}
-			else if (tokens[0] == "pe32_pxi_lmsyn") {
-				int bdn = std::stoi(tokens[1]);
-				int ch = std::stoi(tokens[2]);
-				int onoff = std::stoi(tokens[3]);
-				pe32_pxi_lmsyn(bdn, ch, onoff);
-			}
-			else if (tokens[0] == "pe32_set_addbeg") {
-				int bdn = std::stoi(tokens[1]);
-				long add = std::stol(tokens[2]);
-				pe32_set_addbeg(bdn, add);
-			}
-			else if (tokens[0] == "pe32_set_addend") {
-				int bdn = std::stoi(tokens[1]);
-				long cnt = std::stol(tokens[2]);
-				pe32_set_addend(bdn, cnt);
-			}
-			else if (tokens[0] == "pe32_set_ftcnt") {
-				int bdn = std::stoi(tokens[1]);
-				long cnt = std::stol(tokens[2]);
-				pe32_set_ftcnt(bdn, cnt);
-			}
-			else if (tokens[0] == "pe32_set_addsyn") {
-				int bdn = std::stoi(tokens[1]);
-				long add = std::stol(tokens[2]);
-				pe32_set_addsyn(bdn, add);
-			}
-			else if (tokens[0] == "pe32_set_addif") {
-				int bdn = std::stoi(tokens[1]);
-				long add = std::stol(tokens[2]);
-				pe32_set_addif(bdn, add);
-			}
-			else if (tokens[0] == "pe32_set_logadd") {
-				int bdn = std::stoi(tokens[1]);
-				long add = std::stol(tokens[2]);
-				pe32_set_logadd(bdn, add);
-			}
-			else if (tokens[0] == "pe32_set_seq") {
-				int bdn = std::stoi(tokens[1]);
-				long data = std::stol(tokens[2]);
-				pe32_set_seq(bdn, data);
-			}
-			else if (tokens[0] == "pe32_set_lmf") {
-				int bdn = std::stoi(tokens[1]);
-				long data = std::stol(tokens[2]);
-				pe32_set_lmf(bdn, data);
-			}
-			//else if (tokens[0] == "pe32_set_lmd") {
-			//    int bdn = std::stoi(tokens[1]);
-			//    long data = std::stol(tokens[2]);
-			//    pe32_set_lmd(bdn, data);
-			//}
-			//else if (tokens[0] == "pe32_set_lmm") {
-			//    int bdn = std::stoi(tokens[1]);
-			//    long data = std::stol(tokens[2]);
-			//    pe32_set_lmm(bdn, data);
-			//}
-			else if (tokens[0] == "pe32_set_mmsk") {
-				int bdn = std::stoi(tokens[1]);
-				long data = std::stol(tokens[2]);
-				pe32_set_mmsk(bdn, data);
-			}
-			else if (tokens[0] == "pe32_set_mmsk") {
-				int bdn = std::stoi(tokens[1]);
-				long data = std::stol(tokens[2]);
-				pe32_set_mmsk(bdn, data);
-			}
-			else if (tokens[0] == "pe32_set_tp") {
-				int bdn = std::stoi(tokens[1]);
-				int ts = std::stoi(tokens[2]);
-				long data = std::stol(tokens[3]);
-				pe32_set_tp(bdn, ts, data);
-			}
-			else if (tokens[0] == "pe32_set_tstrob") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				int ts = std::stoi(tokens[3]);
-				long data = std::stol(tokens[4]);
-				pe32_set_tstrob(bdn, pno, ts, data);
-			}
-			else if (tokens[0] == "pe32_set_tstart") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				int ts = std::stoi(tokens[3]);
-				long data = std::stol(tokens[4]);
-				pe32_set_tstart(bdn, pno, ts, data);
-			}
-			else if (tokens[0] == "pe32_set_tstop") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				int ts = std::stoi(tokens[3]);
-				long data = std::stol(tokens[4]);
-				pe32_set_tstop(bdn, pno, ts, data);
-			}
-			else if (tokens[0] == "pe32_set_rz") {
-				int bdn = std::stoi(tokens[1]);
-				int fs = std::stoi(tokens[2]);
-				long data = std::stol(tokens[3]);
-				pe32_set_rz(bdn, fs, data);
-			}
-			else if (tokens[0] == "pe32_set_ro") {
-				int bdn = std::stoi(tokens[1]);
-				int ts = std::stoi(tokens[2]);
-				long data = std::stol(tokens[3]);
-				pe32_set_ro(bdn, ts, data);
-			}
-			else if (tokens[0] == "pe32_set_io") {
-				int bdn = std::stoi(tokens[1]);
-				int ts = std::stoi(tokens[2]);
-				long data = std::stol(tokens[3]);
-				pe32_set_io(bdn, ts, data);
-			}
-			else if (tokens[0] == "pe32_set_mk") {
-				int bdn = std::stoi(tokens[1]);
-				int ts = std::stoi(tokens[2]);
-				long data = std::stol(tokens[3]);
-				pe32_set_mk(bdn, ts, data);
-			}
-			else if (tokens[0] == "pe32_set_dstrob") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				int ts = std::stoi(tokens[3]);
-				long data1 = std::stol(tokens[4]);
-				long data2 = std::stol(tokens[5]);
-				pe32_set_dstrob(bdn, pno, ts, data1, data2);
-			}
-			else if (tokens[0] == "pe32_rd_actseq") {
-				int bdn = std::stoi(tokens[1]);
-				pe32_rd_actseq(bdn);
-			}
-			else if (tokens[0] == "pe32_rd_actlmf") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_actlmf(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_actlmd") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_actlmd(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_actlmm") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_actlmm(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_actlmadd") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_actlmadd(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_pxibus") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_pxibus(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_id") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_id(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_vc") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_vc(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_seq") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_seq(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_lmf") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_lmf(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_lmd") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_lmd(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_lmm") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_lmm(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_lmadd") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_lmadd(bdn));
-			}
-			else if (tokens[0] == "pe32_lmload") {
-				int begbdno = std::stoi(tokens[1]);
-				int boardwidth = std::stoi(tokens[2]);
-				long begadd = std::stol(tokens[3]);
-				char* patternfileChar = new char[tokens[4].size() + 1];
-				strcpy(patternfileChar, tokens[4].c_str());
-				response = std::to_string(pe32_lmload(begbdno, boardwidth, begadd, patternfileChar));
-				delete[] patternfileChar;
-			}
-			else if (tokens[0] == "pe32_lmsave") {
-				int begbdno = std::stoi(tokens[1]);
-				int boardwidth = std::stoi(tokens[2]);
-				long begadd = std::stol(tokens[3]);
-				long endadd = std::stol(tokens[4]);
-				char* patternfileChar = new char[tokens[4].size() + 1];
-				strcpy(patternfileChar, tokens[4].c_str());
-				response = std::to_string(pe32_lmsave(begbdno, boardwidth, begadd, endadd, patternfileChar));
-				delete[] patternfileChar;
-			}
-			else if (tokens[0] == "pe32_rd_cmph") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_cmph(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_cmpl") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_cmpl(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_creg") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_creg(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_ftcnt") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_ftcnt(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_fccnt") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_fccnt(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_flcnt") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_flcnt(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_clog") {
-				int bdn = std::stoi(tokens[1]);
-				int addr = std::stoi(tokens[2]);
-				response = std::to_string(pe32_rd_clog(bdn, addr));
-			}
-			else if (tokens[0] == "pe32_rd_alog") {
-				int bdn = std::stoi(tokens[1]);
-				int addr = std::stoi(tokens[2]);
-				response = std::to_string(pe32_rd_alog(bdn, addr));
-			}
-			else if (tokens[0] == "pe32_rd_logadd") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_rd_logadd(bdn));
-			}
-			else if (tokens[0] == "pe32_rd_alogclog") {
-				int bdn = std::stoi(tokens[1]);
-				int addr = std::stoi(tokens[2]);
-				int alog;
-				int clog;
-				response = std::to_string(pe32_rd_alogclog(bdn, addr, &alog, &clog));
-			}
-			else if (tokens[0] == "pe32_dump_alogclog") {
-				int bdn = std::stoi(tokens[1]);
-				int Ksize = std::stoi(tokens[2]);
-				int alog;
-				int clog;
-				response = std::to_string(pe32_dump_alogclog(bdn, Ksize, &alog, &clog));
-			}
-			else if (tokens[0] == "pe32_set_dumpmode") {
-				int bdn = std::stoi(tokens[1]);
-				int onoff = std::stoi(tokens[2]);
-				pe32_set_dumpmode(bdn, onoff);
-			}
-			else if (tokens[0] == "pe32_dump_getclog") {
-				int bdn = std::stoi(tokens[1]);
-				int addr = std::stoi(tokens[2]);
-				response = std::to_string(pe32_dump_getclog(bdn, addr));
-			}
-			else if (tokens[0] == "pe32_dump_getalog") {
-				int bdn = std::stoi(tokens[1]);
-				int addr = std::stoi(tokens[2]);
-				response = std::to_string(pe32_dump_getalog(bdn, addr));
-			}
-			else if (tokens[0] == "pe32_dump_getalogclog") {
-				int bdn = std::stoi(tokens[1]);
-				int add = std::stoi(tokens[2]);
-				int alog;
-				int clog;
-				response = std::to_string(pe32_dump_getalogclog(bdn, add, &alog, &clog));
-			}
-			else if (tokens[0] == "pe32_check_dataready") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_dataready(bdn));
-			}
-			else if (tokens[0] == "pe32_check_checkmode") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_checkmode(bdn));
-			}
-			else if (tokens[0] == "pe32_check_logmode") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_logmode(bdn));
-			}
-			else if (tokens[0] == "pe32_check_trigmode") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_trigmode(bdn));
-			}
-			else if (tokens[0] == "pe32_check_dualmode") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_dualmode(bdn));
-			}
-			else if (tokens[0] == "pe32_set_trigmode") {
-				int bdn = std::stoi(tokens[1]);
-				int onoff = std::stoi(tokens[2]);
-				pe32_set_trigmode(bdn, onoff);
-			}
-			else if (tokens[0] == "pe32_set_logmode") {
-				int bdn = std::stoi(tokens[1]);
-				int onoff = std::stoi(tokens[2]);
-				pe32_set_logmode(bdn, onoff);
-			}
-		/*	else if (tokens[0] == "pe32_set_208M") {
-				int bdn = std::stoi(tokens[1]);
-				int onoff = std::stoi(tokens[2]);
-				pe32_set_208M(bdn, onoff);
-			}*/
-			else if (tokens[0] == "pe32_check_ucnt") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_check_ucnt(bdn));
-			}
-			else if (tokens[0] == "pe32_set_checkmode") {
-				int bdn = std::stoi(tokens[1]);
-				int onoff = std::stoi(tokens[2]);
-				pe32_set_checkmode(bdn, onoff);
-			}
-			else if (tokens[0] == "pe32_set_vih") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				double rv = std::stod(tokens[3]);
-				pe32_set_vih(bdn, pno, rv);
-			}
-			else if (tokens[0] == "pe32_set_vil") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				double rv = std::stod(tokens[3]);
-				pe32_set_vil(bdn, pno, rv);
-			}
-			else if (tokens[0] == "pe32_set_voh") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				double rv = std::stod(tokens[3]);
-				pe32_set_voh(bdn, pno, rv);
-			}
-			else if (tokens[0] == "pe32_set_vol") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				double rv = std::stod(tokens[3]);
-				pe32_set_vol(bdn, pno, rv);
-			}
-			else if (tokens[0] == "pe32_set_driver") {
-				int bdno = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				int onoff = std::stoi(tokens[3]);
-				pe32_set_driver(bdno, pno, onoff);
-			}
-			else if (tokens[0] == "pe32_cpu_df") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				int donoff = std::stoi(tokens[3]);
-				int fonoff = std::stoi(tokens[4]);
-				pe32_cpu_df(bdn, pno, donoff, fonoff);
-			}
-			else if (tokens[0] == "pe32_pmufv") {
-				int bdn = std::stoi(tokens[1]);
-				int chip = std::stoi(tokens[2]);
-				double rv = std::stod(tokens[3]);
-				double clamp = std::stod(tokens[4]);
-				pe32_pmufv(bdn, chip, rv, clamp);
-			}
-			else if (tokens[0] == "pe32_pmufi") {
-				int bdn = std::stoi(tokens[1]);
-				int chip = std::stoi(tokens[2]);
-				double ri = std::stod(tokens[3]);
-				double cvh = std::stod(tokens[4]);
-				double cvl = std::stod(tokens[5]);
-				pe32_pmufi(bdn, chip, ri, cvh, cvl);
-			}
-			else if (tokens[0] == "pe32_pmufir") {
-				int bdn = std::stoi(tokens[1]);
-				int chip = std::stoi(tokens[2]);
-				double ri = std::stod(tokens[3]);
-				double cvh = std::stod(tokens[4]);
-				double cvl = std::stod(tokens[5]);
-				int rang = std::stoi(tokens[6]);
-				pe32_pmufir(bdn, chip, ri, cvh, cvl, rang);
-			}
-			else if (tokens[0] == "pe32_vmeas") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				pe32_vmeas(bdn, pno);
-			}
-			else if (tokens[0] == "pe32_imeas") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				pe32_imeas(bdn, pno);
-			}
-			else if (tokens[0] == "pe32_pmucv") {
-				int bdn = std::stoi(tokens[1]);
-				int chip = std::stoi(tokens[2]);
-				int cvh = std::stoi(tokens[3]);
-				int cvl = std::stoi(tokens[4]);
-				pe32_pmucv(bdn, chip, cvh, cvl);
+
+		// Hash lookup instead of comparing against every command name
+		const CommandInfo* command = tokens.empty() ? nullptr : FindCommand(tokens[0]);
+
+		if (command == nullptr) {
+			response = "Unknown command :" + (tokens.empty() ? std::string() : tokens[0]);
+			cout << response << endl;
+		}
+		else {
+			try {
+				// Re-encode the arguments and share the binary dispatch path
+				char request[sizeof(slot.request_data)];
+				char result[sizeof(slot.response_data)];
+				BinaryWriter requestWriter(request, sizeof(request));
+				BinaryWriter out(result, sizeof(result));
+				BulkRegion bulk = SlotBulk(slot);
+
+				BinaryStatus status = BinaryStatus::BadArguments;
+				if (EncodeTextRequest(*command, tokens, requestWriter)) {
+					BinaryReader in(request, requestWriter.Size(), &bulk);
+					auto header = in.Read<BinaryRequestHeader>();
+					status = DispatchBinary(header, in, out);
+				}
+
+				if (status == BinaryStatus::Ok) {
+					BinaryReader resultReader(result, out.Size(), &bulk);
+					response = FormatTextResult(*command, resultReader);
+				}
+				else {
+					response = "error";
+				}
 			}
-			else if (tokens[0] == "pe32_pmuci") {
-				int bdn = std::stoi(tokens[1]);
-				int chip = std::stoi(tokens[2]);
-				int cih = std::stoi(tokens[3]);
-				int cil = std::stoi(tokens[4]);
-				pe32_pmuci(bdn, chip, cih, cil);
+			catch (...) {
+				response = "error";
 			}
-			else if (tokens[0] == "pe32_con_pmu") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				int onoff = std::stoi(tokens[3]);
-				pe32_con_pmu(bdn, pno, onoff);
+		}
+		// Hex payloads take two characters per byte, what does not fit in the slot is an error
+		if (response.size() > sizeof(slot.response_data)) {
+			response = "error";
+		}
+		// Directly write to shared memory, no extra allocation needed
+		memcpy(slot.response_data, response.c_str(), response.size());
+		slot.response_size = response.size();
+	}
+
+	// Bulk part owned by the slot, payloads of one response are packed from its start
+	BulkRegion SlotBulk(const RingSlot& slot) {
+		if (pBulk == nullptr) {
+			return { nullptr, 0, 0 };
+		}
+		size_t index = &slot - pSharedMemory->slots;
+		return { pBulk + index * bulkSlotSize, bulkSlotSize, 0 };
+	}
+
+	BinaryStatus ProcessBinaryRequest(RingSlot& slot) {
+		uint32_t requestSize = std::min<uint32_t>(slot.request_size, sizeof(slot.request_data));
+		BulkRegion bulk = SlotBulk(slot);
+		BinaryReader in(slot.request_data, requestSize, &bulk);
+
+		// Status goes first, the packed return value right after it
+		char* responseData = slot.response_data;
+		BinaryWriter out(responseData + sizeof(int32_t), sizeof(slot.response_data) - sizeof(int32_t));
+
+		BinaryStatus status = BinaryStatus::BadArguments;
+		auto header = in.Read<BinaryRequestHeader>();
+		bool batch = header.opcode == BATCH_OPCODE;
+		if (in.Ok() && (header.flags & ~BINARY_FLAG_NO_REPLY) == 0) {
+			try {
+				status = batch ? DispatchBatch(in, out) : DispatchBinary(header, in, out);
 			}
-			else if (tokens[0] == "pe32_con_pmus") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				int onoff = std::stoi(tokens[3]);
-				pe32_con_pmus(bdn, pno, onoff);
+			catch (...) {
+				status = BinaryStatus::Exception;
 			}
-			else if (tokens[0] == "pe32_con_receiver") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				int onoff = std::stoi(tokens[3]);
-				pe32_con_receiver(bdn, pno, onoff);
+		}
+		// Nobody waits for a fire-and-forget response, only a failure is kept
+		if (header.flags & BINARY_FLAG_NO_REPLY) {
+			if (status != BinaryStatus::Ok) {
+				LatchStickyError(status, header.opcode, slot.request_sequence.load(std::memory_order_relaxed));
 			}
-			else if (tokens[0] == "pe32_check_pmu") {
-				int bdn = std::stoi(tokens[1]);
-				int chip = std::stoi(tokens[2]);
-				response = std::to_string(pe32_check_pmu(bdn, chip));
+			return status;
+		}
+
+		// A failed batch still reports the sub-requests that ran
+		if (status != BinaryStatus::Ok && !batch) {
+			out.Reset();
+		}
+		int32_t statusValue = (int32_t)status;
+		memcpy(responseData, &statusValue, sizeof(statusValue));
+		slot.response_size = sizeof(statusValue) + out.Size();
+		return status;
+	}
+
+	// Only the first failure is kept until the client has reported it
+	void LatchStickyError(BinaryStatus status, uint16_t opcode, uint32_t sequence) {
+		if (pSharedMemory->sticky_error.load(std::memory_order_acquire) != 0) {
+			return;
+		}
+		pSharedMemory->sticky_error_opcode = opcode;
+		pSharedMemory->sticky_error_sequence = sequence;
+		pSharedMemory->sticky_error.store((int32_t)status, std::memory_order_release);
+	}
+
+	// Runs the sub-requests of a batch in order and stops at the first failure
+	static BinaryStatus DispatchBatch(BinaryReader& in, BinaryWriter& out) {
+		uint16_t count = in.Read<uint16_t>();
+		char* executedField = out.Reserve(sizeof(uint16_t));
+		if (!in.Ok() || executedField == nullptr) {
+			return BinaryStatus::BadArguments;
+		}
+		memset(executedField, 0, sizeof(uint16_t));
+		if (BatchReducer::enabled) {
+			return DispatchReducedBatch(in, count, executedField, out);
+		}
+
+		for (uint16_t executed = 0; executed < count;) {
+			uint16_t size = in.Read<uint16_t>();
+			const char* data = in.ReadBytes(size);
+			if (data == nullptr) {
+				return BinaryStatus::BadArguments;
 			}
-			else if (tokens[0] == "pe32_pmuch") {
-				int bdn = std::stoi(tokens[1]);
-				int chip = std::stoi(tokens[2]);
-				response = std::to_string(pe32_pmuch(bdn, chip));
+
+			BinaryStatus status;
+			if (!RunBatchEntry(data, size, in.Bulk(), false, out, status)) {
+				return BinaryStatus::ResponseTooLarge;
 			}
-			else if (tokens[0] == "pe32_pmucl") {
-				int bdn = std::stoi(tokens[1]);
-				int chip = std::stoi(tokens[2]);
-				response = std::to_string(pe32_pmucl(bdn, chip));
+			executed++;
+			memcpy(executedField, &executed, sizeof(executed));
+
+			if (status != BinaryStatus::Ok) {
+				return status;
 			}
-			else if (tokens[0] == "pe32_cal_load") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_cal_load(bdn, tokens[2].c_str()));
+		}
+		return in.AtEnd() ? BinaryStatus::Ok : BinaryStatus::BadArguments;
+	}
+
+	// --reduce-batches: runs the sub-requests in the order BatchReducer planned and answers them
+	// in the order they were sent. Those a failure kept from running report NotRun, and so do
+	// coalesced writes whose overwriting write did not succeed, as they never reached the DLL.
+	static BinaryStatus DispatchReducedBatch(BinaryReader& in, uint16_t count, char* executedField, BinaryWriter& out) {
+		BatchReducer reducer;
+		if (!reducer.Parse(in, count)) {
+			return BinaryStatus::BadArguments;
+		}
+		reducer.Reduce();
+
+		// Offset and size of the answer of each entry, in the order they ran
+		std::array<std::pair<uint32_t, uint32_t>, MAX_BATCH_ENTRIES> answers{};
+		uint32_t answersStart = out.Size();
+		std::array<BinaryStatus, MAX_BATCH_ENTRIES> statuses;
+		statuses.fill(BinaryStatus::NotRun);
+		BinaryStatus failure = BinaryStatus::Ok;
+		uint16_t reported = 0;
+		for (uint16_t step = 0; step < count; step++) {
+			uint16_t index = reducer.Order(step);
+			const BatchEntry& entry = reducer.Entry(index);
+			uint32_t start = out.Size();
+			if (!RunBatchEntry(entry.data, entry.size, in.Bulk(), entry.coalesced, out, failure)) {
+				failure = BinaryStatus::ResponseTooLarge;
+				break;
+			}
+			answers[index] = { start, out.Size() - start };
+			statuses[index] = failure;
+			reported = std::max<uint16_t>(reported, index + 1);
+			if (failure != BinaryStatus::Ok) {
+				break;
 			}
-			else if (tokens[0] == "pe32_cal_save") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_cal_save(bdn, tokens[2].c_str()));
+		}
+
+		// Later writes are settled first, so a chain of overwritten writes falls back as a whole
+		if (failure != BinaryStatus::Ok) {
+			for (uint16_t index = count; index-- > 0;) {
+				const BatchEntry& entry = reducer.Entry(index);
+				if (entry.coalesced && statuses[index] == BinaryStatus::Ok
+					&& statuses[entry.overwrittenBy] != BinaryStatus::Ok) {
+					statuses[index] = BinaryStatus::NotRun;
+					int32_t notRun = (int32_t)BinaryStatus::NotRun;
+					memcpy(out.At(answers[index].first + sizeof(uint16_t)), &notRun, sizeof(notRun));
+				}
 			}
-			else if (tokens[0] == "pe32_cal_load_auto") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_cal_load_auto(bdn, tokens[2].c_str()));
+		}
+
+		if (reducer.Reordered()) {
+			char ran[MESSAGE_BUFFER_SIZE];
+			uint32_t ranSize = out.Size() - answersStart;
+			memcpy(ran, out.At(answersStart), ranSize);
+			out.Rewind(answersStart);
+			for (uint16_t index = 0; index < reported; index++) {
+				auto [start, size] = answers[index];
+				if (size == 0) {
+					uint16_t notRunSize = sizeof(int32_t);
+					int32_t notRun = (int32_t)BinaryStatus::NotRun;
+					out.Write(notRunSize);
+					out.Write(notRun);
+				}
+				else {
+					out.WriteBytes(ran + (start - answersStart), size);
+				}
+				if (!out.Ok()) {
+					reported = index;
+					failure = BinaryStatus::ResponseTooLarge;
+					break;
+				}
 			}
-			else if (tokens[0] == "pe32_cal_save_auto") {
-				int bdn = std::stoi(tokens[1]);
-				response = std::to_string(pe32_cal_save_auto(bdn, tokens[2].c_str()));
+		}
+		memcpy(executedField, &reported, sizeof(reported));
+		return failure;
+	}
+
+	// Runs one sub-request of a batch and appends uint16 size + status + result.
+	// A coalesced one is answered as the void command it is. False without
+	// room for the answer.
+	static bool RunBatchEntry(const char* data, uint16_t size, BulkRegion* bulk, bool coalesced, BinaryWriter& out,
+		BinaryStatus& status) {
+		char* sizeField = out.Reserve(sizeof(uint16_t));
+		char* statusField = out.Reserve(sizeof(int32_t));
+		if (statusField == nullptr) {
+			return false;
+		}
+		uint32_t resultStart = out.Size();
+
+		BinaryReader sub(data, size, bulk);
+		auto header = sub.Read<BinaryRequestHeader>();
+		status = BinaryStatus::BadArguments;
+		if (coalesced) {
+			status = BinaryStatus::Ok;
+			if (threadStats != nullptr) {
+				StatsIncrement(threadStats->batch_coalesced);
+				StatsIncrement(threadStats->commands[header.opcode].skipped);
 			}
-			else if (tokens[0] == "pe32_cal_reset") {
-				int bdn = std::stoi(tokens[1]);
-				pe32_cal_reset(bdn);
+		}
+		else if (sub.Ok() && header.flags == 0 && header.opcode != BATCH_OPCODE) {
+			try {
+				status = header.opcode == POLL_OPCODE ? DispatchPoll(header, sub, out) : DispatchBinary(header, sub, out);
 			}
-			else if (tokens[0] == "pe32_con_esense") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				int onoff = std::stoi(tokens[3]);
-				pe32_con_esense(bdn, pno, onoff);
+			catch (...) {
+				status = BinaryStatus::Exception;
 			}
-			else if (tokens[0] == "pe32_con_eforce") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				int onoff = std::stoi(tokens[3]);
-				pe32_con_eforce(bdn, pno, onoff);
+		}
+		if (status != BinaryStatus::Ok) {
+			out.Rewind(resultStart);
+		}
+
+		uint16_t resultSize = (uint16_t)(sizeof(int32_t) + out.Size() - resultStart);
+		int32_t statusValue = (int32_t)status;
+		memcpy(sizeField, &resultSize, sizeof(resultSize));
+		memcpy(statusField, &statusValue, sizeof(statusValue));
+		return true;
+	}
+
+	// Runs the request of a poll until its return value meets the condition, see POLL_OPCODE.
+	// Every run takes the command's DispatchLock on its own, so other channels get their
+	// turn in between. The response is that of the last run.
+	static BinaryStatus DispatchPoll(const BinaryRequestHeader& header, BinaryReader& in, BinaryWriter& out) {
+		auto condition = in.Read<BinaryPollCondition>();
+		uint32_t size = in.Remaining();
+		const char* data = in.ReadBytes(size);
+		if (!in.Ok() || header.arg_count != sizeof(BinaryPollCondition) / sizeof(int32_t)
+			|| (condition.compare != POLL_EQUAL && condition.compare != POLL_NOT_EQUAL)) {
+			return BinaryStatus::BadArguments;
+		}
+
+		BinaryReader first(data, size);
+		auto polled = first.Read<BinaryRequestHeader>();
+		if (!first.Ok() || polled.flags != 0 || polled.opcode >= (uint16_t)Opcode::Count) {
+			return BinaryStatus::BadArguments;
+		}
+		WireType returnType = kCommands[polled.opcode].returnType;
+		if (returnType != WireType::Int32 && returnType != WireType::UInt32) {
+			return BinaryStatus::BadArguments;
+		}
+
+		uint64_t deadline = Ticks() + (uint64_t)condition.timeout_us * TicksPerSecond() / 1000000;
+		uint32_t resultStart = out.Size();
+		for (;;) {
+			out.Rewind(resultStart);
+			BinaryReader run(data, size, in.Bulk());
+			auto runHeader = run.Read<BinaryRequestHeader>();
+			BinaryStatus status = DispatchBinary(runHeader, run, out);
+			if (status != BinaryStatus::Ok) {
+				return status;
 			}
-			else if (tokens[0] == "pe32_con_ext") {
-				int bdn = std::stoi(tokens[1]);
-				int pno = std::stoi(tokens[2]);
-				int onoff = std::stoi(tokens[3]);
-				pe32_con_ext(bdn, pno, onoff);
+
+			int32_t result;
+			memcpy(&result, out.At(resultStart), sizeof(result));
+			if (((result & condition.mask) == condition.value) == (condition.compare == POLL_EQUAL)) {
+				return BinaryStatus::Ok;
 			}
-			else if (tokens[0] == "pe32_set_deskew") {
-				int bdn = std::stoi(tokens[1]);
-				int onoff = std::stoi(tokens[2]);
-				int rt = std::stoi(tokens[3]);
-				pe32_set_deskew(bdn, onoff, rt);
+			if (Ticks() >= deadline) {
+				return BinaryStatus::Timeout;
 			}
-			else {
-				ProcessCommonAPI(tokens, response);
+			if (condition.interval_us != 0) {
+				CommandTimer timer(Opcode::pe32_usleep);
+				pe32_usleep((int)condition.interval_us);
 			}
+		}
+	}
 
+	// Opcodes are dense, so this compiles to a jump table.
+	// Only void commands are shadowed, a skipped one returns void(). A call that
+	// throws leaves the shadow without the value, the board may not hold it.
+	// Telemetry sampling starts once a pe32_init returned boards.
+	static BinaryStatus DispatchBinary(const BinaryRequestHeader& header, BinaryReader& in, BinaryWriter& out) {
+		switch ((Opcode)header.opcode) {
+#define PE32_COMMAND(name, signature) \
+		case Opcode::name: \
+			return CommandThunk<signature>::Invoke([](auto... args) { \
+				DispatchLock lock(Opcode::name, args...); \
+				if (!IssueWrite(Opcode::name, args...)) { \
+					return decltype(name(args...))(); \
+				} \
+				CommandTimer timer(Opcode::name); \
+				try { \
+					if constexpr (Opcode::name == Opcode::pe32_init) { \
+						int boards = name(args...); \
+						TelemetrySampler::Initialized(boards); \
+						return boards; \
+					} \
+					else { \
+						return name(args...); \
+					} \
+				} \
+				catch (...) { \
+					ShadowRegisters::Forget(Opcode::name, args...); \
+					throw; \
+				} \
+			}, header, in, out);
+#define PE32_COMMAND_EX(name, signature, target) \
+		case Opcode::name: \
+			return CommandThunk<signature>::Invoke([](auto... args) { \
+				DispatchLock lock(Opcode::name, args...); \
+				CommandTimer timer(Opcode::name); \
+				return target(args...); \
+			}, header, in, out);
+#include "PE32Commands.h"
+#undef PE32_COMMAND_EX
+#undef PE32_COMMAND
+		default:
+			return BinaryStatus::UnknownOpcode;
 		}
-		catch (...) {
-			response = "error";
+	}
+
+	// The vendor writes size bytes into data, they go back to the client as a byte payload
+	static int UserFramLoad(int bdn, int add, int size, OutBytes* data) {
+		if (size < 0 || (uint32_t)size > OutBytes::Capacity) {
+			throw std::length_error("pe32_user_fram_load size exceeds the response buffer");
+		}
+		int result = pe32_user_fram_load(bdn, add, data->data, size);
+		data->size = (uint32_t)size;
+		return result;
+	}
+
+	// Claims count int32 values of the bulk buffer
+	static int32_t* BulkValues(BulkBuffer* bulk, int64_t count) {
+		if (count < 0 || (uint64_t)count * sizeof(int32_t) > bulk->capacity) {
+			throw std::length_error("Bulk request exceeds the bulk region of the slot");
+		}
+		bulk->size = (uint32_t)count * sizeof(int32_t);
+		return (int32_t*)bulk->data;
+	}
+
+	// Calls read(i, values) for every i in [begin, end), each call fills ValuesPerItem values.
+	// end is 64 bit, so begin + count of the counted reads can not overflow.
+	template <int ValuesPerItem, typename Read>
+	static void BulkRange(BulkBuffer* bulk, int begin, int64_t end, Read read) {
+		if (end < begin) {
+			throw std::invalid_argument("Bulk range ends before it begins");
 		}
-		if (debugMode) {
-			cout << requestData << endl;
+		if (end > (int64_t)INT32_MAX + 1) {
+			throw std::invalid_argument("Bulk range ends past the last address");
 		}
-		
-		// Directly write to shared memory, no extra allocation needed
-		memcpy(pSharedMemory->response_data, response.c_str(), response.size());
-		pSharedMemory->response_size = response.size();
+		int32_t* values = BulkValues(bulk, (end - begin) * ValuesPerItem);
+		for (int64_t i = begin; i < end; i++, values += ValuesPerItem) {
+			read((int)i, values);
+		}
+	}
+
+	static void BulkDumpGetAlog(int bdn, int addr, int count, BulkBuffer* alog) {
+		BulkRange<1>(alog, addr, (int64_t)addr + count, [bdn](int add, int32_t* values) {
+			values[0] = pe32_dump_getalog(bdn, add);
+		});
+	}
+
+	static void BulkDumpGetClog(int bdn, int addr, int count, BulkBuffer* clog) {
+		BulkRange<1>(clog, addr, (int64_t)addr + count, [bdn](int add, int32_t* values) {
+			values[0] = pe32_dump_getclog(bdn, add);
+		});
+	}
+
+	static void BulkDumpGetAlogClog(int bdn, int begin, int end, BulkBuffer* alogclog) {
+		BulkRange<2>(alogclog, begin, end, [bdn](int add, int32_t* values) {
+			int alog = 0, clog = 0;
+			pe32_dump_getalogclog(bdn, add, &alog, &clog);
+			values[0] = alog;
+			values[1] = clog;
+		});
+	}
 
-		// Clear request data after finishing response
-		memset(pSharedMemory->request_data, 0, requestSize);
+	static void BulkSrdRdBlock32(int bdn, int begin, int end, BulkBuffer* blocks) {
+		BulkRange<1>(blocks, begin, end, [bdn](int add, int32_t* values) {
+			int block = 0;
+			pe32_srd_rdblock32(bdn, add, &block);
+			values[0] = block;
+		});
 	}
 
-	void ProcessCommonAPI(std::vector<std::string>& tokens, std::string& response) {
-		if (tokens[0] == "pe32_set_fallingskew") {
-			int bdn = std::stoi(tokens[1]);
-			int pno = std::stoi(tokens[2]);
-			int rt = std::stoi(tokens[3]);
-			pe32_set_fallingskew(bdn, pno, rt);
-		}
-		else if (tokens[0] == "pe32_set_rcvskew") {
-			int bdn = std::stoi(tokens[1]);
-			int pno = std::stoi(tokens[2]);
-			int rt = std::stoi(tokens[3]);
-			pe32_set_rcvskew(bdn, pno, rt);
-		}
-		else if (tokens[0] == "pe32_set_rcvfallingskew") {
-			int bdn = std::stoi(tokens[1]);
-			int pno = std::stoi(tokens[2]);
-			int rt = std::stoi(tokens[3]);
-			pe32_set_rcvfallingskew(bdn, pno, rt);
-		}
-		else if (tokens[0] == "pe32_getch") {
-			int bdn = std::stoi(tokens[1]);
-			int pno = std::stoi(tokens[2]);
-			response = std::to_string(pe32_getch(bdn, pno));
-		}
-		else if (tokens[0] == "pe32_getcl") {
-			int bdn = std::stoi(tokens[1]);
-			int pno = std::stoi(tokens[2]);
-			response = std::to_string(pe32_getcl(bdn, pno));
-		}
-		else if (tokens[0] == "pemu32_rst_pe") {
-			int bdn = std::stoi(tokens[1]);
-			pemu32_rst_pe(bdn);
-		}
-		else if (tokens[0] == "pemu32_set_driver") {
-			int bdn = std::stoi(tokens[1]);
-			int pno = std::stoi(tokens[2]);
-			int onoff = std::stoi(tokens[3]);
-			pemu32_set_driver(bdn, pno, onoff);
-		}
-		else if (tokens[0] == "pe32_counter_ctp") {
-			int bdn = std::stoi(tokens[1]);
-			long data = std::stol(tokens[2]);
-			pe32_counter_ctp(bdn, data);
-		}
-		else if (tokens[0] == "pe32_counter_start") {
-			int bdn = std::stoi(tokens[1]);
-			int onoff = std::stoi(tokens[2]);
-			pe32_counter_start(bdn, onoff);
-		}
-		else if (tokens[0] == "pe32_counter_select_ch") {
-			int bdn = std::stoi(tokens[1]);
-			int ch = std::stoi(tokens[2]);
-			pe32_counter_select_ch(bdn, ch);
-		}
-		else if (tokens[0] == "pe32_counter_rd") {
-			int bdn = std::stoi(tokens[1]);
-			response = std::to_string(pe32_counter_rd(bdn));
-		}
-		else if (tokens[0] == "pe32_counter_rdfrq") {
-			int bdn = std::stoi(tokens[1]);
-			response = std::to_string(pe32_counter_rdfrq(bdn));
-		}
-		else if (tokens[0] == "pe32_counter_tmmode") {
-			int bdn = std::stoi(tokens[1]);
-			int onoff = std::stoi(tokens[2]);
-			pe32_counter_tmmode(bdn, onoff);
-		}
-		else if (tokens[0] == "pe32_tmu_cstart_inv") {
-			int bdn = std::stoi(tokens[1]);
-			int onoff = std::stoi(tokens[2]);
-			pe32_tmu_cstart_inv(bdn, onoff);
-		}
-		else if (tokens[0] == "pe32_tmu_cstop_inv") {
-			int bdn = std::stoi(tokens[1]);
-			int onoff = std::stoi(tokens[2]);
-			pe32_tmu_cstop_inv(bdn, onoff);
-		}
-		else if (tokens[0] == "pe32_tmu_select_cstart") {
-			int bdn = std::stoi(tokens[1]);
-			int ch = std::stoi(tokens[2]);
-			pe32_tmu_select_cstart(bdn, ch);
-		}
-		else if (tokens[0] == "pe32_tmu_select_cstop") {
-			int bdn = std::stoi(tokens[1]);
-			int ch = std::stoi(tokens[2]);
-			pe32_tmu_select_cstop(bdn, ch);
-		}
-		else if (tokens[0] == "pe32_rd_pesno") {
-			int bdn = std::stoi(tokens[1]);
-			response = std::to_string(pe32_rd_pesno(bdn));
-		}
-		else if (tokens[0] == "pe32_get_temp") {
-			int bdn = std::stoi(tokens[1]);
-			int cno = std::stoi(tokens[2]);
-			response = std::to_string(pe32_get_temp(bdn, cno));
-		}
-		else if (tokens[0] == "pe32_set_srdmode") {
-			int bdn = std::stoi(tokens[1]);
-			int onoff = std::stoi(tokens[2]);
-			pe32_set_srdmode(bdn, onoff);
-		}
-		else if (tokens[0] == "pe32_set_logadd") {
-			int bdn = std::stoi(tokens[1]);
-			long add = std::stol(tokens[2]);
-			pe32_set_logadd(bdn, add);
-		}
-		else if (tokens[0] == "pe32_srd_select_ch") {
-			int bdn = std::stoi(tokens[1]);
-			int ch = std::stoi(tokens[2]);
-			pe32_srd_select_ch(bdn, ch);
-		}
-		else if (tokens[0] == "pe32_srd_getword") {
-			int bdn = std::stoi(tokens[1]);
-			response = std::to_string(pe32_srd_getword(bdn));
-		}
-		else if (tokens[0] == "pe32_srd_getword2") {
-			int bdn = std::stoi(tokens[1]);
-			response = std::to_string(pe32_srd_getword2(bdn));
-		}
-		else if (tokens[0] == "pe32_srd_getsrword") {
-			int bdn = std::stoi(tokens[1]);
-			int ch = std::stoi(tokens[2]);
-			response = std::to_string(pe32_srd_getsrword(bdn, ch));
-		}
-		else if (tokens[0] == "pe32_srd_rdblock32") {
-			int bdn = std::stoi(tokens[1]);
-			long add = std::stol(tokens[2]);
-			int rdblock32;
-			pe32_srd_rdblock32(bdn, add, &rdblock32);
-			response = std::to_string(rdblock32);
-		}
-		else if (tokens[0] == "pe32_setReg") {
-			int bdn = std::stoi(tokens[1]);
-			int pno = std::stoi(tokens[2]);
-			int dacno = std::stoi(tokens[3]);
-			int rv = std::stoi(tokens[4]);
-			pe32_setReg(bdn, pno, dacno, rv);
-		}
-		else if (tokens[0] == "pe32_dc_range") {
-			int bdn = std::stoi(tokens[1]);
-			int range = std::stoi(tokens[2]);
-			pe32_dc_range(bdn, range);
-		}
-		else if (tokens[0] == "pe32_set_lmsyn_active_high") {
-			int bdn = std::stoi(tokens[1]);
-			int onoff = std::stoi(tokens[2]);
-			pe32_set_lmsyn_active_high(bdn, onoff);
-		}
-		else if (tokens[0] == "pe32_set_lmsyn_ch") {
-			int bdn = std::stoi(tokens[1]);
-			int ch = std::stoi(tokens[2]);
-			pe32_set_lmsyn_ch(bdn, ch);
-		}
-		else if (tokens[0] == "pe32_rd_logcnt") {
-			int bdn = std::stoi(tokens[1]);
-			response = std::to_string(pe32_rd_logcnt(bdn));
-		}
-		else if (tokens[0] == "pe32_reset_lmiomk") {
-			int bdn = std::stoi(tokens[1]);
-			pe32_reset_lmiomk(bdn);
-		}
-		else if (tokens[0] == "pe32_con_2k2vtt") {
-			int bdn = std::stoi(tokens[1]);
-			int pno = std::stoi(tokens[2]);
-			int onoff = std::stoi(tokens[3]);
-			double vtt = std::stod(tokens[4]);
-			pe32_con_2k2vtt(bdn, pno, onoff, vtt);
-		}
-		else if (tokens[0] == "pe32_get_msg") {
-			response = pe32_get_msg();
-		}
-		else if (tokens[0] == "pe32_set_rffemode") {
-			int bdn = std::stoi(tokens[1]);
-			int port = std::stoi(tokens[2]);
-			int onoff = std::stoi(tokens[3]);
-			pe32_set_rffemode(bdn, port, onoff);
-		}
-		else if (tokens[0] == "pe32_rffe_ftp") {
-			int bdn = std::stoi(tokens[1]);
-			int wtp = std::stoi(tokens[2]);
-			int rtp = std::stoi(tokens[3]);
-			pe32_rffe_ftp(bdn, wtp, rtp);
-		}
-		else if (tokens[0] == "pe32_rffe_pclk") {
-			int bdn = std::stoi(tokens[1]);
-			int pclk = std::stoi(tokens[2]);
-			pe32_rffe_pclk(bdn, pclk);
-		}
-		else if (tokens[0] == "pe32_rffe_wr") {
-			int bdn = std::stoi(tokens[1]);
-			int port = std::stoi(tokens[2]);
-			int sadd = std::stoi(tokens[3]);
-			int add = std::stoi(tokens[4]);
-			short data = std::stoi(tokens[5]);
-			pe32_rffe_wr(bdn, port, sadd, add, data);
-		}
-		else if (tokens[0] == "pe32_rffe_rd") {
-			int bdn = std::stoi(tokens[1]);
-			int port = std::stoi(tokens[2]);
-			int sadd = std::stoi(tokens[3]);
-			int add = std::stoi(tokens[4]);
-			response = std::to_string(pe32_rffe_rd(bdn, port, sadd, add));
-		}
-		else if (tokens[0] == "pe32_rffe_ewr") {
-			int bdn = std::stoi(tokens[1]);
-			int port = std::stoi(tokens[2]);
-			int sadd = std::stoi(tokens[3]);
-			int add = std::stoi(tokens[4]);
-			short data = std::stoi(tokens[5]);
-			int bcnt = std::stoi(tokens[6]);
-			pe32_rffe_ewr(bdn, port, sadd, add, data, bcnt);
-		}
-		else if (tokens[0] == "pe32_rffe_erd") {
-			int bdn = std::stoi(tokens[1]);
-			int port = std::stoi(tokens[2]);
-			int sadd = std::stoi(tokens[3]);
-			int add = std::stoi(tokens[4]);
-			int bcnt = std::stoi(tokens[5]);
-			response = std::to_string(pe32_rffe_erd(bdn, port, sadd, add, bcnt));
-		}
-		else if (tokens[0] == "pe32_rffe_getword") {
-			int bdn = std::stoi(tokens[1]);
-			int port = std::stoi(tokens[2]);
-			int add = std::stoi(tokens[3]);
-			response = std::to_string(pe32_rffe_getword(bdn, port));
-		}
-		else if (tokens[0] == "pe32_rffe_wr0") {
-			int bdn = std::stoi(tokens[1]);
-			int port = std::stoi(tokens[2]);
-			int sadd = std::stoi(tokens[3]);
-			short data = std::stoi(tokens[4]);
-			pe32_rffe_wr0(bdn, port, sadd, data);
-		}
-		else if (tokens[0] == "pe32_rffe_elwr") {
-			int bdn = std::stoi(tokens[1]);
-			int port = std::stoi(tokens[2]);
-			int sadd = std::stoi(tokens[3]);
-			int add = std::stoi(tokens[4]);
-			int data = std::stoi(tokens[5]);
-			int bcnt = std::stoi(tokens[6]);
-			pe32_rffe_elwr(bdn, port, sadd, add, data, bcnt);
-		}
-		else if (tokens[0] == "pe32_rffe_elrd") {
-			int bdn = std::stoi(tokens[1]);
-			int port = std::stoi(tokens[2]);
-			int sadd = std::stoi(tokens[3]);
-			int add = std::stoi(tokens[4]);
-			int bcnt = std::stoi(tokens[5]);
-			response = std::to_string(pe32_rffe_elrd(bdn, port, sadd, add, bcnt));
-		}
-		else if (tokens[0] == "pe32_rffe_cmdwr") {
-			int bdn = std::stoi(tokens[1]);
-			int port = std::stoi(tokens[2]);
-			int sadd = std::stoi(tokens[3]);
-			int cmd = std::stoi(tokens[4]);
-			int add = std::stoi(tokens[5]);
-			int data = std::stoi(tokens[6]);
-			int bcnt = std::stoi(tokens[7]);
-			pe32_rffe_cmdwr(bdn, port, sadd, cmd, add, data, bcnt);
-		}
-		else if (tokens[0] == "pe32_rffe_cmdrd") {
-			int bdn = std::stoi(tokens[1]);
-			int port = std::stoi(tokens[2]);
-			int sadd = std::stoi(tokens[3]);
-			int cmd = std::stoi(tokens[4]);
-			int add = std::stoi(tokens[5]);
-			int data = std::stoi(tokens[6]);
-			int bcnt = std::stoi(tokens[7]);
-			pe32_rffe_cmdrd(bdn, port, sadd, cmd, add, data, bcnt);
-		}
-	/*	else if (tokens[0] == "pe32_rffe_set_word") {
-			int bdn = std::stoi(tokens[1]);
-			int port = std::stoi(tokens[2]);
-			int data = std::stoi(tokens[3]);
-			int add = std::stoi(tokens[4]);
-			pe32_rffe_set_word(bdn, port, data, add);
-		}
-		else if (tokens[0] == "pe32_rffe_mipi2") {
-			int bdn = std::stoi(tokens[1]);
-			int onoff = std::stoi(tokens[2]);
-			pe32_rffe_mipi2(bdn, onoff);
-		}*/
-		else if (tokens[0] == "pe32_set_qmode") {
-			int bdn = std::stoi(tokens[1]);
-			int onoff = std::stoi(tokens[2]);
-			pe32_set_qmode(bdn, onoff);
-		}
-		else if (tokens[0] == "pe32_check_qfail") {
-			int bdn = std::stoi(tokens[1]);
-			int cno = std::stoi(tokens[2]);
-			response = std::to_string(pe32_check_qfail(bdn, cno));
-		}
-		else if (tokens[0] == "pe32_set_rodvhdvl") {
-			int bdn = std::stoi(tokens[1]);
-			int pno = std::stoi(tokens[2]);
-			int rodvh = std::stoi(tokens[3]);
-			int rodvl = std::stoi(tokens[4]);
-			pe32_set_rodvhdvl(bdn, pno, rodvh, rodvl);
-		}
-		else if (tokens[0] == "pe32_rd_PciRevId") {
-			int bdn = std::stoi(tokens[1]);
-			response = std::to_string(pe32_rd_PciRevId(bdn));
-		}
-		else if (tokens[0] == "pe32_rd_PciDevId") {
-			int bdn = std::stoi(tokens[1]);
-			response = std::to_string(pe32_rd_PciDevId(bdn));
-		}
-		else if (tokens[0] == "pe32_rd_PciSubId") {
-			int bdn = std::stoi(tokens[1]);
-			response = std::to_string(pe32_rd_PciSubId(bdn));
-		}
-		else if (tokens[0] == "pe32_trig_mv") {
-			int bdn = std::stoi(tokens[1]);
-			int pno = std::stoi(tokens[2]);
-			int pxitrg = std::stoi(tokens[3]);
-			pe32_trig_mv(bdn, pno, pxitrg);
-		}
-		else if (tokens[0] == "pe32_trig_mi") {
-			int bdn = std::stoi(tokens[1]);
-			int pno = std::stoi(tokens[2]);
-			int pxitrg = std::stoi(tokens[3]);
-			pe32_trig_mi(bdn, pno, pxitrg);
-		}
-		else if (tokens[0] == "pe32_trig_imeas") {
-			int bdn = std::stoi(tokens[1]);
-			int pno = std::stoi(tokens[2]);
-			response = std::to_string(pe32_trig_imeas(bdn, pno));
-		}
-		else if (tokens[0] == "pe32_trig_vmeas") {
-			int bdn = std::stoi(tokens[1]);
-			int pno = std::stoi(tokens[2]);
-			response = std::to_string(pe32_trig_vmeas(bdn, pno));
-		}
-		else if (tokens[0] == "pe32_user_fram_save") {
-			int bdn = std::stoi(tokens[1]);
-			int ADD = std::stoi(tokens[2]);
-			const char* data = tokens[3].c_str();
-			int size = std::stoi(tokens[4]);
-			pe32_user_fram_save(bdn, ADD, data, size);
-		}
-		else if (tokens[0] == "pe32_user_fram_load") {
-			int bdn = std::stoi(tokens[1]);
-			int ADD = std::stoi(tokens[2]);
-			char* data = new char[tokens[3].size() + 1];
-			int size = std::stoi(tokens[4]);
-			response = std::to_string(pe32_user_fram_load(bdn, ADD, data, size));
-			delete[] data;
+	static void BulkRdLm(int begin, int end, BulkBuffer* lm) {
+		BulkRange<3>(lm, begin, end, [](int bdn, int32_t* values) {
+			values[0] = (int32_t)pe32_rd_lmf(bdn);
+			values[1] = (int32_t)pe32_rd_lmd(bdn);
+			values[2] = (int32_t)pe32_rd_lmm(bdn);
+		});
+	}
+
+	static int PatternStore(int hashlo, int hashhi, int offset, int total, const BulkInput* chunk) {
+		if (offset < 0 || total < 0) {
+			throw std::invalid_argument("pe32_pattern_store offset and total must not be negative");
 		}
-		else {
-			response = "Unknown command :"+ tokens[0];
-			cout << response << endl;
+		return PatternCache::Store(PatternHash(hashlo, hashhi), (uint32_t)offset, (uint32_t)total, chunk->data, chunk->size);
+	}
+
+	// Runs under the global lock of pe32_pattern_lmload, like a plain pe32_lmload
+	static int PatternLmLoad(int begbdno, int boardwidth, long begadd, int hashlo, int hashhi) {
+		uint64_t hash = PatternHash(hashlo, hashhi);
+		std::string path = PatternCache::Find(hash);
+		if (path.empty()) {
+			return PATTERN_NOT_CACHED;
+		}
+		if (PatternCache::IsResident(begbdno, boardwidth, begadd, hash)) {
+			if (threadStats != nullptr) {
+				StatsIncrement(threadStats->shadow_skipped);
+				StatsIncrement(threadStats->commands[(size_t)Opcode::pe32_pattern_lmload].skipped);
+			}
+			return 0;
+		}
+		int result = pe32_lmload(begbdno, boardwidth, begadd, path.data());
+		PatternCache::Loaded(begbdno, boardwidth, begadd, hash, result);
+		return result;
+	}
+
+	static uint64_t PatternHash(int hashlo, int hashhi) {
+		return ((uint64_t)(uint32_t)hashhi << 32) | (uint32_t)hashlo;
+	}
+
+	static void IpcNop(int bdn) {
+	}
+
+	static int IpcEcho(int bdn, int value) {
+		return value;
+	}
+
+	// Payload bytes are their own index so a reader can check them
+	static int IpcEchoBytes(int bdn, int size, OutBytes* data) {
+		if (size < 0 || (uint32_t)size > OutBytes::Capacity) {
+			throw std::length_error("ipc_echo_bytes size exceeds the response buffer");
 		}
+		for (int i = 0; i < size; i++) {
+			data->data[i] = (char)i;
+		}
+		data->size = (uint32_t)size;
+		return size;
+	}
 
+	static void IpcEchoBulk(int bdn, int size, BulkBuffer* data) {
+		if (size < 0 || (uint32_t)size > data->capacity) {
+			throw std::length_error("ipc_echo_bulk size exceeds the bulk region of the slot");
+		}
+		for (int i = 0; i < size; i++) {
+			data->data[i] = (char)i;
+		}
+		data->size = (uint32_t)size;
+	}
+
+	static void BulkSrdGetWord(int bdn, int count, BulkBuffer* words) {
+		int32_t* values = BulkValues(words, count);
+		for (int i = 0; i < count; i++) {
+			values[i] = pe32_srd_getword(bdn);
+		}
 	}
 
 public:
+	// Runs one complete binary request outside any channel, for the telemetry sampler
+	static BinaryStatus DispatchRequest(const char* data, uint32_t size, BinaryWriter& out) {
+		BinaryReader in(data, size);
+		auto header = in.Read<BinaryRequestHeader>();
+		try {
+			return in.Ok() ? DispatchBinary(header, in, out) : BinaryStatus::BadArguments;
+		}
+		catch (...) {
+			return BinaryStatus::Exception;
+		}
+	}
+
 	~UltraFastIPCServer() {
 		isRunning = false;
 
+		// Waits for a running OnParentExited before the events go away
+		if (hParentWait != nullptr) {
+			UnregisterWaitEx(hParentWait, INVALID_HANDLE_VALUE);
+		}
+
+		if (hParent != nullptr) {
+			CloseHandle(hParent);
+		}
+
 		if (pSharedMemory != nullptr) {
 			UnmapViewOfFile(pSharedMemory);
 		}
@@ -1197,12 +861,57 @@ public:
 		if (hMapFile != nullptr) {
 			CloseHandle(hMapFile);
 		}
+
+		if (pStats != nullptr) {
+			UnmapViewOfFile(pStats);
+		}
+
+		if (hStatsFile != nullptr) {
+			CloseHandle(hStatsFile);
+		}
+
+		if (pBulk != nullptr) {
+			UnmapViewOfFile(pBulk);
+		}
+
+		if (hBulkFile != nullptr) {
+			CloseHandle(hBulkFile);
+		}
+
+		if (hRequestEvent != nullptr) {
+			CloseHandle(hRequestEvent);
+		}
+
+		if (hResponseEvent != nullptr) {
+			CloseHandle(hResponseEvent);
+		}
 	}
 };
 
 // Main function for a 32-bit process
 int main(int argc, char* argv[]) {
 
+	// Build step helper: regenerate the C# opcode ids and stubs from PE32Commands.h
+	if (argc >= 2 && std::string(argv[1]) == "--emit-csharp") {
+		if (argc < 3) {
+			EmitCSharpStubs(std::cout);
+			return 0;
+		}
+		std::ofstream file(argv[2], std::ios::binary);
+		EmitCSharpStubs(file);
+		return file ? 0 : 1;
+	}
+
+	// Offline decoder of a --trace file, one line per request
+	if (argc >= 2 && std::string(argv[1]).rfind("--dump-trace=", 0) == 0) {
+		std::ifstream file(std::string(argv[1]).substr(13), std::ios::binary);
+		if (!DumpTrace(file, std::cout)) {
+			std::cerr << "Not a trace file: " << std::string(argv[1]).substr(13) << std::endl;
+			return 1;
+		}
+		return 0;
+	}
+
 	if (argc < 2)
 	{
 		std::cerr << "Please provide at least 2 arguments: process ID and debug mode (0 or 1)" << std::endl;
@@ -1213,6 +922,74 @@ int main(int argc, char* argv[]) {
 	char ch = argv[2][0];
 	bool debugMode = (ch == '1');
 
+	std::error_code tempError;
+	PatternCache::directory = std::filesystem::temp_directory_path(tempError) / "UltraFastIPC" / "Patterns";
+
+	// Optional settings follow the positional arguments as --name=value
+	ServerOptions options;
+	options.debugMode = debugMode;
+	// Values out of range, such as a --cpu an affinity mask cannot hold, stop the bridge
+	try {
+		for (int i = 3; i < argc; i++) {
+			std::string arg = argv[i];
+			if (arg == "--wait=spin") {
+				options.waitMode = WAIT_BUSY_SPIN;
+			}
+			else if (arg == "--wait=hybrid") {
+				options.waitMode = WAIT_HYBRID;
+			}
+			else if (arg.rfind("--spin=", 0) == 0) {
+				options.spinCount = (uint32_t)std::stoul(arg.substr(7));
+			}
+			else if (arg.rfind("--bulk=", 0) == 0) {
+				options.bulkSize = (uint32_t)std::stoul(arg.substr(7));
+			}
+			else if (arg.rfind("--name=", 0) == 0) {
+				options.name = arg.substr(7);
+			}
+			else if (arg == "--dispatch=serial") {
+				DispatchLock::serialized = true;
+			}
+			else if (arg == "--shadow-writes") {
+				ShadowRegisters::enabled = true;
+			}
+			else if (arg == "--reduce-batches") {
+				BatchReducer::enabled = true;
+			}
+			else if (arg.rfind("--pattern-cache=", 0) == 0) {
+				PatternCache::directory = arg.substr(16);
+			}
+			else if (arg.rfind("--trace=", 0) == 0) {
+				options.tracePath = arg.substr(8);
+			}
+			else if (arg.rfind("--trace-size=", 0) == 0) {
+				options.traceSize = std::stoull(arg.substr(13));
+			}
+			else if (arg.rfind("--telemetry=", 0) == 0) {
+				options.telemetry = arg.substr(12);
+			}
+			else if (arg.rfind("--telemetry-period=", 0) == 0) {
+				options.telemetryPeriodMs = std::max<uint32_t>(1, (uint32_t)std::stoul(arg.substr(19)));
+			}
+			else if (arg.rfind("--channels=", 0) == 0) {
+				options.channelCount = std::max<uint32_t>(1, (uint32_t)std::stoul(arg.substr(11)));
+			}
+			else if (ParsePlacementOption(arg, options.placement)) {
+			}
+	#ifdef PE32_MOCK
+			else if (MockPE32::ParseOption(arg)) {
+			}
+	#endif
+			else {
+				std::cerr << "Unknown option ignored: " << arg << std::endl;
+			}
+		}
+	}
+	catch (const std::exception& error) {
+		std::cerr << "Invalid option: " << error.what() << std::endl;
+		return 1;
+	}
+
 	if (debugMode) {
 		std::cout << "Debug mode is ON" << std::endl;
 	}
@@ -1223,17 +1000,94 @@ int main(int argc, char* argv[]) {
 	std::cout << "Parent process ID: " << id << std::endl;
 	std::cout << "Current Process ID: " << GetCurrentProcessId() << std::endl;
 	std::cout << "=== High performance 32-bit IPC server ===" << std::endl;
+#ifdef PE32_MOCK
+	std::cout << "Simulated PE32 backend, " << MockPE32::settings.boardCount << " boards" << std::endl;
+#endif
+
+	if (options.placement.priorityClass != 0 && !SetPriorityClass(GetCurrentProcess(), options.placement.priorityClass)) {
+		std::cerr << "Setting the priority class failed: " << GetLastError() << std::endl;
+	}
+	std::vector<std::pair<int, int>> cpuPairs;
+	if (options.placement.autoCpu) {
+		cpuPairs = CacheSharingPairs();
+		std::cout << cpuPairs.size() << " cache sharing CPU pairs found" << std::endl;
+	}
+
+	// Debug mode used to echo every request to the console, it records a trace instead
+	if (options.debugMode && options.tracePath.empty()) {
+		std::filesystem::path directory = std::filesystem::temp_directory_path(tempError) / "UltraFastIPC";
+		std::filesystem::create_directories(directory, tempError);
+		options.tracePath = directory.string();
+	}
+	std::unique_ptr<TraceFile> trace;
+	if (!options.tracePath.empty()) {
+		// A standby bridge gets a file of its own next to the first one
+		std::filesystem::path tracePath = options.tracePath;
+		if (std::filesystem::is_directory(tracePath, tempError)) {
+			tracePath /= options.name + ".trace";
+		}
+		trace = std::make_unique<TraceFile>();
+		if (!trace->Open(tracePath.string(), options.traceSize, options.channelCount)) {
+			std::cerr << "Create trace file failed: " << GetLastError() << std::endl;
+			return -1;
+		}
+		std::cout << "Tracing to " << tracePath.string() << std::endl;
+	}
 
-	UltraFastIPCServer server("UltraFastIPC_SharedMem", id, debugMode);
+	// Every channel is a whole server of its own, the client routes boards to them
+	std::vector<std::unique_ptr<UltraFastIPCServer>> channels;
+	for (uint32_t k = 0; k < options.channelCount; k++) {
+		ChannelPlacement placement = PlaceChannel(options.placement, k, cpuPairs);
+		if (placement.serverCpu >= 0) {
+			std::cout << "Channel " << k << " on CPU " << placement.serverCpu;
+			if (placement.clientCpu >= 0) {
+				std::cout << ", client suggested CPU " << placement.clientCpu;
+			}
+			std::cout << std::endl;
+		}
+		channels.push_back(std::make_unique<UltraFastIPCServer>(options.name + "_" + std::to_string(k), id, options, placement,
+			trace != nullptr ? trace->Ring(k) : nullptr));
+		if (!channels.back()->Initialize()) {
+			std::cerr << "Server initialization failed on channel " << k << std::endl;
+			return -1;
+		}
+	}
+
+	// Monitors read the page instead of sending requests, see TelemetryPage.h
+	TelemetrySampler telemetry;
+	std::string telemetryError;
+	if (!telemetry.Configure(options.telemetry, telemetryError)) {
+		std::cerr << "Telemetry ignored, " << telemetryError << std::endl;
+	}
+	else if (!telemetry.Empty()) {
+		if (!telemetry.Start(options.name, options.telemetryPeriodMs, UltraFastIPCServer::DispatchRequest)) {
+			std::cerr << "Create telemetry page failed: " << GetLastError() << std::endl;
+			return -1;
+		}
+		std::cout << "Sampling telemetry every " << options.telemetryPeriodMs << " ms" << std::endl;
+	}
 
-	if (!server.Initialize()) {
-		std::cerr << "Server initialization failed" << std::endl;
-		return -1;
+	// The client waits on <name>_Ready instead of sleeping for a fixed time.
+	// It usually created the event already, CreateEventA then opens it.
+	HANDLE hReady = CreateEventA(NULL, TRUE, FALSE, (options.name + "_Ready").c_str());
+	if (hReady != NULL) {
+		SetEvent(hReady);
 	}
 
-	// Start processing (this will block the main thread)
-	server.StartProcessing();
+	std::vector<std::thread> workers;
+	for (uint32_t k = 1; k < options.channelCount; k++) {
+		workers.emplace_back([&channels, k] { channels[k]->StartProcessing(); });
+	}
 
+	// Channel 0 runs on the main thread, all of them stop when the parent exits
+	channels[0]->StartProcessing();
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+
+	if (hReady != NULL) {
+		CloseHandle(hReady);
+	}
 	return 0;
 }
 